@@ -0,0 +1,144 @@
+/**
+ * @file bench_approx.cpp
+ * @brief Benchmarks for approximate search vs exact search of every variant
+ */
+
+#include <benchmark/benchmark.h>
+#include <kmp/kmp.hpp>
+#include <string>
+#include <string_view>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::string generate_text(size_t length, std::string_view alphabet, unsigned seed = 42) {
+    std::mt19937 gen(seed);
+    std::string result(length, ' ');
+    for (auto& c : result) {
+        c = alphabet[gen() % alphabet.size()];
+    }
+    return result;
+}
+
+// The pattern plus every one-substitution variant over the alphabet
+std::vector<std::string> substitution_variants(const std::string& pattern, std::string_view alphabet) {
+    std::vector<std::string> variants = {pattern};
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        for (char c : alphabet) {
+            if (c != pattern[i]) {
+                variants.push_back(pattern);
+                variants.back()[i] = c;
+            }
+        }
+    }
+    return variants;
+}
+
+} // namespace
+
+// =============================================================================
+// Hamming Distance Benchmarks
+// =============================================================================
+
+static void BM_Approx_Hamming_DNA(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len, "ACGT");
+    const std::string pattern = "ACGTTGCAACGTAGCT";
+
+    for (auto _ : state) {
+        auto matches = kmp::approx_search(text, pattern, 1, kmp::distance_metric::hamming);
+        benchmark::DoNotOptimize(matches);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_Approx_Hamming_DNA)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_KMP_Variants_Hamming_DNA(benchmark::State& state) {
+    // Baseline: exact count() of the pattern and its 48 substitutions
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len, "ACGT");
+    const auto variants = substitution_variants("ACGTTGCAACGTAGCT", "ACGT");
+
+    for (auto _ : state) {
+        size_t total = 0;
+        for (const auto& variant : variants) {
+            total += kmp::count(text, variant);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_KMP_Variants_Hamming_DNA)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Approx_Hamming_Text(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len, "abcdefghijklmnopqrstuvwxyz");
+
+    for (auto _ : state) {
+        auto matches = kmp::approx_search(text, "necessary", 2, kmp::distance_metric::hamming);
+        benchmark::DoNotOptimize(matches);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_Approx_Hamming_Text)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Edit Distance Benchmarks
+// =============================================================================
+
+static void BM_Approx_Edit_Text(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len, "abcdefghijklmnopqrstuvwxyz");
+
+    for (auto _ : state) {
+        auto matches = kmp::approx_search(text, "necessary", 2);
+        benchmark::DoNotOptimize(matches);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_Approx_Edit_Text)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Approx_Edit_LongPattern(benchmark::State& state) {
+    // 200-byte pattern: four 64-bit blocks per text byte
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len, "ACGT");
+    const std::string pattern = generate_text(200, "ACGT", 7);
+
+    for (auto _ : state) {
+        auto matches = kmp::approx_search(text, pattern, 10);
+        benchmark::DoNotOptimize(matches);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_Approx_Edit_LongPattern)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
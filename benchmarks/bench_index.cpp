@@ -0,0 +1,298 @@
+/**
+ * @file bench_index.cpp
+ * @brief Benchmarks for indexed queries vs scanning the text
+ */
+
+#include <benchmark/benchmark.h>
+#include <kmp/kmp.hpp>
+#include <string>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::string generate_text(size_t length, unsigned seed = 42) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dis('a', 'z');
+
+    std::string result(length, ' ');
+    for (auto& c : result) {
+        c = static_cast<char>(dis(gen));
+    }
+    return result;
+}
+
+} // namespace
+
+// =============================================================================
+// Suffix Array Index Benchmarks
+// =============================================================================
+
+static void BM_Index_Build(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len);
+
+    for (auto _ : state) {
+        kmp::text_index index(text);
+        benchmark::DoNotOptimize(index);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_Index_Build)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_Index_Count(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len);
+    const kmp::text_index index(text);
+    const std::string pattern = text.substr(text_len / 2, 5);
+
+    for (auto _ : state) {
+        auto n = index.count(pattern);
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+BENCHMARK(BM_Index_Count)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_KMP_Count_Scan(benchmark::State& state) {
+    // Baseline: the same query answered by scanning the text
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len);
+    const std::string pattern = text.substr(text_len / 2, 5);
+
+    for (auto _ : state) {
+        auto n = kmp::count(text, pattern);
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+BENCHMARK(BM_KMP_Count_Scan)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// FM-Index Benchmarks
+// =============================================================================
+
+namespace {
+
+std::string generate_dna(size_t length, unsigned seed = 42) {
+    std::mt19937 gen(seed);
+    std::string result(length, ' ');
+    for (auto& c : result) {
+        c = "ACGT"[gen() % 4];
+    }
+    return result;
+}
+
+} // namespace
+
+static void BM_FM_Build_DNA(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_dna(text_len);
+
+    for (auto _ : state) {
+        kmp::fm_index index(text);
+        benchmark::DoNotOptimize(index);
+        state.counters["bytes_per_base"] =
+            static_cast<double>(index.memory_bytes()) / static_cast<double>(text_len);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_FM_Build_DNA)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_FM_Count_DNA(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_dna(text_len);
+    const kmp::fm_index index(text);
+    const std::string pattern = text.substr(text_len / 2, 12);
+
+    for (auto _ : state) {
+        auto n = index.count(pattern);
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+BENCHMARK(BM_FM_Count_DNA)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_FM_Locate_DNA(benchmark::State& state) {
+    // 8-mers: about 256 occurrences per MiB to locate
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_dna(text_len);
+    const kmp::fm_index index(text);
+    const std::string pattern = text.substr(text_len / 2, 8);
+
+    for (auto _ : state) {
+        auto positions = index.search_all_vec(pattern);
+        benchmark::DoNotOptimize(positions);
+    }
+}
+
+BENCHMARK(BM_FM_Locate_DNA)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Trigram Index Benchmarks
+// =============================================================================
+
+namespace {
+
+std::vector<std::string> generate_documents(size_t count, unsigned seed = 42) {
+    // Short log-like lines; "needle" is planted in about 1 in 10,000
+    static constexpr const char* words[] = {
+        "request", "served", "in", "ms", "user", "login", "cache", "miss", "hit",
+        "disk", "usage", "ok", "retry", "timeout", "upstream", "status", "200", "404",
+    };
+    std::mt19937 gen(seed);
+    std::vector<std::string> documents(count);
+    for (auto& doc : documents) {
+        const size_t n = 4 + gen() % 12;
+        for (size_t i = 0; i < n; ++i) {
+            doc += words[gen() % std::size(words)];
+            doc += ' ';
+        }
+        if (gen() % 10000 == 0) {
+            doc += "needle";
+        }
+    }
+    return documents;
+}
+
+} // namespace
+
+static void BM_Trigram_Search_Literal(benchmark::State& state) {
+    const auto documents = generate_documents(static_cast<size_t>(state.range(0)));
+    const kmp::trigram_index index(documents);
+    const kmp::literal_pattern pattern("needle");
+
+    for (auto _ : state) {
+        auto ids = index.search(pattern);
+        benchmark::DoNotOptimize(ids);
+    }
+}
+
+BENCHMARK(BM_Trigram_Search_Literal)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Trigram_Search_Regex(benchmark::State& state) {
+    const auto documents = generate_documents(static_cast<size_t>(state.range(0)));
+    const kmp::trigram_index index(documents);
+    const kmp::regex_pattern pattern("(cache|disk) miss timeout");
+
+    for (auto _ : state) {
+        auto ids = index.search(pattern);
+        benchmark::DoNotOptimize(ids);
+    }
+}
+
+BENCHMARK(BM_Trigram_Search_Regex)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Contains_Scan_Documents(benchmark::State& state) {
+    // Baseline: kmp::contains over every document
+    const auto documents = generate_documents(static_cast<size_t>(state.range(0)));
+    const std::string_view pattern = "needle";
+
+    for (auto _ : state) {
+        std::vector<size_t> ids;
+        for (size_t id = 0; id < documents.size(); ++id) {
+            if (kmp::contains(documents[id], pattern)) {
+                ids.push_back(id);
+            }
+        }
+        benchmark::DoNotOptimize(ids);
+    }
+}
+
+BENCHMARK(BM_Contains_Scan_Documents)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Suffix Automaton Benchmarks
+// =============================================================================
+
+static void BM_Automaton_Append(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len);
+
+    for (auto _ : state) {
+        kmp::suffix_automaton automaton(text);
+        benchmark::DoNotOptimize(automaton);
+        state.counters["bytes_per_byte"] =
+            static_cast<double>(automaton.memory_bytes()) / static_cast<double>(text_len);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_Automaton_Append)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 20)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_Automaton_AppendThenCount(benchmark::State& state) {
+    // Interactive use: grow by a 4 KiB chunk, then query; the count pass
+    // after each append dominates
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len);
+    const std::string chunk = generate_text(4096, 7);
+    kmp::suffix_automaton automaton(text);
+    const std::string pattern = text.substr(text_len / 2, 5);
+
+    for (auto _ : state) {
+        automaton.append(chunk);
+        auto n = automaton.count(pattern);
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+BENCHMARK(BM_Automaton_AppendThenCount)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 20)
+    ->Iterations(64)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Automaton_Contains(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_text(text_len);
+    const kmp::suffix_automaton automaton(text);
+    const std::string pattern = text.substr(text_len / 2, 12);
+
+    for (auto _ : state) {
+        auto found = automaton.contains(pattern);
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+BENCHMARK(BM_Automaton_Contains)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 20)
+    ->Unit(benchmark::kNanosecond);
@@ -6,6 +6,7 @@
 #include <benchmark/benchmark.h>
 #include <kmp/kmp.hpp>
 #include <string>
+#include <string_view>
 #include <random>
 #include <regex>
 
@@ -93,6 +94,18 @@ static void BM_Regex_Compile_Alternation(benchmark::State& state) {
 
 BENCHMARK(BM_Regex_Compile_Alternation);
 
+static void BM_Regex_Load_Serialized(benchmark::State& state) {
+    // Zero-copy load of a precompiled DFA (cf. BM_Regex_Compile_Complex)
+    auto blob = kmp::compile_regex("[a-z]+@[a-z]+\\.[a-z]+").serialize();
+
+    for (auto _ : state) {
+        auto regex = kmp::regex_pattern::load(blob);
+        benchmark::DoNotOptimize(regex);
+    }
+}
+
+BENCHMARK(BM_Regex_Load_Serialized);
+
 // =============================================================================
 // DFA Matching Benchmarks
 // =============================================================================
@@ -138,6 +151,41 @@ static void BM_Regex_Match_Email(benchmark::State& state) {
 
 BENCHMARK(BM_Regex_Match_Email)->Unit(benchmark::kMicrosecond);
 
+// =============================================================================
+// Self-Loop Acceleration Benchmarks
+// =============================================================================
+
+static void BM_Regex_Match_QuotedString(benchmark::State& state) {
+    auto regex = kmp::compile_regex("\"[^\"]*\"");
+    std::string text = "value = \"" + generate_text(100000) + "\";";
+    std::string_view quoted = std::string_view(text).substr(8, text.size() - 9);
+
+    for (auto _ : state) {
+        auto result = regex.matches(quoted);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text.size()));
+}
+
+BENCHMARK(BM_Regex_Match_QuotedString)->Unit(benchmark::kMicrosecond);
+
+static void BM_Regex_Match_WildcardPrefix(benchmark::State& state) {
+    auto regex = kmp::compile_regex(".*ERROR");
+    std::string text = generate_text(100000) + "ERROR";
+
+    for (auto _ : state) {
+        auto result = regex.search(text);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text.size()));
+}
+
+BENCHMARK(BM_Regex_Match_WildcardPrefix)->Unit(benchmark::kMicrosecond);
+
 // =============================================================================
 // Scaling Benchmarks
 // =============================================================================
@@ -164,6 +212,65 @@ BENCHMARK(BM_Regex_Scaling)
     ->Range(256, 1 << 20)
     ->Unit(benchmark::kMicrosecond);
 
+// =============================================================================
+// Replacement Benchmarks
+// =============================================================================
+
+static void BM_Regex_Replace_Redact(benchmark::State& state) {
+    auto regex = kmp::compile_regex("([a-z]+)@([a-z]+)\\.com");
+    std::string text = generate_email_like_text(100);
+    kmp::regex_scratch scratch;
+    std::string out;
+
+    for (auto _ : state) {
+        out.clear();
+        regex.replace_all(text, "$1@<redacted>", out, scratch);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text.size()));
+}
+
+BENCHMARK(BM_Regex_Replace_Redact)->Unit(benchmark::kMicrosecond);
+
+static void BM_STD_Regex_Replace_Redact(benchmark::State& state) {
+    std::regex regex("([a-z]+)@([a-z]+)\\.com");
+    std::string text = generate_email_like_text(100);
+
+    for (auto _ : state) {
+        auto out = std::regex_replace(text, regex, "$1@<redacted>");
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text.size()));
+}
+
+BENCHMARK(BM_STD_Regex_Replace_Redact)->Unit(benchmark::kMicrosecond);
+
+static void BM_Regex_Replace_NoMatch(benchmark::State& state) {
+    // Spans without a match cost only the DFA scan
+    auto regex = kmp::compile_regex("[0-9]+");
+    std::string text = generate_text(static_cast<size_t>(state.range(0)));
+    kmp::regex_scratch scratch;
+    std::string out;
+
+    for (auto _ : state) {
+        out.clear();
+        regex.replace_all(text, "<n>", out, scratch);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text.size()));
+}
+
+BENCHMARK(BM_Regex_Replace_NoMatch)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
 // =============================================================================
 // Comparison with std::regex (for reference)
 // =============================================================================
@@ -244,6 +351,21 @@ static void BM_Regex_Full_Match(benchmark::State& state) {
 
 BENCHMARK(BM_Regex_Full_Match);
 
+static void BM_Regex_Validate_Identifier(benchmark::State& state) {
+    // Small DFA: served by the two-byte stride table
+    auto regex = kmp::compile_regex("[A-Za-z_][A-Za-z0-9_]*");
+    std::string text = "id_" + generate_text(997);
+
+    for (auto _ : state) {
+        bool result = regex.matches(text);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * 1000);
+}
+
+BENCHMARK(BM_Regex_Validate_Identifier);
+
 static void BM_Regex_Partial_Search(benchmark::State& state) {
     auto regex = kmp::compile_regex("[0-9]+");
     std::string text = generate_text(1000);
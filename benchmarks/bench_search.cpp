@@ -7,7 +7,9 @@
 #include <kmp/kmp.hpp>
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <random>
+#include <vector>
 
 namespace {
 
@@ -120,6 +122,206 @@ BENCHMARK(BM_STD_Search_Long_Pattern)
     ->Range(1024, 1 << 20)
     ->Unit(benchmark::kMicrosecond);
 
+// =============================================================================
+// Small Alphabet Benchmarks
+// =============================================================================
+
+namespace {
+
+std::string generate_dna(size_t length) {
+    std::mt19937 gen(42);
+    std::string result(length, ' ');
+    for (auto& c : result) {
+        c = "ACGT"[gen() % 4];
+    }
+    return result;
+}
+
+} // namespace
+
+static void BM_KMP_Search_DNA(benchmark::State& state) {
+    // 24-mer planted at the end; every fourth byte is a first-byte candidate
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_dna(text_len);
+    const std::string pattern = "ACGTTGCAACGTAGCTAGCATTTT";
+    text.replace(text_len - 100, pattern.size(), pattern);
+
+    for (auto _ : state) {
+        auto pos = kmp::search_pos(text, pattern);
+        benchmark::DoNotOptimize(pos);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_KMP_Search_DNA)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_KMP_Count_DNA(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    const std::string text = generate_dna(text_len);
+
+    for (auto _ : state) {
+        auto n = kmp::count(text, "ACGTACGT");
+        benchmark::DoNotOptimize(n);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_KMP_Count_DNA)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_STD_Search_DNA(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_dna(text_len);
+    const std::string pattern = "ACGTTGCAACGTAGCTAGCATTTT";
+    text.replace(text_len - 100, pattern.size(), pattern);
+
+    for (auto _ : state) {
+        auto result = std::search(text.begin(), text.end(),
+                                  pattern.begin(), pattern.end());
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_STD_Search_DNA)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Element Sequence Benchmarks
+// =============================================================================
+
+static void BM_KMP_Search_U32(benchmark::State& state) {
+    // Event-ID stream; pattern inserted at the end
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::mt19937 gen(42);
+    std::vector<uint32_t> text(text_len);
+    for (auto& id : text) id = gen() % 1000;
+    const std::vector<uint32_t> pattern = {4242, 4243, 4244, 4245};
+    std::copy(pattern.begin(), pattern.end(), text.end() - 4);
+
+    for (auto _ : state) {
+        auto pos = kmp::search_pos(text, pattern);
+        benchmark::DoNotOptimize(pos);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len * sizeof(uint32_t)));
+}
+
+BENCHMARK(BM_KMP_Search_U32)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_STD_Search_U32(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::mt19937 gen(42);
+    std::vector<uint32_t> text(text_len);
+    for (auto& id : text) id = gen() % 1000;
+    const std::vector<uint32_t> pattern = {4242, 4243, 4244, 4245};
+    std::copy(pattern.begin(), pattern.end(), text.end() - 4);
+
+    for (auto _ : state) {
+        auto result = std::search(text.begin(), text.end(),
+                                  pattern.begin(), pattern.end());
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len * sizeof(uint32_t)));
+}
+
+BENCHMARK(BM_STD_Search_U32)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Masked Signature Benchmarks
+// =============================================================================
+
+namespace {
+
+std::string generate_image(size_t length) {
+    // Random bytes with runs of zero padding, roughly like an executable
+    std::mt19937 gen(7);
+    std::string image(length, '\0');
+    for (size_t i = 0; i < length; ++i) {
+        if (i % 4096 >= 3072) continue;
+        image[i] = static_cast<char>(gen());
+    }
+    return image;
+}
+
+} // namespace
+
+static void BM_KMP_Masked_Signature(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string image = generate_image(text_len);
+    image.replace(text_len - 16, 6, "\x48\x8B\x01\x02\x89\x45");
+    const auto pattern = kmp::compile_masked("48 8B ?? ?? 89 45");
+
+    for (auto _ : state) {
+        auto pos = kmp::search_pos(image, pattern);
+        benchmark::DoNotOptimize(pos);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_KMP_Masked_Signature)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Naive_Masked_Signature(benchmark::State& state) {
+    // Baseline: test every offset with a masked byte loop
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string image = generate_image(text_len);
+    image.replace(text_len - 16, 6, "\x48\x8B\x01\x02\x89\x45");
+    const std::string bytes("\x48\x8B\x00\x00\x89\x45", 6);
+    const std::string mask("\xFF\xFF\x00\x00\xFF\xFF", 6);
+
+    auto matches_at = [&](size_t p) {
+        for (size_t j = 0; j < bytes.size(); ++j) {
+            if ((image[p + j] & mask[j]) != bytes[j]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    for (auto _ : state) {
+        size_t pos = 0;
+        while (pos + bytes.size() <= image.size() && !matches_at(pos)) {
+            ++pos;
+        }
+        benchmark::DoNotOptimize(pos);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_Naive_Masked_Signature)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
 // =============================================================================
 // Search All Benchmarks
 // =============================================================================
@@ -143,6 +345,237 @@ BENCHMARK(BM_KMP_Search_All)
     ->Range(1024, 1 << 20)
     ->Unit(benchmark::kMicrosecond);
 
+// =============================================================================
+// Reverse Search Benchmarks
+// =============================================================================
+
+static void BM_KMP_Rfind(benchmark::State& state) {
+    // Most recent marker near the end of a log, as when tailing files
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    text.replace(text_len / 4, 13, "SESSION START");
+    text.replace(text_len - text_len / 8, 13, "SESSION START");
+
+    for (auto _ : state) {
+        auto pos = kmp::rfind(text, "SESSION START");
+        benchmark::DoNotOptimize(pos);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_KMP_Rfind)
+    ->RangeMultiplier(4)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_STD_Rfind(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    text.replace(text_len / 4, 13, "SESSION START");
+    text.replace(text_len - text_len / 8, 13, "SESSION START");
+
+    for (auto _ : state) {
+        auto pos = std::string_view(text).rfind("SESSION START");
+        benchmark::DoNotOptimize(pos);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_STD_Rfind)
+    ->RangeMultiplier(4)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Bounded Search Benchmarks
+// =============================================================================
+
+static void BM_KMP_Search_N_First10(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    for (size_t i = 0; i + 64 <= text_len; i += 64) {
+        text.replace(i, 6, "needle");
+    }
+
+    for (auto _ : state) {
+        auto hits = kmp::search_n(text, "needle", 10);
+        benchmark::DoNotOptimize(hits.data());
+    }
+}
+
+BENCHMARK(BM_KMP_Search_N_First10)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_KMP_Search_All_Then_Truncate(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    for (size_t i = 0; i + 64 <= text_len; i += 64) {
+        text.replace(i, 6, "needle");
+    }
+
+    for (auto _ : state) {
+        auto hits = kmp::search_all_vec(text, "needle");
+        hits.resize(std::min<size_t>(hits.size(), 10));
+        benchmark::DoNotOptimize(hits.data());
+    }
+}
+
+BENCHMARK(BM_KMP_Search_All_Then_Truncate)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_KMP_Search_All_Into(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    for (size_t i = 0; i + 64 <= text_len; i += 64) {
+        text.replace(i, 6, "needle");
+    }
+    std::vector<size_t> buffer(256);
+
+    for (auto _ : state) {
+        size_t from = 0;
+        size_t total = 0;
+        for (;;) {
+            auto result = kmp::search_all_into(text, "needle", buffer, from);
+            total += result.written;
+            if (result.written < buffer.size()) break;
+            from = result.resume;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_KMP_Search_All_Into)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Segmented Search Benchmarks
+// =============================================================================
+
+static void BM_KMP_Search_Segmented(benchmark::State& state) {
+    // 1 MiB of text in segments of range(0) bytes
+    const size_t text_len = 1 << 20;
+    const size_t segment_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    text.replace(text_len - 100, 6, "needle");
+
+    std::vector<std::string_view> segments;
+    for (size_t pos = 0; pos < text_len; pos += segment_len) {
+        segments.push_back(std::string_view(text).substr(pos, segment_len));
+    }
+
+    for (auto _ : state) {
+        auto pos = kmp::search_segmented(segments, "needle");
+        benchmark::DoNotOptimize(pos);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_KMP_Search_Segmented)
+    ->RangeMultiplier(8)
+    ->Range(512, 64 << 10)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_KMP_Search_Coalesced(benchmark::State& state) {
+    // Baseline: copy the segments into one buffer, then search
+    const size_t text_len = 1 << 20;
+    const size_t segment_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    text.replace(text_len - 100, 6, "needle");
+
+    std::vector<std::string_view> segments;
+    for (size_t pos = 0; pos < text_len; pos += segment_len) {
+        segments.push_back(std::string_view(text).substr(pos, segment_len));
+    }
+
+    std::string joined;
+    for (auto _ : state) {
+        joined.clear();
+        for (auto segment : segments) {
+            joined.append(segment);
+        }
+        auto pos = kmp::search_pos(joined, "needle");
+        benchmark::DoNotOptimize(pos);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_KMP_Search_Coalesced)
+    ->RangeMultiplier(8)
+    ->Range(512, 64 << 10)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Replace Benchmarks
+// =============================================================================
+
+static void BM_KMP_Replace_All(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    for (size_t i = 0; i + 64 <= text_len; i += 64) {
+        text.replace(i, 6, "needle");
+    }
+
+    for (auto _ : state) {
+        auto result = kmp::replace_all(text, "needle", "thread");
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_KMP_Replace_All)
+    ->RangeMultiplier(4)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_STD_Replace_All(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    for (size_t i = 0; i + 64 <= text_len; i += 64) {
+        text.replace(i, 6, "needle");
+    }
+
+    for (auto _ : state) {
+        std::string result;
+        std::string_view view = text;
+        size_t start = 0;
+        for (auto pos = view.find("needle"); pos != std::string_view::npos;
+             pos = view.find("needle", start)) {
+            result.append(view, start, pos - start);
+            result += "thread";
+            start = pos + 6;
+        }
+        result.append(view, start);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(text_len));
+}
+
+BENCHMARK(BM_STD_Replace_All)
+    ->RangeMultiplier(4)
+    ->Range(1024, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
 // =============================================================================
 // Pre-compiled Pattern Benchmarks
 // =============================================================================
@@ -168,6 +601,86 @@ BENCHMARK(BM_KMP_Precompiled_Pattern)
     ->Range(1024, 1 << 20)
     ->Unit(benchmark::kMicrosecond);
 
+static void BM_KMP_Literal_Pattern_Build(benchmark::State& state) {
+    // Dictionary-sized batches of short keywords (stored inline, no allocation)
+    std::vector<std::string> words;
+    for (int i = 0; i < 1000; ++i) {
+        words.push_back("keyword_" + std::to_string(i));
+    }
+
+    for (auto _ : state) {
+        std::vector<kmp::literal_pattern> patterns;
+        patterns.reserve(words.size());
+        for (const auto& w : words) {
+            patterns.emplace_back(w);
+        }
+        benchmark::DoNotOptimize(patterns.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(words.size()));
+}
+
+BENCHMARK(BM_KMP_Literal_Pattern_Build)
+    ->Unit(benchmark::kMicrosecond);
+
+// 1M keywords of 6-20 bytes, shared by the bulk compilation benchmarks
+static const std::vector<std::string>& keyword_list() {
+    static const std::vector<std::string> words = [] {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> len(6, 20);
+        std::uniform_int_distribution<int> ch('a', 'z');
+        std::vector<std::string> result(1'000'000);
+        for (auto& w : result) {
+            w.resize(static_cast<size_t>(len(rng)));
+            for (auto& c : w) {
+                c = static_cast<char>(ch(rng));
+            }
+        }
+        return result;
+    }();
+    return words;
+}
+
+static void BM_KMP_Compute_Failure_1M(benchmark::State& state) {
+    // Baseline: one failure vector per keyword, serially
+    const auto& words = keyword_list();
+
+    for (auto _ : state) {
+        std::vector<std::vector<kmp::size_type>> tables;
+        tables.reserve(words.size());
+        for (const auto& w : words) {
+            tables.push_back(kmp::detail::compute_failure(w.begin(), w.end()));
+        }
+        benchmark::DoNotOptimize(tables.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(words.size()));
+}
+
+BENCHMARK(BM_KMP_Compute_Failure_1M)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_KMP_Compile_Literals_1M(benchmark::State& state) {
+    // Arg: worker threads (0 = hardware concurrency)
+    const auto& words = keyword_list();
+    std::vector<std::string_view> views(words.begin(), words.end());
+
+    for (auto _ : state) {
+        auto set = kmp::compile_literals(views, static_cast<unsigned>(state.range(0)));
+        benchmark::DoNotOptimize(set.arena().data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(words.size()));
+}
+
+BENCHMARK(BM_KMP_Compile_Literals_1M)
+    ->Arg(1)
+    ->Arg(0)
+    ->Unit(benchmark::kMillisecond);
+
 // =============================================================================
 // Worst Case Benchmarks
 // =============================================================================
@@ -215,3 +728,61 @@ BENCHMARK(BM_STD_Worst_Case)
     ->RangeMultiplier(4)
     ->Range(1024, 1 << 18)
     ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Match Tracker Benchmarks
+// =============================================================================
+
+static void BM_Tracker_Keystroke_Literal(benchmark::State& state) {
+    // Type a byte and delete it again in the middle of the document
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    kmp::match_tracker tracker(generate_text(text_len), kmp::literal_pattern("needle"));
+    const size_t cursor = text_len / 2;
+
+    for (auto _ : state) {
+        tracker.apply_edit(cursor, 0, "n");
+        tracker.apply_edit(cursor, 1, "");
+    }
+    benchmark::DoNotOptimize(tracker.match_count());
+}
+
+BENCHMARK(BM_Tracker_Keystroke_Literal)
+    ->RangeMultiplier(8)
+    ->Range(1 << 20, 1 << 26)
+    ->Unit(benchmark::kNanosecond);
+
+static void BM_Tracker_Keystroke_Regex(benchmark::State& state) {
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    kmp::match_tracker tracker(generate_text(text_len), kmp::regex_pattern("err(or|no)s?"));
+    const size_t cursor = text_len / 2;
+
+    for (auto _ : state) {
+        tracker.apply_edit(cursor, 0, "e");
+        tracker.apply_edit(cursor, 1, "");
+    }
+    benchmark::DoNotOptimize(tracker.match_count());
+}
+
+BENCHMARK(BM_Tracker_Keystroke_Regex)
+    ->RangeMultiplier(8)
+    ->Range(1 << 20, 1 << 26)
+    ->Unit(benchmark::kNanosecond);
+
+static void BM_Rescan_Keystroke_Literal(benchmark::State& state) {
+    // Baseline: edit a std::string and search the whole document again
+    const size_t text_len = static_cast<size_t>(state.range(0));
+    std::string text = generate_text(text_len);
+    const size_t cursor = text_len / 2;
+
+    for (auto _ : state) {
+        text.insert(cursor, 1, 'n');
+        auto positions = kmp::search_all_vec(text, "needle");
+        benchmark::DoNotOptimize(positions);
+        text.erase(cursor, 1);
+    }
+}
+
+BENCHMARK(BM_Rescan_Keystroke_Literal)
+    ->RangeMultiplier(8)
+    ->Range(1 << 20, 1 << 26)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,94 @@
+#pragma once
+
+/**
+ * @file approx.hpp
+ * @brief Approximate (typo-tolerant) literal search
+ *
+ * Finds substrings within k mismatches (Hamming distance) or k edits
+ * (Levenshtein distance) of a pattern in a single pass, instead of an
+ * exact search for every variant of the pattern.
+ *
+ * Usage:
+ *   auto typos = kmp::approx_search(text, "necessary", 2);
+ *   auto snps  = kmp::approx_search(genome, "ACGTTGCA", 1,
+ *                                   kmp::distance_metric::hamming);
+ */
+
+#include "config.hpp"
+#include "search.hpp"
+#include "detail/approx.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace kmp {
+
+// =============================================================================
+// Approximate Search
+// =============================================================================
+
+/**
+ * @brief Distance used by approx_search()
+ *
+ * hamming counts substituted bytes between equal-length strings; edit
+ * also counts inserted and deleted bytes.
+ */
+enum class distance_metric {
+    hamming,
+    edit,
+};
+
+/**
+ * @brief One result of approx_search()
+ */
+struct approx_match {
+    size_type position = 0;  // start of the matched substring
+    size_type length = 0;    // pattern.size() for hamming
+    size_type distance = 0;  // mismatches or edits, at most k
+
+    friend bool operator==(const approx_match&, const approx_match&) = default;
+};
+
+/**
+ * @brief Find substrings within distance k of pattern
+ *
+ * hamming reports every alignment with at most k mismatches, overlapping
+ * ones included, in order of position.
+ *
+ * edit reports one match per run of adjacent end positions within k
+ * edits (a near-match of "hello" also ends one byte early and one byte
+ * late): the end with the smallest distance, and the shortest substring
+ * ending there with that distance. k should be below pattern.size(),
+ * since otherwise the empty string matches everywhere.
+ *
+ * An empty pattern has no matches.
+ */
+[[nodiscard]] inline std::vector<approx_match> approx_search(
+    std::string_view text,
+    std::string_view pattern,
+    size_type k,
+    distance_metric metric = distance_metric::edit
+) {
+    std::vector<approx_match> result;
+    if (pattern.empty()) {
+        return result;
+    }
+
+    if (metric == distance_metric::hamming) {
+        const size_type m = pattern.size();
+        detail::hamming_find_all(text, pattern, k,
+            detail::callback_output_iterator([&](size_type pos) {
+                result.push_back({pos, m,
+                    detail::hamming_distance(text.data() + pos, pattern.data(), m)});
+            }));
+        return result;
+    }
+
+    detail::myers_find_all(text, pattern, k,
+        [&](size_type pos, size_type length, size_type distance) {
+            result.push_back({pos, length, distance});
+        });
+    return result;
+}
+
+} // namespace kmp
@@ -98,6 +98,53 @@ inline constexpr std::size_t max_dfa_states = 10000;
 // ASCII charset size
 inline constexpr std::size_t ascii_size = 128;
 
+// Memory budget for the DFA's two-byte (2-stride) transition table
+inline constexpr std::size_t max_stride_table_bytes = 256 * 1024;
+
+// Visited-set budget (NFA states x match length bits) of the capture
+// backtracker; longer matches use the Pike VM
+inline constexpr std::size_t max_backtrack_bits = 256 * 1024;
+
+// Default memory budget of regex_cache (compiled tables plus keys)
+inline constexpr std::size_t regex_cache_bytes = 16 * 1024 * 1024;
+
+// Minimum patterns per worker thread in compile_literals()
+inline constexpr std::size_t parallel_compile_grain = 16 * 1024;
+
+// Minimum text bytes per worker thread when building a text_index
+inline constexpr std::size_t parallel_index_grain = 1024 * 1024;
+
+// Shift-Or (patterns up to 64 bytes) replaces the SIMD prefilter when more
+// than 1 in shift_or_density of the first shift_or_sample text bytes is a
+// candidate; only for texts of at least shift_or_min_text bytes
+inline constexpr std::size_t shift_or_min_text = 4096;
+inline constexpr std::size_t shift_or_sample = 256;
+inline constexpr std::size_t shift_or_density = 32;
+
+// Bytes per lane of the interleaved Myers scan in approx_search(); each
+// lane re-reads m + k bytes of warm-up
+inline constexpr std::size_t approx_lane_bytes = 16 * 1024;
+
+// Default fm_index suffix-array sampling: one position kept per this many
+// text bytes; locating an occurrence walks at most this many LF steps
+inline constexpr std::size_t fm_sample_rate = 32;
+
+// trigram_index: intersect by galloping when one posting list is this many
+// times longer than the other
+inline constexpr std::size_t trigram_gallop_ratio = 32;
+
+// trigram_index: a clause whose postings outnumber the candidates left by
+// this factor is skipped; verifying the candidates is cheaper than decoding
+inline constexpr std::size_t trigram_verify_cost = 64;
+
+// suffix_automaton: a state with more transitions than this switches from a
+// scanned (byte, target) list to a 256-entry table (power of two, <= 128)
+inline constexpr std::size_t automaton_dense_edges = 16;
+
+// match_tracker: minimum free space kept in the text buffer's gap, so a run
+// of keystrokes does not reallocate
+inline constexpr std::size_t tracker_gap_bytes = 4096;
+
 } // namespace config
 
 // =============================================================================
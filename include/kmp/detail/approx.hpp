@@ -0,0 +1,424 @@
+#pragma once
+
+/**
+ * @file approx.hpp
+ * @brief Bit-parallel approximate matching (Hamming and edit distance)
+ *
+ * Hamming distance uses Wu-Manber bitap: one Shift-Or state per allowed
+ * mismatch count, for patterns up to 64 bytes. Long texts go to the SIMD
+ * kernels instead, which count the mismatches of 16-64 alignments at once.
+ *
+ * Edit distance uses Myers' bit-vector algorithm: the DP column is held as
+ * +1/-1 vertical delta vectors in 64-bit blocks, so each text byte costs
+ * O(ceil(m / 64)) word operations regardless of k.
+ */
+
+#include "../config.hpp"
+#include "shift_or.hpp"
+#include "simd/dispatch.hpp"
+
+#if KMP_HAS_AVX512
+    #include "simd/avx512.hpp"
+#endif
+#if KMP_HAS_AVX2
+    #include "simd/avx2.hpp"
+#endif
+#if KMP_HAS_SSE42
+    #include "simd/sse42.hpp"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kmp::detail {
+
+// =============================================================================
+// Hamming Distance
+// =============================================================================
+
+/**
+ * @brief Number of i < len with a[i] != b[i]
+ */
+[[nodiscard]] inline size_type hamming_distance(
+    const char* a,
+    const char* b,
+    size_type len
+) noexcept {
+    size_type mismatches = 0;
+    for (size_type i = 0; i < len; ++i) {
+        mismatches += a[i] != b[i];
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Write every position within k mismatches of pattern to out
+ *
+ * state[d] has bit i clear while pattern[0..i] matches the text ending at
+ * the current byte with at most d mismatches; a mismatch moves a prefix
+ * from state[d - 1] to state[d]. Requires k < m <= 64.
+ */
+template <typename OutputIt>
+OutputIt bitap_hamming(
+    std::string_view text,
+    std::string_view pattern,
+    size_type k,
+    OutputIt out
+) {
+    const size_type m = pattern.size();
+    const shift_or_table table(pattern);
+
+    std::vector<std::uint64_t> state(k + 1, ~std::uint64_t{0});
+    for (size_type i = 0; i < text.size(); ++i) {
+        const std::uint64_t mask = table.masks[static_cast<unsigned char>(text[i])];
+        std::uint64_t previous = state[0];
+        state[0] = (state[0] << 1) | mask;
+        for (size_type d = 1; d <= k; ++d) {
+            const std::uint64_t current = state[d];
+            state[d] = ((current << 1) | mask) & (previous << 1);
+            previous = current;
+        }
+        if (!(state[k] & table.accept)) {
+            *out++ = i + 1 - m;
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Write every position within k mismatches of pattern to out
+ *
+ * SIMD kernels for long texts, bitap for patterns up to 64 bytes, and a
+ * direct count with early exit otherwise. Requires a non-empty pattern.
+ */
+template <typename OutputIt>
+OutputIt hamming_find_all(
+    std::string_view text,
+    std::string_view pattern,
+    size_type k,
+    OutputIt out
+) {
+    const size_type n = text.size();
+    const size_type m = pattern.size();
+    if (n < m) {
+        return out;
+    }
+
+    if (k >= m) {
+        for (size_type pos = 0; pos + m <= n; ++pos) {
+            *out++ = pos;
+        }
+        return out;
+    }
+
+    if (k < 255 && n >= config::simd_threshold) {
+        const auto limit = static_cast<std::uint8_t>(k);
+        #if KMP_HAS_AVX512
+        if (detail::simd::has_avx512()) {
+            return detail::simd::hamming_search_all_avx512(
+                text.data(), n, pattern.data(), m, limit, out);
+        }
+        #endif
+        #if KMP_HAS_AVX2
+        if (detail::simd::has_avx2()) {
+            return detail::simd::hamming_search_all_avx2(
+                text.data(), n, pattern.data(), m, limit, out);
+        }
+        #endif
+        #if KMP_HAS_SSE42
+        if (detail::simd::has_sse42()) {
+            return detail::simd::hamming_search_all_sse42(
+                text.data(), n, pattern.data(), m, limit, out);
+        }
+        #endif
+    }
+
+    if (m <= 64) {
+        return bitap_hamming(text, pattern, k, out);
+    }
+
+    for (size_type pos = 0; pos + m <= n; ++pos) {
+        size_type mismatches = 0;
+        for (size_type i = 0; i < m && mismatches <= k; ++i) {
+            mismatches += text[pos + i] != pattern[i];
+        }
+        if (mismatches <= k) {
+            *out++ = pos;
+        }
+    }
+    return out;
+}
+
+// =============================================================================
+// Edit Distance (Myers)
+// =============================================================================
+
+/**
+ * @brief Pattern match vectors for Myers' algorithm
+ *
+ * Bit i of eq(c)[b] is set where pattern[64 * b + i] == c. Rows past the
+ * end of the pattern never reach row m, so their bits are left clear.
+ */
+struct myers_table {
+    size_type length;
+    size_type blocks;
+    std::uint64_t last_bit;  // row m - 1 within the last block
+    std::vector<std::uint64_t> peq;
+
+    explicit myers_table(std::string_view pattern)
+        : length(pattern.size())
+        , blocks((pattern.size() + 63) / 64)
+        , last_bit(std::uint64_t{1} << ((pattern.size() - 1) % 64))
+        , peq(256 * blocks, 0)
+    {
+        for (size_type i = 0; i < pattern.size(); ++i) {
+            peq[static_cast<unsigned char>(pattern[i]) * blocks + i / 64] |=
+                std::uint64_t{1} << (i % 64);
+        }
+    }
+
+    [[nodiscard]] const std::uint64_t* eq(char c) const noexcept {
+        return peq.data() + static_cast<unsigned char>(c) * blocks;
+    }
+};
+
+/**
+ * @brief One block of the DP column as vertical +1 / -1 delta vectors
+ */
+struct myers_block {
+    std::uint64_t pv = ~std::uint64_t{0};
+    std::uint64_t mv = 0;
+};
+
+/**
+ * @brief Advance a block by one text byte
+ *
+ * hin is the horizontal delta entering at the block's top row; returns
+ * the delta leaving at high_bit (the block's bottom row).
+ */
+[[nodiscard]] inline int myers_advance(
+    myers_block& block,
+    std::uint64_t eq,
+    int hin,
+    std::uint64_t high_bit
+) noexcept {
+    const std::uint64_t pv = block.pv;
+    const std::uint64_t mv = block.mv;
+    const std::uint64_t xv = eq | mv;
+    if (hin < 0) {
+        eq |= 1;
+    }
+    const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+
+    std::uint64_t ph = mv | ~(xh | pv);
+    std::uint64_t mh = pv & xh;
+    // Branch-free: the sign of the delta is unpredictable on real text
+    const int hout = static_cast<int>((ph & high_bit) != 0) - static_cast<int>((mh & high_bit) != 0);
+
+    ph <<= 1;
+    mh <<= 1;
+    if (hin < 0) {
+        mh |= 1;
+    } else if (hin > 0) {
+        ph |= 1;
+    }
+
+    block.pv = mh | ~(xv | ph);
+    block.mv = ph & xv;
+    return hout;
+}
+
+/**
+ * @brief Run Myers' algorithm over [first, last); calls on_column(j, d)
+ *        after the j-th byte
+ *
+ * d is the smallest edit distance between the pattern and a substring
+ * ending at that byte. With anchored the substring must start at first
+ * (row 0 grows by one per byte) instead of anywhere.
+ */
+template <std::input_iterator Iter, typename F>
+void myers_scan(
+    const myers_table& table,
+    Iter first,
+    Iter last,
+    bool anchored,
+    F on_column
+) {
+    const int top = anchored ? 1 : 0;
+    diff_type score = static_cast<diff_type>(table.length);
+    size_type j = 0;
+
+    if (table.blocks == 1) {
+        myers_block block;
+        for (; first != last; ++first, ++j) {
+            score += myers_advance(block, table.eq(*first)[0], top, table.last_bit);
+            on_column(j, static_cast<size_type>(score));
+        }
+        return;
+    }
+
+    std::vector<myers_block> column(table.blocks);
+    const size_type tail = table.blocks - 1;
+    constexpr std::uint64_t high_bit = std::uint64_t{1} << 63;
+    for (; first != last; ++first, ++j) {
+        const std::uint64_t* eq = table.eq(*first);
+        int carry = top;
+        for (size_type b = 0; b < tail; ++b) {
+            carry = myers_advance(column[b], eq[b], carry, high_bit);
+        }
+        score += myers_advance(column[tail], eq[tail], carry, table.last_bit);
+        on_column(j, static_cast<size_type>(score));
+    }
+}
+
+/**
+ * @brief Call on_hit(j, d) in order for each end j within k edits
+ *
+ * Patterns of one block run four interleaved lanes over consecutive
+ * ranges of ends, so four independent dependency chains overlap. A lane
+ * starts m + k bytes before its range, which is exact for distances up
+ * to k: a substring within k edits spans at most m + k bytes.
+ */
+template <typename F>
+void myers_search(
+    const myers_table& table,
+    std::string_view text,
+    size_type k,
+    F on_hit
+) {
+    const size_type n = text.size();
+    const size_type warm = table.length + k;
+
+    auto scan_from = [&](size_type first_end) {
+        const size_type start = first_end > warm ? first_end - warm : 0;
+        myers_scan(table, text.begin() + start, text.end(), false, [&](size_type j, size_type d) {
+            if (d <= k && start + j >= first_end) {
+                on_hit(start + j, d);
+            }
+        });
+    };
+
+    if (table.blocks != 1) {
+        scan_from(0);
+        return;
+    }
+
+    std::array<std::vector<size_type>, 4> hits;
+    size_type first_end = 0;
+    while (first_end < n) {
+        const size_type lane = std::min(config::approx_lane_bytes, (n - first_end) / 4);
+        if (lane < warm) {
+            scan_from(first_end);
+            return;
+        }
+
+        // Lane l reports ends [lo[l], lo[l] + lane) and reads from start[l]
+        std::array<size_type, 4> lo;
+        std::array<size_type, 4> start;
+        for (size_type l = 0; l < 4; ++l) {
+            lo[l] = first_end + l * lane;
+            start[l] = lo[l] > warm ? lo[l] - warm : 0;
+            hits[l].clear();
+        }
+
+        const size_type steps = lane + (lo[3] - start[3]);
+        const char* t0 = text.data() + start[0];
+        const char* t1 = text.data() + start[1];
+        const char* t2 = text.data() + start[2];
+        const char* t3 = text.data() + start[3];
+        myers_block b0, b1, b2, b3;
+        const auto initial = static_cast<diff_type>(table.length);
+        diff_type s0 = initial, s1 = initial, s2 = initial, s3 = initial;
+        const auto limit = static_cast<diff_type>(k);
+        const std::uint64_t* peq = table.peq.data();
+        const std::uint64_t last_bit = table.last_bit;
+
+        for (size_type i = 0; i < steps; ++i) {
+            s0 += myers_advance(b0, peq[static_cast<unsigned char>(t0[i])], 0, last_bit);
+            s1 += myers_advance(b1, peq[static_cast<unsigned char>(t1[i])], 0, last_bit);
+            s2 += myers_advance(b2, peq[static_cast<unsigned char>(t2[i])], 0, last_bit);
+            s3 += myers_advance(b3, peq[static_cast<unsigned char>(t3[i])], 0, last_bit);
+            if ((s0 <= limit) | (s1 <= limit) | (s2 <= limit) | (s3 <= limit)) {
+                const std::array<diff_type, 4> score = {s0, s1, s2, s3};
+                for (size_type l = 0; l < 4; ++l) {
+                    const size_type end = start[l] + i;
+                    if (score[l] <= limit && end >= lo[l] && end < lo[l] + lane) {
+                        hits[l].push_back(end);
+                        hits[l].push_back(static_cast<size_type>(score[l]));
+                    }
+                }
+            }
+        }
+
+        for (const auto& lane_hits : hits) {
+            for (size_type h = 0; h < lane_hits.size(); h += 2) {
+                on_hit(lane_hits[h], lane_hits[h + 1]);
+            }
+        }
+        first_end += 4 * lane;
+    }
+}
+
+/**
+ * @brief Report substrings within edit distance k of pattern
+ *
+ * Each maximal run of end positions within k yields one match: the end
+ * with the smallest distance (leftmost on ties), and the shortest
+ * substring ending there that attains it, found by an anchored pass of
+ * the reversed pattern over the reversed text. Calls
+ * emit(position, length, distance). Requires a non-empty pattern.
+ */
+template <typename Emit>
+void myers_find_all(
+    std::string_view text,
+    std::string_view pattern,
+    size_type k,
+    Emit emit
+) {
+    const size_type m = pattern.size();
+    const myers_table forward(pattern);
+    const myers_table backward(std::string(pattern.rbegin(), pattern.rend()));
+
+    auto report = [&](size_type end, size_type distance) {
+        // An alignment with d edits spans at most m + d bytes
+        const size_type window = std::min(end + 1, m + distance);
+        const std::string_view tail = text.substr(end + 1 - window, window);
+
+        size_type length = 0;
+        bool found = distance == m;  // the empty substring
+        myers_scan(backward, tail.rbegin(), tail.rend(), true, [&](size_type j, size_type d) {
+            if (!found && d == distance) {
+                length = j + 1;
+                found = true;
+            }
+        });
+        emit(end + 1 - length, length, distance);
+    };
+
+    bool in_run = false;
+    size_type last_end = 0;
+    size_type best_end = 0;
+    size_type best = 0;
+    myers_search(forward, text, k, [&](size_type j, size_type d) {
+        if (in_run && j != last_end + 1) {
+            report(best_end, best);
+            in_run = false;
+        }
+        if (!in_run || d < best) {
+            best = d;
+            best_end = j;
+        }
+        in_run = true;
+        last_end = j;
+    });
+    if (in_run) {
+        report(best_end, best);
+    }
+}
+
+} // namespace kmp::detail
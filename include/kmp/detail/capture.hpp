@@ -0,0 +1,449 @@
+#pragma once
+
+/**
+ * @file capture.hpp
+ * @brief Capture groups and substitution templates for regex patterns
+ *
+ * The DFA finds where a match starts and how far it can reach; the same
+ * Thompson NFA (with save states) then resolves the match end and group
+ * bounds within that window, with leftmost-first priority (the semantics
+ * of std::regex_replace). Unmatched parts of the text are only ever
+ * scanned by the DFA, and resolving a match stays linear in its window.
+ */
+
+#include "../config.hpp"
+#include "dfa.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace kmp::detail {
+
+// Capture slot value for a group that did not participate in the match
+inline constexpr size_type no_position = static_cast<size_type>(-1);
+
+// =============================================================================
+// Capture Scratch
+// =============================================================================
+
+/**
+ * @brief Working memory for resolving a match's groups
+ *
+ * Sized on first use and reused afterwards, so repeated matches do not
+ * allocate.
+ */
+class capture_scratch {
+public:
+    capture_scratch() = default;
+
+private:
+    friend class capture_program;
+
+    // Pike VM: sparse set of NFA states in priority order, with their slots
+    struct thread_list {
+        std::vector<std::uint32_t> dense;
+        std::vector<std::uint32_t> sparse;
+        std::vector<size_type> slots;  // [state][slot]
+        size_type size = 0;
+
+        void resize(size_type states, size_type slot_count) {
+            dense.resize(states);
+            sparse.resize(states);
+            slots.resize(states * slot_count);
+            size = 0;
+        }
+
+        [[nodiscard]] bool contains(size_type state) const noexcept {
+            std::uint32_t i = sparse[state];
+            return i < size && dense[i] == state;
+        }
+
+        void insert(size_type state) noexcept {
+            sparse[state] = static_cast<std::uint32_t>(size);
+            dense[size++] = static_cast<std::uint32_t>(state);
+        }
+    };
+
+    // Exploration stack: a state to visit at pos, or a slot to restore
+    struct frame {
+        size_type state;
+        size_type pos;
+        size_type slot;
+        size_type value;
+        bool restore;
+    };
+
+    thread_list current_;
+    thread_list next_;
+    std::vector<frame> stack_;
+    std::vector<size_type> working_;
+    std::vector<size_type> best_;
+    std::vector<std::uint64_t> visited_;  // backtracker: [state][pos] bits
+};
+
+// =============================================================================
+// Capture Program
+// =============================================================================
+
+/**
+ * @brief Thompson NFA with save states for resolving groups
+ *
+ * Given a match start and the DFA's longest end, a bounded backtracker
+ * (each state and position visited once) explores the window in
+ * priority order; windows over config::max_backtrack_bits use a Pike VM.
+ */
+class capture_program {
+public:
+    capture_program() = default;
+
+    /**
+     * @throws std::runtime_error if pattern is invalid
+     */
+    explicit capture_program(std::string_view pattern) {
+        nfa_builder nfa(pattern, true);
+        start_ = nfa.start();
+        group_count_ = nfa.group_count();
+        states_ = nfa.take_states();
+    }
+
+    /**
+     * @brief Number of capture groups, not counting the whole match
+     */
+    [[nodiscard]] size_type group_count() const noexcept {
+        return group_count_;
+    }
+
+    /**
+     * @brief Slots for the whole match plus every group
+     */
+    [[nodiscard]] size_type slot_count() const noexcept {
+        return 2 * (group_count_ + 1);
+    }
+
+    /**
+     * @brief Leftmost-first match starting exactly at text[start]
+     *
+     * No match may end after limit (the longest match end, from the DFA).
+     * Writes slot_count() positions to slots (no_position for groups that
+     * did not participate); slots[0] and slots[1] bound the match.
+     * @return false if no match starts at start
+     */
+    bool match_at(
+        std::string_view text,
+        size_type start,
+        size_type limit,
+        std::span<size_type> slots,
+        capture_scratch& scratch
+    ) const {
+        if (states_.empty() || start > limit || limit > text.size()) {
+            return false;
+        }
+        scratch.working_.assign(slot_count(), no_position);
+
+        const size_type width = limit - start + 1;
+        const bool found = states_.size() * width <= config::max_backtrack_bits
+            ? backtrack(text, start, limit, scratch)
+            : pike(text, start, limit, scratch);
+        if (found) {
+            std::copy_n(scratch.working_.begin(),
+                        std::min(scratch.working_.size(), slots.size()), slots.begin());
+        }
+        return found;
+    }
+
+private:
+    std::vector<nfa_state> states_;
+    size_type start_ = 0;
+    size_type group_count_ = 0;
+
+    [[nodiscard]] static bool consumes(const nfa_state& state, unsigned char c) noexcept {
+        if (state.kind == nfa_state::type::char_match) {
+            // Non-ASCII bytes never match, as in the DFA
+            return c < config::ascii_size && static_cast<unsigned char>(state.match_char) == c;
+        }
+        if (state.kind == nfa_state::type::class_match) {
+            return c < config::ascii_size && state.match_class.test(static_cast<char>(c));
+        }
+        return false;
+    }
+
+    [[nodiscard]] static bool at_word_boundary(std::string_view text, size_type pos) noexcept {
+        const auto word = char_class::word();
+        bool before = pos > 0 && word.test(text[pos - 1]);
+        bool after = pos < text.size() && word.test(text[pos]);
+        return before != after;
+    }
+
+    [[nodiscard]] static bool assertion_holds(
+        const nfa_state& state,
+        std::string_view text,
+        size_type pos
+    ) noexcept {
+        return at_word_boundary(text, pos) == (state.kind == nfa_state::type::word_boundary);
+    }
+
+    // Depth-first search in priority order; the first accept reached is
+    // the leftmost-first match. A (state, pos) pair that was explored
+    // before cannot lead to an accept, whatever the slots.
+    bool backtrack(
+        std::string_view text,
+        size_type start,
+        size_type limit,
+        capture_scratch& scratch
+    ) const {
+        const size_type width = limit - start + 1;
+        auto& visited = scratch.visited_;
+        visited.assign((states_.size() * width + 63) / 64, 0);
+        auto& slots = scratch.working_;
+        auto& stack = scratch.stack_;
+        stack.clear();
+        stack.push_back({start_, start, 0, 0, false});
+
+        while (!stack.empty()) {
+            auto f = stack.back();
+            stack.pop_back();
+
+            if (f.restore) {
+                slots[f.slot] = f.value;
+                continue;
+            }
+
+            size_type state = f.state;
+            size_type pos = f.pos;
+            while (state < states_.size()) {
+                const size_type bit = state * width + (pos - start);
+                if (visited[bit / 64] & (std::uint64_t{1} << (bit % 64))) {
+                    break;
+                }
+                visited[bit / 64] |= std::uint64_t{1} << (bit % 64);
+
+                const auto& s = states_[state];
+                if (s.kind == nfa_state::type::accept) {
+                    return true;
+                }
+                if (s.kind == nfa_state::type::epsilon) {
+                    if (s.has_next2()) {
+                        stack.push_back({s.next2, pos, 0, 0, false});
+                    }
+                } else if (s.kind == nfa_state::type::save) {
+                    stack.push_back({0, 0, s.slot, slots[s.slot], true});
+                    slots[s.slot] = pos;
+                } else if (s.kind == nfa_state::type::word_boundary ||
+                           s.kind == nfa_state::type::not_word_boundary) {
+                    if (!assertion_holds(s, text, pos)) {
+                        break;
+                    }
+                } else {
+                    // No match ends beyond limit
+                    if (pos == limit || !consumes(s, static_cast<unsigned char>(text[pos]))) {
+                        break;
+                    }
+                    ++pos;
+                }
+                state = s.next1;  // no_transition ends the path
+            }
+        }
+        return false;
+    }
+
+    bool pike(
+        std::string_view text,
+        size_type start,
+        size_type limit,
+        capture_scratch& scratch
+    ) const {
+        const size_type count = slot_count();
+        auto& clist = scratch.current_;
+        auto& nlist = scratch.next_;
+        if (clist.dense.size() != states_.size() || clist.slots.size() != states_.size() * count) {
+            clist.resize(states_.size(), count);
+            nlist.resize(states_.size(), count);
+        }
+        clist.size = 0;
+        nlist.size = 0;
+
+        auto& best = scratch.best_;
+        best.clear();
+        add_thread(clist, start_, text, start, scratch);
+
+        for (size_type i = start; clist.size > 0; ++i) {
+            for (size_type t = 0; t < clist.size; ++t) {
+                const size_type s = clist.dense[t];
+                const auto& state = states_[s];
+                const size_type* thread_slots = clist.slots.data() + s * count;
+
+                if (state.kind == nfa_state::type::accept) {
+                    // Lower-priority threads can no longer win
+                    best.assign(thread_slots, thread_slots + count);
+                    break;
+                }
+                if (i < limit && consumes(state, static_cast<unsigned char>(text[i]))) {
+                    scratch.working_.assign(thread_slots, thread_slots + count);
+                    add_thread(nlist, state.next1, text, i + 1, scratch);
+                }
+            }
+
+            if (i == limit) {
+                break;
+            }
+            std::swap(clist, nlist);
+            nlist.size = 0;
+        }
+
+        if (best.empty()) {
+            return false;
+        }
+        scratch.working_.swap(best);
+        return true;
+    }
+
+    // Follow epsilons from state in priority order, recording the threads
+    // (consuming and accept states) that scratch.working_ slots reach
+    void add_thread(
+        capture_scratch::thread_list& list,
+        size_type state,
+        std::string_view text,
+        size_type pos,
+        capture_scratch& scratch
+    ) const {
+        const size_type count = slot_count();
+        auto& stack = scratch.stack_;
+        auto& working = scratch.working_;
+        stack.clear();
+        stack.push_back({state, pos, 0, 0, false});
+
+        while (!stack.empty()) {
+            auto f = stack.back();
+            stack.pop_back();
+
+            if (f.restore) {
+                working[f.slot] = f.value;
+                continue;
+            }
+            if (f.state >= states_.size() || list.contains(f.state)) {
+                continue;
+            }
+            list.insert(f.state);
+
+            const auto& s = states_[f.state];
+            switch (s.kind) {
+                case nfa_state::type::epsilon:
+                    // next1 is explored first (higher priority)
+                    if (s.has_next2()) {
+                        stack.push_back({s.next2, pos, 0, 0, false});
+                    }
+                    if (s.has_next1()) {
+                        stack.push_back({s.next1, pos, 0, 0, false});
+                    }
+                    break;
+                case nfa_state::type::save:
+                    stack.push_back({0, 0, s.slot, working[s.slot], true});
+                    working[s.slot] = pos;
+                    stack.push_back({s.next1, pos, 0, 0, false});
+                    break;
+                case nfa_state::type::word_boundary:
+                case nfa_state::type::not_word_boundary:
+                    if (assertion_holds(s, text, pos)) {
+                        stack.push_back({s.next1, pos, 0, 0, false});
+                    }
+                    break;
+                default:
+                    std::copy(working.begin(), working.end(),
+                              list.slots.begin() + static_cast<diff_type>(f.state * count));
+                    break;
+            }
+        }
+    }
+};
+
+// =============================================================================
+// Substitution Templates
+// =============================================================================
+
+/**
+ * @brief One piece of a parsed substitution: literal text or a group
+ */
+struct substitution_piece {
+    std::string_view literal;
+    size_type group = no_position;  // no_position for literal pieces
+};
+
+/**
+ * @brief Parse a "$1=$2" style template into pieces
+ *
+ * $n and ${n} insert group n ($0 and $& the whole match), $$ inserts a
+ * dollar sign; any other $ is literal. Literal pieces view the template.
+ *
+ * @throws std::runtime_error if a group exceeds group_count
+ */
+inline void parse_substitution(
+    std::string_view replacement,
+    size_type group_count,
+    std::vector<substitution_piece>& pieces
+) {
+    pieces.clear();
+
+    auto add_group = [&](size_type group) {
+        if (group > group_count) {
+            throw std::runtime_error("Substitution refers to a missing capture group");
+        }
+        pieces.push_back({{}, group});
+    };
+    auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+
+    size_type literal_start = 0;
+    size_type i = 0;
+    while (i < replacement.size()) {
+        if (replacement[i] != '$' || i + 1 == replacement.size()) {
+            ++i;
+            continue;
+        }
+
+        const char c = replacement[i + 1];
+        size_type end = i;  // end of the reference; unchanged if none
+        if (c == '$') {
+            pieces.push_back({replacement.substr(literal_start, i + 1 - literal_start)});
+            end = i + 2;
+        } else if (c == '&') {
+            pieces.push_back({replacement.substr(literal_start, i - literal_start)});
+            add_group(0);
+            end = i + 2;
+        } else if (is_digit(c)) {
+            pieces.push_back({replacement.substr(literal_start, i - literal_start)});
+            add_group(static_cast<size_type>(c - '0'));
+            end = i + 2;
+        } else if (c == '{') {
+            size_type j = i + 2;
+            size_type group = 0;
+            while (j < replacement.size() && is_digit(replacement[j])) {
+                if (group <= group_count) {  // large enough to be rejected; no overflow
+                    group = group * 10 + static_cast<size_type>(replacement[j] - '0');
+                }
+                ++j;
+            }
+            if (j > i + 2 && j < replacement.size() && replacement[j] == '}') {
+                pieces.push_back({replacement.substr(literal_start, i - literal_start)});
+                add_group(group);
+                end = j + 1;
+            }
+        }
+
+        if (end == i) {
+            ++i;
+        } else {
+            i = end;
+            literal_start = end;
+        }
+    }
+    pieces.push_back({replacement.substr(literal_start)});
+
+    std::erase_if(pieces, [](const substitution_piece& p) {
+        return p.group == no_position && p.literal.empty();
+    });
+}
+
+} // namespace kmp::detail
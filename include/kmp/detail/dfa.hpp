@@ -21,6 +21,7 @@
  *   ^       - start anchor
  *   $       - end anchor
  *   \d \w \s - shorthand classes
+ *   \b \B   - word boundary / non-boundary (\w per char_class::word())
  *
  * NOT supported (non-linear):
  *   \1      - backreference
@@ -29,17 +30,28 @@
  */
 
 #include "../config.hpp"
+#include "simd/dispatch.hpp"
+
+#if KMP_HAS_AVX512
+    #include "simd/avx512.hpp"
+#endif
+#if KMP_HAS_AVX2
+    #include "simd/avx2.hpp"
+#endif
+#if KMP_HAS_SSE42
+    #include "simd/sse42.hpp"
+#endif
+
 #include <algorithm>
 #include <array>
 #include <vector>
-#include <bitset>
 #include <string>
 #include <string_view>
-#include <unordered_map>
-#include <unordered_set>
 #include <optional>
 #include <stdexcept>
 #include <memory>
+#include <span>
+#include <cstring>
 
 namespace kmp::detail {
 
@@ -49,55 +61,69 @@ namespace kmp::detail {
 
 /**
  * @brief Bitset representing a set of ASCII characters
+ *
+ * Stored as two 64-bit words so it is usable in constant expressions
+ * (compile-time regexes).
  */
 class char_class {
 public:
     static constexpr size_type size = config::ascii_size;
+    static_assert(size == 128);
 
     constexpr char_class() = default;
 
     constexpr void set(char c) noexcept {
-        if (static_cast<unsigned char>(c) < size) {
-            bits_.set(static_cast<unsigned char>(c));
+        auto uc = static_cast<unsigned char>(c);
+        if (uc < size) {
+            words_[uc >> 6] |= std::uint64_t{1} << (uc & 63);
         }
     }
 
     constexpr void set_range(char from, char to) noexcept {
-        for (unsigned char c = static_cast<unsigned char>(from);
+        for (unsigned c = static_cast<unsigned char>(from);
              c <= static_cast<unsigned char>(to) && c < size; ++c) {
-            bits_.set(c);
+            set(static_cast<char>(c));
         }
     }
 
     constexpr void set_all() noexcept {
-        bits_.set();
+        words_ = {~std::uint64_t{0}, ~std::uint64_t{0}};
     }
 
-    constexpr void flip() noexcept {
-        bits_.flip();
-        // Ensure non-ASCII bits are off
-        for (size_type i = size; i < bits_.size(); ++i) {
-            bits_.reset(i);
+    constexpr void reset(char c) noexcept {
+        auto uc = static_cast<unsigned char>(c);
+        if (uc < size) {
+            words_[uc >> 6] &= ~(std::uint64_t{1} << (uc & 63));
         }
     }
 
+    constexpr void flip() noexcept {
+        words_[0] = ~words_[0];
+        words_[1] = ~words_[1];
+    }
+
     [[nodiscard]] constexpr bool test(char c) const noexcept {
         auto uc = static_cast<unsigned char>(c);
-        return uc < size && bits_.test(uc);
+        return uc < size && ((words_[uc >> 6] >> (uc & 63)) & 1) != 0;
     }
 
     [[nodiscard]] constexpr bool any() const noexcept {
-        return bits_.any();
+        return (words_[0] | words_[1]) != 0;
+    }
+
+    constexpr void merge(const char_class& other) noexcept {
+        words_[0] |= other.words_[0];
+        words_[1] |= other.words_[1];
     }
 
     // Predefined character classes
-    [[nodiscard]] static char_class digit() {
+    [[nodiscard]] static constexpr char_class digit() {
         char_class cc;
         cc.set_range('0', '9');
         return cc;
     }
 
-    [[nodiscard]] static char_class word() {
+    [[nodiscard]] static constexpr char_class word() {
         char_class cc;
         cc.set_range('a', 'z');
         cc.set_range('A', 'Z');
@@ -106,7 +132,7 @@ public:
         return cc;
     }
 
-    [[nodiscard]] static char_class space() {
+    [[nodiscard]] static constexpr char_class space() {
         char_class cc;
         cc.set(' ');
         cc.set('\t');
@@ -117,15 +143,15 @@ public:
         return cc;
     }
 
-    [[nodiscard]] static char_class any_char() {
+    [[nodiscard]] static constexpr char_class any_char() {
         char_class cc;
         cc.set_all();
-        cc.bits_.reset('\n');  // . doesn't match newline by default
+        cc.reset('\n');  // . doesn't match newline by default
         return cc;
     }
 
 private:
-    std::bitset<size> bits_{};
+    std::array<std::uint64_t, 2> words_{};
 };
 
 // =============================================================================
@@ -140,6 +166,9 @@ struct nfa_state {
         epsilon,      // epsilon transition
         char_match,   // single character
         class_match,  // character class
+        word_boundary,      // \b: epsilon taken only between \w and \W
+        not_word_boundary,  // \B: epsilon taken only between \w\w or \W\W
+        save,         // epsilon that records the position in a capture slot
         accept        // accepting state
     };
 
@@ -148,9 +177,10 @@ struct nfa_state {
     char_class match_class{};
     size_type next1 = no_transition;  // primary transition
     size_type next2 = no_transition;  // secondary (for epsilon splits)
+    size_type slot = 0;               // capture slot (save states)
 
-    [[nodiscard]] bool has_next1() const noexcept { return next1 != no_transition; }
-    [[nodiscard]] bool has_next2() const noexcept { return next2 != no_transition; }
+    [[nodiscard]] constexpr bool has_next1() const noexcept { return next1 != no_transition; }
+    [[nodiscard]] constexpr bool has_next2() const noexcept { return next2 != no_transition; }
 };
 
 // =============================================================================
@@ -163,126 +193,190 @@ struct nfa_fragment {
 };
 
 // =============================================================================
-// DFA State
+// DFA State (construction)
 // =============================================================================
 
 struct dfa_state {
     std::array<size_type, config::ascii_size> transitions{};
-    bool is_accept = false;
-
-    dfa_state() {
+    bool is_accept = false;       // accepting if next byte is \W or end of text
+    bool is_accept_word = false;  // accepting if next byte is \w
+
+    // Self-loop acceleration: every ASCII byte except escapes[0..escape_count)
+    // loops back to this (non-accepting) state, so a run can be skipped by
+    // scanning for the next escape or non-ASCII byte
+    static constexpr size_type max_escapes = 3;
+    std::array<char, max_escapes> escapes{};
+    std::uint8_t escape_count = 0;
+    bool accelerated = false;
+
+    constexpr dfa_state() {
         transitions.fill(static_cast<size_type>(-1));  // dead state
     }
 };
 
 // =============================================================================
-// Compiled DFA
+// Packed DFA Layout (in-memory and serialized)
 // =============================================================================
 
-class compiled_dfa {
-public:
-    compiled_dfa() = default;
+/**
+ * @brief Header of a packed DFA blob
+ *
+ * A blob is this header followed by 8-byte aligned sections: the byte class
+ * map, per-state info, class-compressed transitions, the optional two-byte
+ * stride table and the pattern source. Compiled DFAs use the same layout in
+ * memory, so a serialized blob can be searched in place.
+ */
+struct dfa_blob_header {
+    static constexpr std::array<char, 4> expected_magic{'K', 'D', 'F', 'A'};
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::uint32_t native_endian_tag = 0x01020304;
+    static constexpr std::uint32_t swapped_endian_tag = 0x04030201;
+
+    static constexpr std::uint32_t flag_assertions = 1u << 0;  // uses \b or \B
+    static constexpr std::uint32_t flag_stride = 1u << 1;      // has stride table
+
+    std::array<char, 4> magic;
+    std::uint32_t endian_tag;
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint32_t state_count;
+    std::uint32_t class_count;
+    std::uint32_t start_word;
+    std::uint32_t source_size;
+    std::uint64_t total_size;
+};
 
-    /**
-     * @brief Compile a regex pattern into DFA
-     * @throws std::runtime_error if pattern is invalid or too complex
-     */
-    explicit compiled_dfa(std::string_view pattern) {
-        compile(pattern);
-    }
+static_assert(sizeof(dfa_blob_header) == 40);
 
-    /**
-     * @brief Check if pattern matches anywhere in text
-     * @return Position of first match, or nullopt if not found
-     */
-    [[nodiscard]] std::optional<size_type> search(std::string_view text) const noexcept {
-        if (states_.empty()) {
-            return std::nullopt;
-        }
+/**
+ * @brief Per-state info in a packed DFA (transitions live in their own table)
+ */
+struct packed_state {
+    static constexpr std::uint8_t accept = 1u << 0;       // next byte \W or end
+    static constexpr std::uint8_t accept_word = 1u << 1;  // next byte \w
+    static constexpr std::uint8_t accelerated = 1u << 2;
+
+    std::uint8_t flags;
+    std::uint8_t escape_count;
+    std::array<char, dfa_state::max_escapes> escapes;
+    std::array<std::uint8_t, 3> reserved;
+};
 
-        for (size_type start = 0; start < text.size(); ++start) {
-            size_type state = 0;
-            bool matched = states_[0].is_accept;
+static_assert(sizeof(packed_state) == 8);
 
-            for (size_type i = start; i < text.size(); ++i) {
-                auto c = static_cast<unsigned char>(text[i]);
-                if (c >= config::ascii_size) {
-                    break;  // non-ASCII
-                }
+/**
+ * @brief Section offsets of a packed DFA blob
+ */
+struct dfa_blob_layout {
+    size_type byte_class;
+    size_type states;
+    size_type transitions;
+    size_type stride;
+    size_type source;
+    size_type total;
+
+    [[nodiscard]] static constexpr size_type align8(size_type n) noexcept {
+        return (n + 7) & ~size_type{7};
+    }
 
-                size_type next = states_[state].transitions[c];
-                if (next == static_cast<size_type>(-1)) {
-                    break;  // dead state
-                }
+    [[nodiscard]] static constexpr dfa_blob_layout compute(
+        size_type state_count,
+        size_type class_count,
+        bool has_stride,
+        size_type source_size
+    ) noexcept {
+        dfa_blob_layout l{};
+        l.byte_class = align8(sizeof(dfa_blob_header));
+        l.states = align8(l.byte_class + 256);
+        l.transitions = align8(l.states + state_count * sizeof(packed_state));
+        l.stride = align8(l.transitions + state_count * class_count * sizeof(std::uint32_t));
+        l.source = align8(l.stride + (has_stride
+            ? state_count * class_count * class_count * sizeof(std::uint32_t) : 0));
+        l.total = align8(l.source + source_size);
+        return l;
+    }
+};
 
-                state = next;
-                if (states_[state].is_accept) {
-                    return start;
-                }
-            }
+// Dead entry in the packed transition table
+inline constexpr std::uint32_t dead_state = static_cast<std::uint32_t>(-1);
 
-            if (matched) {
-                return start;
-            }
-        }
+/**
+ * @brief Encoding of two-byte (stride) table entries
+ *
+ * An entry holds the target's row offset (target * class_count^2) so the
+ * dependent chain is one add and one load per two bytes; the high bits
+ * flag pairs that need the general loop. Entries are `none` when the pair
+ * cannot be taken at all (dead state or non-ASCII byte).
+ */
+struct stride_entry {
+    static constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+    static constexpr std::uint32_t accel = 1u << 31;       // target is accelerated
+    static constexpr std::uint32_t accept = 1u << 30;      // target may accept
+    static constexpr std::uint32_t mid_accept = 1u << 29;  // match may end mid-pair
+    static constexpr std::uint32_t blocked = 1u << 28;     // set only in none
+    static constexpr std::uint32_t row_mask = blocked - 1;
+};
 
-        return std::nullopt;
-    }
+// =============================================================================
+// NFA Builder
+// =============================================================================
 
+/**
+ * @brief Thompson NFA construction by recursive descent
+ *
+ * Split states prefer next1 over next2, so the NFA also encodes
+ * leftmost-first (Perl) priority. With captures enabled, groups are
+ * bracketed by save states (slots 0 and 1 hold the whole match), as
+ * used by the Pike VM in capture.hpp; the DFA builder omits them.
+ */
+class nfa_builder {
+public:
     /**
-     * @brief Check if pattern matches the entire text
+     * @throws std::runtime_error if pattern is invalid
      */
-    [[nodiscard]] bool matches(std::string_view text) const noexcept {
-        if (states_.empty()) {
-            return false;
-        }
-
-        size_type state = 0;
-
-        for (char c : text) {
-            auto uc = static_cast<unsigned char>(c);
-            if (uc >= config::ascii_size) {
-                return false;
-            }
-
-            size_type next = states_[state].transitions[uc];
-            if (next == static_cast<size_type>(-1)) {
-                return false;
-            }
-            state = next;
-        }
-
-        return states_[state].is_accept;
+    explicit constexpr nfa_builder(std::string_view pattern, bool captures = false)
+        : captures_(captures)
+    {
+        build(pattern);
     }
 
-    [[nodiscard]] bool empty() const noexcept {
-        return states_.empty();
+    [[nodiscard]] constexpr const std::vector<nfa_state>& states() const noexcept {
+        return nfa_states_;
     }
 
-    [[nodiscard]] size_type state_count() const noexcept {
-        return states_.size();
+    [[nodiscard]] constexpr std::vector<nfa_state> take_states() noexcept {
+        return std::move(nfa_states_);
     }
 
-private:
-    std::vector<dfa_state> states_;
-    std::vector<nfa_state> nfa_states_;
-    size_type nfa_start_ = 0;  // NFA start state
+    [[nodiscard]] constexpr size_type start() const noexcept { return nfa_start_; }
+    [[nodiscard]] constexpr bool has_assertions() const noexcept { return has_assertions_; }
 
-    void compile(std::string_view pattern) {
-        // Step 1: Parse and build NFA using Thompson construction
-        build_nfa(pattern);
+    /**
+     * @brief Number of capture groups, not counting the whole match
+     */
+    [[nodiscard]] constexpr size_type group_count() const noexcept { return group_count_; }
 
-        // Step 2: Convert NFA to DFA using subset construction
-        build_dfa();
-    }
+private:
+    std::vector<nfa_state> nfa_states_;
+    size_type nfa_start_ = 0;
+    size_type group_count_ = 0;
+    bool has_assertions_ = false;
+    bool captures_ = false;
 
-    void build_nfa(std::string_view pattern) {
+    constexpr void build(std::string_view pattern) {
         nfa_states_.clear();
         nfa_states_.reserve(pattern.size() * 2);
+        has_assertions_ = false;
+        group_count_ = 0;
 
         size_type pos = 0;
         auto frag = parse_regex(pattern, pos);
 
+        if (captures_) {
+            // Slots 0 and 1 bracket the whole match
+            frag = make_group(frag, 0);
+        }
+
         // Store the NFA start state
         nfa_start_ = frag.start;
 
@@ -295,11 +389,11 @@ private:
     }
 
     // Recursive descent parser for regex
-    nfa_fragment parse_regex(std::string_view pattern, size_type& pos) {
+    constexpr nfa_fragment parse_regex(std::string_view pattern, size_type& pos) {
         return parse_alternation(pattern, pos);
     }
 
-    nfa_fragment parse_alternation(std::string_view pattern, size_type& pos) {
+    constexpr nfa_fragment parse_alternation(std::string_view pattern, size_type& pos) {
         auto left = parse_concatenation(pattern, pos);
 
         while (pos < pattern.size() && pattern[pos] == '|') {
@@ -323,7 +417,7 @@ private:
         return left;
     }
 
-    nfa_fragment parse_concatenation(std::string_view pattern, size_type& pos) {
+    constexpr nfa_fragment parse_concatenation(std::string_view pattern, size_type& pos) {
         nfa_fragment result{0, 0};
         bool first = true;
 
@@ -349,7 +443,7 @@ private:
         return result;
     }
 
-    nfa_fragment parse_quantified(std::string_view pattern, size_type& pos) {
+    constexpr nfa_fragment parse_quantified(std::string_view pattern, size_type& pos) {
         auto base = parse_atom(pattern, pos);
 
         if (pos >= pattern.size()) {
@@ -371,7 +465,7 @@ private:
         return base;
     }
 
-    nfa_fragment parse_atom(std::string_view pattern, size_type& pos) {
+    constexpr nfa_fragment parse_atom(std::string_view pattern, size_type& pos) {
         if (pos >= pattern.size()) {
             throw std::runtime_error("Unexpected end of pattern");
         }
@@ -380,12 +474,14 @@ private:
 
         if (c == '(') {
             ++pos;
+            // Groups are numbered by their opening parenthesis
+            size_type group = ++group_count_;
             auto inner = parse_regex(pattern, pos);
             if (pos >= pattern.size() || pattern[pos] != ')') {
                 throw std::runtime_error("Unmatched parenthesis");
             }
             ++pos;
-            return inner;
+            return captures_ ? make_group(inner, group) : inner;
         }
 
         if (c == '[') {
@@ -420,7 +516,7 @@ private:
         return {state, state};
     }
 
-    nfa_fragment parse_char_class(std::string_view pattern, size_type& pos) {
+    constexpr nfa_fragment parse_char_class(std::string_view pattern, size_type& pos) {
         ++pos;  // consume '['
         bool negated = false;
 
@@ -461,7 +557,7 @@ private:
         return {state, state};
     }
 
-    nfa_fragment parse_escape(std::string_view pattern, size_type& pos) {
+    constexpr nfa_fragment parse_escape(std::string_view pattern, size_type& pos) {
         if (pos >= pattern.size()) {
             throw std::runtime_error("Incomplete escape sequence");
         }
@@ -500,6 +596,14 @@ private:
                 nfa_states_.push_back({nfa_state::type::class_match, '\0', cc, no_transition, no_transition});
                 break;
             }
+            case 'b':
+                has_assertions_ = true;
+                nfa_states_.push_back({nfa_state::type::word_boundary, '\0', {}, no_transition, no_transition});
+                break;
+            case 'B':
+                has_assertions_ = true;
+                nfa_states_.push_back({nfa_state::type::not_word_boundary, '\0', {}, no_transition, no_transition});
+                break;
             default:
                 // Literal escape (e.g., \., \*, etc.)
                 nfa_states_.push_back({nfa_state::type::char_match, c, {}, no_transition, no_transition});
@@ -509,20 +613,16 @@ private:
         return {state, state};
     }
 
-    void add_escape_to_class(char_class& cc, char c) {
+    constexpr void add_escape_to_class(char_class& cc, char c) {
         switch (c) {
             case 'd':
-                for (char ch = '0'; ch <= '9'; ++ch) cc.set(ch);
+                cc.merge(char_class::digit());
                 break;
             case 'w':
-                for (char ch = 'a'; ch <= 'z'; ++ch) cc.set(ch);
-                for (char ch = 'A'; ch <= 'Z'; ++ch) cc.set(ch);
-                for (char ch = '0'; ch <= '9'; ++ch) cc.set(ch);
-                cc.set('_');
+                cc.merge(char_class::word());
                 break;
             case 's':
-                cc.set(' '); cc.set('\t'); cc.set('\n');
-                cc.set('\r'); cc.set('\f'); cc.set('\v');
+                cc.merge(char_class::space());
                 break;
             default:
                 cc.set(c);
@@ -530,7 +630,7 @@ private:
         }
     }
 
-    nfa_fragment make_star(nfa_fragment inner) {
+    constexpr nfa_fragment make_star(nfa_fragment inner) {
         // a* = (a|epsilon)*
         // Create split state: can go to inner or skip (next2 is the skip path)
         size_type split = nfa_states_.size();
@@ -542,7 +642,7 @@ private:
         return {split, split};
     }
 
-    nfa_fragment make_plus(nfa_fragment inner) {
+    constexpr nfa_fragment make_plus(nfa_fragment inner) {
         // a+ = aa*
         // Must match inner at least once, then optionally repeat
         size_type split = nfa_states_.size();
@@ -554,7 +654,7 @@ private:
         return {inner.start, split};
     }
 
-    nfa_fragment make_optional(nfa_fragment inner) {
+    constexpr nfa_fragment make_optional(nfa_fragment inner) {
         size_type split = nfa_states_.size();
         nfa_states_.push_back({nfa_state::type::epsilon, '\0', {}, inner.start, no_transition});
         size_type join = nfa_states_.size();
@@ -564,7 +664,19 @@ private:
         return {split, join};
     }
 
-    void patch(size_type state, size_type target) {
+    // Wrap a fragment in save states recording its bounds in slots 2g, 2g+1
+    constexpr nfa_fragment make_group(nfa_fragment inner, size_type group) {
+        size_type open = nfa_states_.size();
+        nfa_states_.push_back({nfa_state::type::save, '\0', {}, inner.start, no_transition,
+                               2 * group});
+        size_type close = nfa_states_.size();
+        nfa_states_.push_back({nfa_state::type::save, '\0', {}, no_transition, no_transition,
+                               2 * group + 1});
+        patch(inner.end, close);
+        return {open, close};
+    }
+
+    constexpr void patch(size_type state, size_type target) {
         if (state < nfa_states_.size()) {
             auto& s = nfa_states_[state];
             // For epsilon states (split nodes), patch next2 if next1 is already set
@@ -584,65 +696,418 @@ private:
             }
         }
     }
+};
+
+// =============================================================================
+// DFA Builder
+// =============================================================================
+
+/**
+ * @brief Regex to DFA compiler producing the packed layout
+ *
+ * Parses the pattern (Thompson NFA), runs subset construction, then derives
+ * self-loop acceleration, byte classes and the stride table.
+ */
+class dfa_builder {
+public:
+    /**
+     * @throws std::runtime_error if pattern is invalid or too complex
+     */
+    explicit constexpr dfa_builder(std::string_view pattern) {
+        // Step 1: Parse and build NFA using Thompson construction
+        nfa_builder nfa(pattern);
+        nfa_start_ = nfa.start();
+        has_assertions_ = nfa.has_assertions();
+        nfa_states_ = nfa.take_states();
+
+        // Step 2: Convert NFA to DFA using subset construction
+        build_dfa();
+
+        // Step 3: Mark states whose runs can be skipped with SIMD
+        compute_acceleration();
+
+        // Step 4: Compress the alphabet and build two-byte transitions
+        compute_byte_classes();
+        if !consteval {
+            build_stride_table();
+        }
+    }
+
+    /**
+     * @brief Write the packed blob (8-byte aligned storage)
+     */
+    [[nodiscard]] std::vector<std::uint64_t> pack(std::string_view source) const {
+        const size_type n = states_.size();
+        const size_type k = class_count_;
+        const auto layout = dfa_blob_layout::compute(n, k, !stride_.empty(), source.size());
+
+        std::vector<std::uint64_t> storage(layout.total / sizeof(std::uint64_t), 0);
+        auto* base = reinterpret_cast<std::byte*>(storage.data());
+
+        dfa_blob_header header{};
+        header.magic = dfa_blob_header::expected_magic;
+        header.endian_tag = dfa_blob_header::native_endian_tag;
+        header.version = dfa_blob_header::current_version;
+        header.flags = (has_assertions_ ? dfa_blob_header::flag_assertions : 0) |
+                       (stride_.empty() ? 0 : dfa_blob_header::flag_stride);
+        header.state_count = static_cast<std::uint32_t>(n);
+        header.class_count = static_cast<std::uint32_t>(k);
+        header.start_word = static_cast<std::uint32_t>(start_word_);
+        header.source_size = static_cast<std::uint32_t>(source.size());
+        header.total_size = layout.total;
+        std::memcpy(base, &header, sizeof(header));
+
+        std::memcpy(base + layout.byte_class, byte_class_.data(), byte_class_.size());
+
+        // One representative byte per ASCII class
+        std::array<unsigned char, config::ascii_size> rep{};
+        for (size_type c = config::ascii_size; c-- > 0;) {
+            rep[byte_class_[c]] = static_cast<unsigned char>(c);
+        }
+
+        auto* states = reinterpret_cast<packed_state*>(base + layout.states);
+        auto* transitions = reinterpret_cast<std::uint32_t*>(base + layout.transitions);
+        for (size_type s = 0; s < n; ++s) {
+            const auto& st = states_[s];
+            packed_state ps{};
+            ps.flags = static_cast<std::uint8_t>(
+                (st.is_accept ? packed_state::accept : 0) |
+                (st.is_accept_word ? packed_state::accept_word : 0) |
+                (st.accelerated ? packed_state::accelerated : 0));
+            ps.escape_count = st.escape_count;
+            ps.escapes = st.escapes;
+            states[s] = ps;
+
+            for (size_type cls = 0; cls < k; ++cls) {
+                size_type next = cls + 1 < k ? st.transitions[rep[cls]] : no_transition;
+                transitions[s * k + cls] = next == no_transition
+                    ? dead_state : static_cast<std::uint32_t>(next);
+            }
+        }
+
+        if (!stride_.empty()) {
+            std::memcpy(base + layout.stride, stride_.data(),
+                        stride_.size() * sizeof(std::uint32_t));
+        }
+        std::memcpy(base + layout.source, source.data(), source.size());
+
+        return storage;
+    }
+
+    // Table access for compile-time regexes (see kmp::compiled_regex)
+    [[nodiscard]] constexpr size_type state_count() const noexcept { return states_.size(); }
+    [[nodiscard]] constexpr size_type class_count() const noexcept { return class_count_; }
+    [[nodiscard]] constexpr size_type start_word() const noexcept { return start_word_; }
+    [[nodiscard]] constexpr bool has_assertions() const noexcept { return has_assertions_; }
+
+    [[nodiscard]] constexpr std::uint8_t byte_class(unsigned char c) const noexcept {
+        return byte_class_[c];
+    }
+
+    [[nodiscard]] constexpr size_type transition(size_type state, unsigned char c) const noexcept {
+        return c < config::ascii_size ? states_[state].transitions[c] : no_transition;
+    }
+
+    [[nodiscard]] constexpr bool is_accept(size_type state) const noexcept {
+        return states_[state].is_accept;
+    }
+
+    [[nodiscard]] constexpr bool is_accept_word(size_type state) const noexcept {
+        return states_[state].is_accept_word;
+    }
+
+private:
+    std::vector<dfa_state> states_;
+    std::vector<nfa_state> nfa_states_;
+    size_type nfa_start_ = 0;  // NFA start state
+
+    // With \b or \B present, each DFA state also encodes whether the
+    // previous byte was \w; start_word_ is the start state after a \w byte.
+    char_class word_ = char_class::word();
+    bool has_assertions_ = false;
+    size_type start_word_ = 0;
+
+    // Byte equivalence classes: bytes with identical transitions (and \w
+    // membership when assertions are present) share a class. All non-ASCII
+    // bytes form the last class, which never transitions.
+    std::array<std::uint8_t, 256> byte_class_{};
+    size_type class_count_ = 0;
+
+    // Two-byte transitions indexed by [state][class][class]; empty if the
+    // table would exceed config::max_stride_table_bytes
+    std::vector<std::uint32_t> stride_;
+
+    // Whether a match ends at the current position, given the next byte
+    [[nodiscard]] constexpr bool accepts_before(size_type state, unsigned char next) const noexcept {
+        const auto& s = states_[state];
+        if (has_assertions_ && word_.test(static_cast<char>(next))) {
+            return s.is_accept_word;
+        }
+        return s.is_accept;
+    }
+
+    // Epsilon closure; leaves the set sorted (it doubles as a DFA state key)
+    constexpr void epsilon_closure(std::vector<size_type>& states) const {
+        follow_epsilons(states, false, false);
+    }
+
+    constexpr void compute_byte_classes() {
+        byte_class_.fill(0);
+        class_count_ = 0;
+
+        // Bytes are compared column by column; the hash only narrows the
+        // candidates so this stays usable in constant evaluation
+        auto same_column = [&](size_type a, size_type b) {
+            bool word_a = has_assertions_ && word_.test(static_cast<char>(a));
+            bool word_b = has_assertions_ && word_.test(static_cast<char>(b));
+            if (word_a != word_b) {
+                return false;
+            }
+            for (const auto& s : states_) {
+                if (s.transitions[a] != s.transitions[b]) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        std::array<std::uint64_t, config::ascii_size> hashes{};
+        std::array<size_type, config::ascii_size> reps{};
+        for (size_type c = 0; c < config::ascii_size; ++c) {
+            std::uint64_t h = (has_assertions_ && word_.test(static_cast<char>(c)))
+                ? 0x9e3779b97f4a7c15ULL : 0xcbf29ce484222325ULL;
+            for (const auto& s : states_) {
+                h = (h ^ static_cast<std::uint64_t>(s.transitions[c])) * 0x100000001b3ULL;
+            }
+            hashes[c] = h;
+
+            size_type cls = class_count_;
+            for (size_type k = 0; k < class_count_; ++k) {
+                if (hashes[reps[k]] == h && same_column(reps[k], c)) {
+                    cls = k;
+                    break;
+                }
+            }
+            if (cls == class_count_) {
+                reps[class_count_++] = c;
+            }
+            byte_class_[c] = static_cast<std::uint8_t>(cls);
+        }
+
+        class_count_ += 1;
+        for (size_type c = config::ascii_size; c < byte_class_.size(); ++c) {
+            byte_class_[c] = static_cast<std::uint8_t>(class_count_ - 1);
+        }
+    }
+
+    constexpr void build_stride_table() {
+        stride_.clear();
+
+        const size_type width = class_count_;
+        const size_type entries = states_.size() * width * width;
+        if (states_.empty() || entries * sizeof(std::uint32_t) > config::max_stride_table_bytes) {
+            return;
+        }
+
+        // One representative byte per ASCII class
+        std::array<unsigned char, config::ascii_size> rep{};
+        for (size_type c = config::ascii_size; c-- > 0;) {
+            rep[byte_class_[c]] = static_cast<unsigned char>(c);
+        }
+
+        stride_.assign(entries, stride_entry::none);
+        for (size_type s = 0; s < states_.size(); ++s) {
+            for (size_type k0 = 0; k0 + 1 < width; ++k0) {
+                size_type mid = states_[s].transitions[rep[k0]];
+                if (mid == no_transition) {
+                    continue;
+                }
+                for (size_type k1 = 0; k1 + 1 < width; ++k1) {
+                    size_type next = states_[mid].transitions[rep[k1]];
+                    if (next == no_transition) {
+                        continue;
+                    }
+                    auto entry = static_cast<std::uint32_t>(next * width * width);
+                    if (accepts_before(mid, rep[k1])) {
+                        entry |= stride_entry::mid_accept;
+                    }
+                    if (states_[next].accelerated) {
+                        entry |= stride_entry::accel;
+                    }
+                    if (states_[next].is_accept || states_[next].is_accept_word) {
+                        entry |= stride_entry::accept;
+                    }
+                    stride_[(s * width + k0) * width + k1] = entry;
+                }
+            }
+        }
+    }
+
+    constexpr void compute_acceleration() {
+        for (size_type id = 0; id < states_.size(); ++id) {
+            auto& s = states_[id];
+            s.accelerated = false;
+            s.escape_count = 0;
+
+            // A run can only be skipped if no match ends inside it
+            if (s.is_accept || s.is_accept_word) {
+                continue;
+            }
 
-    // Epsilon closure
-    void epsilon_closure(std::unordered_set<size_type>& states) const {
-        std::vector<size_type> stack(states.begin(), states.end());
+            size_type escapes = 0;
+            for (size_type c = 0; c < config::ascii_size; ++c) {
+                if (s.transitions[c] == id) {
+                    continue;
+                }
+                if (escapes == dfa_state::max_escapes) {
+                    escapes = dfa_state::max_escapes + 1;
+                    break;
+                }
+                s.escapes[escapes++] = static_cast<char>(c);
+            }
+
+            if (escapes >= 1 && escapes <= dfa_state::max_escapes) {
+                s.escape_count = static_cast<std::uint8_t>(escapes);
+                s.accelerated = true;
+            }
+        }
+    }
+
+    // Closure that also follows \b / \B edges satisfied at the current
+    // position (at_boundary: exactly one of the adjacent bytes is \\w)
+    constexpr void boundary_closure(std::vector<size_type>& states, bool at_boundary) const {
+        follow_epsilons(states, true, at_boundary);
+    }
+
+    constexpr void follow_epsilons(
+        std::vector<size_type>& states,
+        bool assertions,
+        bool at_boundary
+    ) const {
+        std::vector<std::uint8_t> seen(nfa_states_.size(), 0);
+        std::vector<size_type> stack;
+        size_type unique = 0;
+        for (auto s : states) {
+            if (!seen[s]) {
+                seen[s] = 1;
+                states[unique++] = s;
+                stack.push_back(s);
+            }
+        }
+        states.resize(unique);
+
+        auto visit = [&](size_type next) {
+            if (next < nfa_states_.size() && !seen[next]) {
+                seen[next] = 1;
+                states.push_back(next);
+                stack.push_back(next);
+            }
+        };
 
         while (!stack.empty()) {
             size_type s = stack.back();
             stack.pop_back();
 
-            if (s >= nfa_states_.size()) continue;
-
             const auto& state = nfa_states_[s];
-            if (state.kind == nfa_state::type::epsilon) {
-                if (state.has_next1() && states.insert(state.next1).second) {
-                    stack.push_back(state.next1);
-                }
-                if (state.has_next2() && states.insert(state.next2).second) {
-                    stack.push_back(state.next2);
-                }
+            bool follow = state.kind == nfa_state::type::epsilon ||
+                state.kind == nfa_state::type::save ||
+                (assertions && state.kind == nfa_state::type::word_boundary && at_boundary) ||
+                (assertions && state.kind == nfa_state::type::not_word_boundary && !at_boundary);
+
+            if (!follow) continue;
+
+            if (state.has_next1()) {
+                visit(state.next1);
+            }
+            if (state.kind == nfa_state::type::epsilon && state.has_next2()) {
+                visit(state.next2);
+            }
+        }
+
+        std::sort(states.begin(), states.end());
+    }
+
+    [[nodiscard]] constexpr bool contains_accept(const std::vector<size_type>& states) const {
+        for (auto s : states) {
+            if (nfa_states_[s].kind == nfa_state::type::accept) {
+                return true;
             }
         }
+        return false;
     }
 
-    void build_dfa() {
+    constexpr void build_dfa() {
         states_.clear();
+        start_word_ = 0;
 
         if (nfa_states_.empty()) {
             return;
         }
 
-        // Map from NFA state sets to DFA states
-        std::unordered_map<std::string, size_type> state_map;
+        // Map from (NFA state set, previous byte is \w) to DFA states, as an
+        // open-addressed index over the worklist (sets are kept sorted).
+        // Assertion edges are left unexpanded in the stored set, since they
+        // depend on the byte that follows.
+        struct pending_state {
+            std::vector<size_type> nfa_set;
+            bool prev_word;
+        };
+        std::vector<pending_state> worklist;
+        std::vector<size_type> index(64, no_transition);
 
-        auto set_to_key = [](const std::unordered_set<size_type>& s) {
-            std::vector<size_type> v(s.begin(), s.end());
-            std::sort(v.begin(), v.end());
-            std::string key;
-            for (auto x : v) {
-                key += std::to_string(x) + ",";
+        auto hash_of = [](const pending_state& p) {
+            std::uint64_t h = p.prev_word ? 0x9e3779b97f4a7c15ULL : 0xcbf29ce484222325ULL;
+            for (auto x : p.nfa_set) {
+                h = (h ^ static_cast<std::uint64_t>(x)) * 0x100000001b3ULL;
             }
-            return key;
+            return static_cast<size_type>(h ^ (h >> 32));
         };
 
-        // Start with epsilon closure of NFA start state
-        std::unordered_set<size_type> start_set{nfa_start_};
-        epsilon_closure(start_set);
+        auto insert_index = [&](size_type id) {
+            const size_type mask = index.size() - 1;
+            size_type slot = hash_of(worklist[id]) & mask;
+            while (index[slot] != no_transition) {
+                slot = (slot + 1) & mask;
+            }
+            index[slot] = id;
+        };
 
-        std::vector<std::unordered_set<size_type>> worklist;
-        worklist.push_back(start_set);
-        state_map[set_to_key(start_set)] = 0;
+        auto intern = [&](std::vector<size_type> nfa_set, bool prev_word) {
+            pending_state key{std::move(nfa_set), prev_word};
+            const size_type mask = index.size() - 1;
+            for (size_type slot = hash_of(key) & mask;; slot = (slot + 1) & mask) {
+                size_type id = index[slot];
+                if (id == no_transition) {
+                    break;
+                }
+                if (worklist[id].prev_word == prev_word && worklist[id].nfa_set == key.nfa_set) {
+                    return id;
+                }
+            }
 
-        states_.push_back(dfa_state{});
+            size_type id = states_.size();
+            states_.push_back(dfa_state{});
+            worklist.push_back(std::move(key));
 
-        // Check if start is accepting
-        for (auto s : start_set) {
-            if (s < nfa_states_.size() && nfa_states_[s].kind == nfa_state::type::accept) {
-                states_[0].is_accept = true;
-                break;
+            if (worklist.size() * 2 > index.size()) {
+                index.assign(index.size() * 2, no_transition);
+                for (size_type k = 0; k < worklist.size(); ++k) {
+                    insert_index(k);
+                }
+            } else {
+                insert_index(id);
             }
+            return id;
+        };
+
+        // Start with epsilon closure of NFA start state; without assertions
+        // the previous byte never matters and both starts coincide
+        std::vector<size_type> start_set{nfa_start_};
+        epsilon_closure(start_set);
+
+        intern(start_set, false);
+        if (has_assertions_) {
+            start_word_ = intern(start_set, true);
         }
 
         size_type processed = 0;
@@ -652,15 +1117,26 @@ private:
             }
 
             // Copy to avoid reference invalidation when worklist grows
-            std::unordered_set<size_type> current = worklist[processed];
-            size_type current_dfa = state_map[set_to_key(current)];
+            pending_state current = worklist[processed];
+            size_type current_dfa = processed;
             ++processed;
 
+            // Sets seen by a following \W byte (or end of text) and \w byte
+            std::array<std::vector<size_type>, 2> expanded{current.nfa_set, current.nfa_set};
+            if (has_assertions_) {
+                boundary_closure(expanded[0], current.prev_word);
+                boundary_closure(expanded[1], !current.prev_word);
+            }
+
+            states_[current_dfa].is_accept = contains_accept(expanded[0]);
+            states_[current_dfa].is_accept_word = contains_accept(expanded[1]);
+
             // For each possible input character
             for (size_type c = 0; c < config::ascii_size; ++c) {
-                std::unordered_set<size_type> next_set;
+                bool is_word = word_.test(static_cast<char>(c));
+                std::vector<size_type> next_set;
 
-                for (auto s : current) {
+                for (auto s : expanded[is_word ? 1 : 0]) {
                     if (s >= nfa_states_.size()) continue;
 
                     const auto& state = nfa_states_[s];
@@ -673,7 +1149,7 @@ private:
                     }
 
                     if (matches && state.has_next1()) {
-                        next_set.insert(state.next1);
+                        next_set.push_back(state.next1);
                     }
                 }
 
@@ -682,31 +1158,582 @@ private:
                 }
 
                 epsilon_closure(next_set);
-                std::string key = set_to_key(next_set);
-
-                size_type next_dfa;
-                auto it = state_map.find(key);
-                if (it == state_map.end()) {
-                    next_dfa = states_.size();
-                    state_map[key] = next_dfa;
-                    states_.push_back(dfa_state{});
-                    worklist.push_back(next_set);
-
-                    // Check if accepting
-                    for (auto s : next_set) {
-                        if (s < nfa_states_.size() &&
-                            nfa_states_[s].kind == nfa_state::type::accept) {
-                            states_[next_dfa].is_accept = true;
-                            break;
-                        }
+                size_type next_dfa = intern(std::move(next_set), has_assertions_ && is_word);
+
+                states_[current_dfa].transitions[c] = next_dfa;
+            }
+        }
+    }
+};
+
+// =============================================================================
+// Compiled DFA
+// =============================================================================
+
+/**
+ * @brief Regex DFA searched through the packed layout
+ *
+ * Either owns its blob (compiled from a pattern) or views a serialized
+ * blob in caller memory, e.g. an mmapped rule pack.
+ */
+class compiled_dfa {
+public:
+    compiled_dfa() = default;
+
+    /**
+     * @brief Compile a regex pattern into DFA
+     * @throws std::runtime_error if pattern is invalid or too complex
+     */
+    explicit compiled_dfa(std::string_view pattern)
+        : storage_(dfa_builder(pattern).pack(pattern))
+    {
+        bind(reinterpret_cast<const std::byte*>(storage_.data()));
+    }
+
+    /**
+     * @brief Use a serialized DFA in place, without copying or parsing
+     *
+     * The blob must be 8-byte aligned (mmapped files and serialize()
+     * output are) and outlive the returned DFA. Only the header is
+     * checked; the tables are trusted to come from serialize().
+     *
+     * @throws std::runtime_error if the header is invalid, from another
+     *         format version, or was written with a different byte order
+     */
+    [[nodiscard]] static compiled_dfa view(std::span<const std::byte> blob) {
+        validate(blob);
+        compiled_dfa dfa;
+        dfa.bind(blob.data());
+        return dfa;
+    }
+
+    /**
+     * @brief Size of the serialized blob at the start of a buffer
+     * @throws std::runtime_error if the header is invalid
+     */
+    [[nodiscard]] static size_type blob_size(std::span<const std::byte> blob) {
+        return static_cast<size_type>(validate(blob).total_size);
+    }
+
+    compiled_dfa(const compiled_dfa& other)
+        : storage_(other.storage_)
+    {
+        bind(storage_.empty() ? other.blob_ : reinterpret_cast<const std::byte*>(storage_.data()));
+    }
+
+    compiled_dfa(compiled_dfa&& other) noexcept
+        : storage_(std::move(other.storage_))
+    {
+        bind(storage_.empty() ? other.blob_ : reinterpret_cast<const std::byte*>(storage_.data()));
+        other.bind(nullptr);
+    }
+
+    compiled_dfa& operator=(compiled_dfa other) noexcept {
+        storage_ = std::move(other.storage_);
+        bind(storage_.empty() ? other.blob_ : reinterpret_cast<const std::byte*>(storage_.data()));
+        other.bind(nullptr);
+        return *this;
+    }
+
+    ~compiled_dfa() = default;
+
+    /**
+     * @brief Check if pattern matches anywhere in text
+     *
+     * Only matches inside [from, to) are reported. The bytes just outside
+     * the window still decide \b and \B.
+     * @return Position of first match, or nullopt if not found
+     */
+    [[nodiscard]] std::optional<size_type> search(
+        std::string_view text,
+        size_type from = 0,
+        size_type to = std::string_view::npos
+    ) const noexcept {
+        if (state_count_ == 0) {
+            return std::nullopt;
+        }
+
+        const std::string_view window = text.substr(0, to);
+        for (size_type start = from; start < window.size(); ++start) {
+            size_type state = start_state(text, start);
+            size_type i = start;
+
+            while (i < window.size()) {
+                if (states_[state].flags & packed_state::accelerated) {
+                    i = skip_self_loop(states_[state], window, i);
+                    if (i == window.size()) {
+                        break;
                     }
-                } else {
-                    next_dfa = it->second;
                 }
 
-                states_[current_dfa].transitions[c] = next_dfa;
+                auto c = static_cast<unsigned char>(window[i]);
+                if (accepts_before(state, c)) {
+                    return start;
+                }
+
+                // Non-ASCII bytes map to a class with only dead transitions
+                std::uint32_t next = step(state, c);
+                if (next == dead_state) {
+                    break;
+                }
+
+                if (stride_run(state, window, i, stride_entry::mid_accept,
+                               stride_entry::accel | stride_entry::accept)) {
+                    continue;
+                }
+
+                state = next;
+                ++i;
+            }
+
+            if (i == window.size() && accepts_at(state, text, i)) {
+                return start;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief End of the longest match starting at text[start]
+     * @return nullopt if no match starts there
+     */
+    [[nodiscard]] std::optional<size_type> longest_match(
+        std::string_view text,
+        size_type start
+    ) const noexcept {
+        if (state_count_ == 0) {
+            return std::nullopt;
+        }
+
+        std::optional<size_type> end;
+        size_type state = start_state(text, start);
+        size_type i = start;
+
+        while (i < text.size()) {
+            // Accelerated states never accept, so their runs hold no ends
+            if (states_[state].flags & packed_state::accelerated) {
+                i = skip_self_loop(states_[state], text, i);
+                if (i == text.size()) {
+                    break;
+                }
+            }
+
+            auto c = static_cast<unsigned char>(text[i]);
+            if (accepts_before(state, c)) {
+                end = i;
+            }
+
+            std::uint32_t next = step(state, c);
+            if (next == dead_state) {
+                return end;
+            }
+            state = next;
+            ++i;
+        }
+
+        if (states_[state].flags & packed_state::accept) {
+            end = text.size();
+        }
+        return end;
+    }
+
+    /**
+     * @brief Whether search() would report a match starting at text[start]
+     *
+     * The scan reads text[start - 1] (for \b) and text[start...] until a
+     * match ends or the DFA dies. If it is still undecided at the end of
+     * text, the result is nullopt unless text is complete, in which case
+     * the end of text decides it.
+     */
+    [[nodiscard]] std::optional<bool> match_at(
+        std::string_view text,
+        size_type start,
+        bool complete
+    ) const noexcept {
+        if (state_count_ == 0) {
+            return false;
+        }
+
+        size_type state = start_state(text, start);
+        size_type i = start;
+        while (i < text.size()) {
+            if (states_[state].flags & packed_state::accelerated) {
+                i = skip_self_loop(states_[state], text, i);
+                if (i == text.size()) {
+                    break;
+                }
+            }
+
+            auto c = static_cast<unsigned char>(text[i]);
+            if (accepts_before(state, c)) {
+                return true;
+            }
+            std::uint32_t next = step(state, c);
+            if (next == dead_state) {
+                return false;
+            }
+            state = next;
+            ++i;
+        }
+
+        if (!complete) {
+            return std::nullopt;
+        }
+        return accepts_at(state, text, i);
+    }
+
+    /**
+     * @brief Earliest start whose scan is still undecided at the end of text
+     *
+     * Walks back from the end of text with the set of states from which a
+     * scan survives to it, and stops once the set is empty. Every start
+     * before the result is decided by text alone, so appending to text
+     * cannot change it. Returns text.size() if no scan reaches the end.
+     * O(bytes walked * states).
+     */
+    [[nodiscard]] size_type resync_start(std::string_view text) const {
+        if (state_count_ == 0) {
+            return text.size();
+        }
+
+        const size_type words = (state_count_ + 63) / 64;
+        std::vector<std::uint64_t> live(words, ~std::uint64_t{0});
+        std::vector<std::uint64_t> prev(words);
+        if (state_count_ % 64 != 0) {
+            live.back() = (std::uint64_t{1} << (state_count_ % 64)) - 1;
+        }
+        auto test = [](const std::vector<std::uint64_t>& set, size_type s) {
+            return (set[s / 64] >> (s % 64)) & 1;
+        };
+
+        size_type result = text.size();
+        for (size_type j = text.size(); j-- > 0;) {
+            const auto c = static_cast<unsigned char>(text[j]);
+            std::fill(prev.begin(), prev.end(), 0);
+            bool any = false;
+            for (size_type s = 0; s < state_count_; ++s) {
+                if (accepts_before(s, c)) {
+                    continue;
+                }
+                const std::uint32_t next = step(s, c);
+                if (next != dead_state && test(live, next)) {
+                    prev[s / 64] |= std::uint64_t{1} << (s % 64);
+                    any = true;
+                }
+            }
+            if (!any) {
+                break;
+            }
+            live.swap(prev);
+            if (test(live, start_state(text, j))) {
+                result = j;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Check if pattern matches the entire text
+     */
+    [[nodiscard]] bool matches(std::string_view text) const noexcept {
+        if (state_count_ == 0) {
+            return false;
+        }
+
+        size_type state = 0;
+        size_type i = 0;
+
+        while (i < text.size()) {
+            if (states_[state].flags & packed_state::accelerated) {
+                i = skip_self_loop(states_[state], text, i);
+                if (i == text.size()) {
+                    break;
+                }
+            }
+
+            if (stride_run(state, text, i, 0, stride_entry::accel)) {
+                continue;
+            }
+
+            std::uint32_t next = step(state, static_cast<unsigned char>(text[i]));
+            if (next == dead_state) {
+                return false;
+            }
+            state = next;
+            ++i;
+        }
+
+        return (states_[state].flags & packed_state::accept) != 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return state_count_ == 0;
+    }
+
+    [[nodiscard]] size_type state_count() const noexcept {
+        return state_count_;
+    }
+
+    /**
+     * @brief Number of byte equivalence classes (ASCII classes + non-ASCII)
+     */
+    [[nodiscard]] size_type byte_class_count() const noexcept {
+        return class_count_;
+    }
+
+    /**
+     * @brief Whether the two-byte transition table fit in its memory budget
+     */
+    [[nodiscard]] bool has_stride_table() const noexcept {
+        return stride_ != nullptr;
+    }
+
+    /**
+     * @brief Pattern source stored alongside the tables
+     */
+    [[nodiscard]] std::string_view source() const noexcept {
+        return source_;
+    }
+
+    /**
+     * @brief Whether the tables live in caller memory (see view())
+     */
+    [[nodiscard]] bool is_view() const noexcept {
+        return blob_ != nullptr && storage_.empty();
+    }
+
+    /**
+     * @brief Packed blob bytes; empty for a default-constructed DFA
+     */
+    [[nodiscard]] std::span<const std::byte> blob() const noexcept {
+        if (!blob_) {
+            return {};
+        }
+        return {blob_, static_cast<size_type>(header().total_size)};
+    }
+
+    /**
+     * @brief Copy the packed blob into a new buffer (see view())
+     */
+    [[nodiscard]] std::vector<std::byte> serialize() const {
+        auto bytes = blob();
+        return {bytes.begin(), bytes.end()};
+    }
+
+private:
+    std::vector<std::uint64_t> storage_;  // owned blob; empty for views
+    const std::byte* blob_ = nullptr;
+
+    const std::uint8_t* byte_class_ = nullptr;
+    const packed_state* states_ = nullptr;
+    const std::uint32_t* transitions_ = nullptr;  // [state][class]
+    const std::uint32_t* stride_ = nullptr;       // [state][class][class]
+    std::string_view source_;
+
+    size_type state_count_ = 0;
+    size_type class_count_ = 0;
+    size_type start_word_ = 0;
+    bool has_assertions_ = false;
+    char_class word_ = char_class::word();
+
+    [[nodiscard]] const dfa_blob_header& header() const noexcept {
+        return *reinterpret_cast<const dfa_blob_header*>(blob_);
+    }
+
+    static dfa_blob_header validate(std::span<const std::byte> blob) {
+        if (blob.size() < sizeof(dfa_blob_header)) {
+            throw std::runtime_error("DFA blob too small");
+        }
+        if (reinterpret_cast<std::uintptr_t>(blob.data()) % alignof(std::uint64_t) != 0) {
+            throw std::runtime_error("DFA blob must be 8-byte aligned");
+        }
+
+        dfa_blob_header h;
+        std::memcpy(&h, blob.data(), sizeof(h));
+
+        if (h.magic != dfa_blob_header::expected_magic) {
+            throw std::runtime_error("Not a DFA blob");
+        }
+        if (h.endian_tag == dfa_blob_header::swapped_endian_tag) {
+            throw std::runtime_error("DFA blob was written with a different byte order");
+        }
+        if (h.endian_tag != dfa_blob_header::native_endian_tag) {
+            throw std::runtime_error("Corrupt DFA blob header");
+        }
+        if (h.version != dfa_blob_header::current_version) {
+            throw std::runtime_error("Unsupported DFA blob version");
+        }
+
+        const bool has_stride = (h.flags & dfa_blob_header::flag_stride) != 0;
+        const auto layout = dfa_blob_layout::compute(
+            h.state_count, h.class_count, has_stride, h.source_size);
+        if (h.state_count == 0 || h.class_count == 0 || h.class_count > 256 ||
+            h.start_word >= h.state_count || h.total_size != layout.total) {
+            throw std::runtime_error("Corrupt DFA blob header");
+        }
+        if (blob.size() < layout.total) {
+            throw std::runtime_error("DFA blob truncated");
+        }
+        return h;
+    }
+
+    void bind(const std::byte* blob) noexcept {
+        blob_ = blob;
+        if (!blob) {
+            byte_class_ = nullptr;
+            states_ = nullptr;
+            transitions_ = nullptr;
+            stride_ = nullptr;
+            source_ = {};
+            state_count_ = class_count_ = start_word_ = 0;
+            has_assertions_ = false;
+            return;
+        }
+
+        const auto& h = header();
+        const bool has_stride = (h.flags & dfa_blob_header::flag_stride) != 0;
+        const auto layout = dfa_blob_layout::compute(
+            h.state_count, h.class_count, has_stride, h.source_size);
+
+        byte_class_ = reinterpret_cast<const std::uint8_t*>(blob + layout.byte_class);
+        states_ = reinterpret_cast<const packed_state*>(blob + layout.states);
+        transitions_ = reinterpret_cast<const std::uint32_t*>(blob + layout.transitions);
+        stride_ = has_stride ? reinterpret_cast<const std::uint32_t*>(blob + layout.stride) : nullptr;
+        source_ = {reinterpret_cast<const char*>(blob + layout.source), h.source_size};
+        state_count_ = h.state_count;
+        class_count_ = h.class_count;
+        start_word_ = h.start_word;
+        has_assertions_ = (h.flags & dfa_blob_header::flag_assertions) != 0;
+    }
+
+    [[nodiscard]] std::uint32_t step(size_type state, unsigned char c) const noexcept {
+        return transitions_[state * class_count_ + byte_class_[c]];
+    }
+
+    /**
+     * @brief Take two-byte steps from text[pos] while the table allows
+     *
+     * Pairs flagged in block_flags are not taken; the run ends after
+     * landing on a target flagged in stop_flags.
+     * @return true if at least one step was taken (state and pos updated)
+     */
+    bool stride_run(
+        size_type& state,
+        std::string_view text,
+        size_type& pos,
+        std::uint32_t block_flags,
+        std::uint32_t stop_flags
+    ) const noexcept {
+        if (!stride_) {
+            return false;
+        }
+
+        const size_type row_size = class_count_ * class_count_;
+        std::uint32_t row = static_cast<std::uint32_t>(state * row_size);
+        size_type i = pos;
+
+        while (i + 1 < text.size()) {
+            size_type pair = byte_class_[static_cast<unsigned char>(text[i])] * class_count_ +
+                             byte_class_[static_cast<unsigned char>(text[i + 1])];
+            std::uint32_t entry = stride_[row + pair];
+            if (entry & (block_flags | stride_entry::blocked)) {
+                break;
+            }
+            row = entry & stride_entry::row_mask;
+            i += 2;
+            if (entry & stop_flags) {
+                break;
+            }
+        }
+
+        if (i == pos) {
+            return false;
+        }
+        state = row / row_size;
+        pos = i;
+        return true;
+    }
+
+    [[nodiscard]] size_type start_state(std::string_view text, size_type pos) const noexcept {
+        return (has_assertions_ && pos > 0 && word_.test(text[pos - 1])) ? start_word_ : 0;
+    }
+
+    // Whether a match ends at the current position, given the next byte
+    [[nodiscard]] bool accepts_before(size_type state, unsigned char next) const noexcept {
+        auto flags = states_[state].flags;
+        if (has_assertions_ && word_.test(static_cast<char>(next))) {
+            return (flags & packed_state::accept_word) != 0;
+        }
+        return (flags & packed_state::accept) != 0;
+    }
+
+    // Whether a match ends at text[pos] (pos may be the end of the text)
+    [[nodiscard]] bool accepts_at(size_type state, std::string_view text, size_type pos) const noexcept {
+        if (pos < text.size()) {
+            return accepts_before(state, static_cast<unsigned char>(text[pos]));
+        }
+        return (states_[state].flags & packed_state::accept) != 0;
+    }
+
+    /**
+     * @brief Skip a self-loop run of an accelerated state
+     * @return Position of the next escape or non-ASCII byte, or text.size()
+     */
+    [[nodiscard]] static size_type skip_self_loop(
+        const packed_state& s,
+        std::string_view text,
+        size_type pos
+    ) noexcept {
+        const char* first = text.data() + pos;
+        const size_type len = text.size() - pos;
+        const char* hit = nullptr;
+
+        if (len >= config::simd_threshold) {
+            #if KMP_HAS_AVX512
+            if (simd::has_avx512()) {
+                hit = simd::find_first_of_avx512(
+                    first, len, s.escapes.data(), s.escape_count, true);
+            } else
+            #endif
+            #if KMP_HAS_AVX2
+            if (simd::has_avx2()) {
+                hit = simd::find_first_of_avx2(
+                    first, len, s.escapes.data(), s.escape_count, true);
+            } else
+            #endif
+            #if KMP_HAS_SSE42
+            if (simd::has_sse42()) {
+                hit = simd::find_first_of_sse42(
+                    first, len, s.escapes.data(), s.escape_count, true);
+            } else
+            #endif
+            {
+                hit = find_escape_scalar(s, first, len);
+            }
+        } else {
+            hit = find_escape_scalar(s, first, len);
+        }
+
+        return hit ? static_cast<size_type>(hit - text.data()) : text.size();
+    }
+
+    [[nodiscard]] static const char* find_escape_scalar(
+        const packed_state& s,
+        const char* first,
+        size_type len
+    ) noexcept {
+        for (const char* p = first; p != first + len; ++p) {
+            if (static_cast<unsigned char>(*p) >= config::ascii_size) {
+                return p;
+            }
+            for (size_type k = 0; k < s.escape_count; ++k) {
+                if (*p == s.escapes[k]) {
+                    return p;
+                }
             }
         }
+        return nullptr;
     }
 };
 
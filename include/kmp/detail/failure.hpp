@@ -16,6 +16,7 @@
 #include <array>
 #include <vector>
 #include <span>
+#include <string_view>
 #include <concepts>
 #include <iterator>
 
@@ -24,7 +25,7 @@ namespace kmp::detail {
 /**
  * @brief Compute failure function for a pattern
  *
- * @tparam Iter Forward iterator type
+ * @tparam Iter Random access iterator type
  * @param first Iterator to pattern begin
  * @param last Iterator to pattern end
  * @return std::vector<size_type> Failure table
@@ -37,11 +38,11 @@ namespace kmp::detail {
  *   Char:   A  B  A  B  A  C
  *   Fail:   0  0  1  2  3  0
  */
-template <std::forward_iterator Iter>
+template <std::random_access_iterator Iter>
 [[nodiscard]] constexpr auto compute_failure(Iter first, Iter last)
     -> std::vector<size_type>
 {
-    const auto m = static_cast<size_type>(std::distance(first, last));
+    const auto m = static_cast<size_type>(last - first);
     if (m == 0) {
         return {};
     }
@@ -52,15 +53,15 @@ template <std::forward_iterator Iter>
     size_type k = 0;
 
     for (size_type i = 1; i < m; ++i) {
-        auto pattern_i = std::next(first, static_cast<diff_type>(i));
+        const auto& pattern_i = first[static_cast<diff_type>(i)];
 
         // Fall back until we find a match or k becomes 0
-        while (k > 0 && *pattern_i != *std::next(first, static_cast<diff_type>(k))) {
+        while (k > 0 && pattern_i != first[static_cast<diff_type>(k)]) {
             k = failure[k - 1];
         }
 
         // If we found a match, extend the prefix
-        if (*pattern_i == *std::next(first, static_cast<diff_type>(k))) {
+        if (pattern_i == first[static_cast<diff_type>(k)]) {
             ++k;
         }
 
@@ -70,6 +71,60 @@ template <std::forward_iterator Iter>
     return failure;
 }
 
+/**
+ * @brief Failure function for patterns without random access
+ *
+ * The fallback loop jumps to pattern[k]; walking there would cost O(k)
+ * per jump, so the pattern is copied into a contiguous buffer once.
+ */
+template <std::forward_iterator Iter>
+[[nodiscard]] constexpr auto compute_failure(Iter first, Iter last)
+    -> std::vector<size_type>
+{
+    const std::vector<std::iter_value_t<Iter>> buffer(first, last);
+    return compute_failure(buffer.begin(), buffer.end());
+}
+
+/**
+ * @brief Compute the failure function into caller storage
+ *
+ * Writes pattern.size() entries of type T (which must hold values up to
+ * pattern.size() - 1). Used for compact tables in pattern storage.
+ */
+template <typename T>
+constexpr void compute_failure_into(std::string_view pattern, T* out) noexcept {
+    const size_type m = pattern.size();
+    if (m == 0) {
+        return;
+    }
+
+    out[0] = 0;
+    size_type k = 0;
+
+    for (size_type i = 1; i < m; ++i) {
+        while (k > 0 && pattern[i] != pattern[k]) {
+            k = out[k - 1];
+        }
+        if (pattern[i] == pattern[k]) {
+            ++k;
+        }
+        out[i] = static_cast<T>(k);
+    }
+}
+
+/**
+ * @brief Failure function of the reversed pattern
+ *
+ * Drives right-to-left KMP (search_last): entry i describes the suffix
+ * pattern[m-1-i..m) read backwards.
+ */
+template <std::bidirectional_iterator Iter>
+[[nodiscard]] constexpr auto compute_reverse_failure(Iter first, Iter last)
+    -> std::vector<size_type>
+{
+    return compute_failure(std::make_reverse_iterator(last), std::make_reverse_iterator(first));
+}
+
 /**
  * @brief Optimized failure function with "nextval" optimization
  *
@@ -79,11 +134,11 @@ template <std::forward_iterator Iter>
  * Reference: "Performance Comparison of Different Code Implementations
  *            of the KMP Algorithm" (2024)
  */
-template <std::forward_iterator Iter>
+template <std::random_access_iterator Iter>
 [[nodiscard]] constexpr auto compute_failure_optimized(Iter first, Iter last)
     -> std::vector<size_type>
 {
-    const auto m = static_cast<size_type>(std::distance(first, last));
+    const auto m = static_cast<size_type>(last - first);
     if (m == 0) {
         return {};
     }
@@ -92,21 +147,19 @@ template <std::forward_iterator Iter>
     size_type k = 0;
 
     for (size_type i = 1; i < m; ++i) {
-        auto pattern_i = std::next(first, static_cast<diff_type>(i));
+        const auto& pattern_i = first[static_cast<diff_type>(i)];
 
-        while (k > 0 && *pattern_i != *std::next(first, static_cast<diff_type>(k))) {
+        while (k > 0 && pattern_i != first[static_cast<diff_type>(k)]) {
             k = failure[k - 1];
         }
 
-        if (*pattern_i == *std::next(first, static_cast<diff_type>(k))) {
+        if (pattern_i == first[static_cast<diff_type>(k)]) {
             ++k;
         }
 
         // Optimization: if pattern[i] == pattern[k], skip ahead
         if (k > 0 && i + 1 < m) {
-            auto next_pattern = std::next(first, static_cast<diff_type>(i + 1));
-            auto next_k = std::next(first, static_cast<diff_type>(k));
-            if (*next_pattern == *next_k) {
+            if (first[static_cast<diff_type>(i + 1)] == first[static_cast<diff_type>(k)]) {
                 failure[i] = failure[k - 1];
                 continue;
             }
@@ -118,6 +171,17 @@ template <std::forward_iterator Iter>
     return failure;
 }
 
+/**
+ * @brief Optimized failure function for patterns without random access
+ */
+template <std::forward_iterator Iter>
+[[nodiscard]] constexpr auto compute_failure_optimized(Iter first, Iter last)
+    -> std::vector<size_type>
+{
+    const std::vector<std::iter_value_t<Iter>> buffer(first, last);
+    return compute_failure_optimized(buffer.begin(), buffer.end());
+}
+
 /**
  * @brief Compile-time failure function for fixed patterns
  *
@@ -0,0 +1,180 @@
+#pragma once
+
+/**
+ * @file literal.hpp
+ * @brief Compact storage layout for precompiled literal patterns
+ *
+ * A compiled literal is one block: the pattern bytes followed by its
+ * failure table, stored 1, 2 or 4 bytes per entry depending on pattern
+ * length. The block is written once and only read afterwards, so it can
+ * live inline in a pattern object, on the heap, or in a caller arena.
+ */
+
+#include "../config.hpp"
+#include "failure.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace kmp::detail {
+
+// =============================================================================
+// Compact Failure Table
+// =============================================================================
+
+/**
+ * @brief Read-only view of a failure table with narrow entries
+ *
+ * Indexing widens entries to size_type, so it can be passed anywhere a
+ * std::vector<size_type> failure table is read (scalar and SIMD kernels).
+ */
+class failure_table {
+public:
+    constexpr failure_table() = default;
+
+    failure_table(const std::byte* data, size_type size, std::uint8_t width) noexcept
+        : data_(data)
+        , size_(static_cast<std::uint32_t>(size))
+        , width_(width)
+    {}
+
+    [[nodiscard]] size_type operator[](size_type i) const noexcept {
+        switch (width_) {
+            case 1: return reinterpret_cast<const std::uint8_t*>(data_)[i];
+            case 2: return reinterpret_cast<const std::uint16_t*>(data_)[i];
+            default: return reinterpret_cast<const std::uint32_t*>(data_)[i];
+        }
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    // Bytes per entry (1, 2 or 4)
+    [[nodiscard]] size_type width() const noexcept { return width_; }
+    [[nodiscard]] const std::byte* data() const noexcept { return data_; }
+
+private:
+    const std::byte* data_ = nullptr;
+    std::uint32_t size_ = 0;
+    std::uint8_t width_ = 1;
+};
+
+// =============================================================================
+// Block Layout
+// =============================================================================
+
+/**
+ * @brief Offsets within a compiled literal block
+ */
+struct literal_layout {
+    // Longest literal the 32-bit size field can describe
+    static constexpr size_type max_size = 0xFFFFFFFFu;
+
+    std::uint8_t width;        // failure entry width
+    size_type failure_offset;  // after the pattern, aligned to width
+    size_type total;
+
+    [[nodiscard]] static constexpr literal_layout compute(size_type m) noexcept {
+        // Entries are at most m - 1
+        const std::uint8_t w = m <= 0x100 ? 1 : (m <= 0x10000 ? 2 : 4);
+        const size_type failure_offset = (m + w - 1) / w * w;
+        return {w, failure_offset, failure_offset + m * w};
+    }
+
+    // Size rounded up so the next block in an arena stays 4-byte aligned
+    [[nodiscard]] constexpr size_type padded_total() const noexcept {
+        return (total + 3) & ~size_type{3};
+    }
+};
+
+/**
+ * @brief Write pattern bytes and failure table into a block
+ *
+ * The block must hold literal_layout::compute(pattern.size()).padded_total()
+ * bytes and be aligned to 4 bytes. Padding is zeroed, so equal inputs give
+ * byte-identical blocks.
+ */
+inline failure_table write_literal(std::string_view pattern, std::byte* block) noexcept {
+    const auto layout = literal_layout::compute(pattern.size());
+    for (size_type i = 0; i < pattern.size(); ++i) {
+        block[i] = static_cast<std::byte>(pattern[i]);
+    }
+    for (size_type i = pattern.size(); i < layout.failure_offset; ++i) {
+        block[i] = std::byte{0};
+    }
+    for (size_type i = layout.total; i < layout.padded_total(); ++i) {
+        block[i] = std::byte{0};
+    }
+
+    std::byte* failure = block + layout.failure_offset;
+    switch (layout.width) {
+        case 1:
+            compute_failure_into(pattern, reinterpret_cast<std::uint8_t*>(failure));
+            break;
+        case 2:
+            compute_failure_into(pattern, reinterpret_cast<std::uint16_t*>(failure));
+            break;
+        default:
+            compute_failure_into(pattern, reinterpret_cast<std::uint32_t*>(failure));
+            break;
+    }
+    return {failure, pattern.size(), layout.width};
+}
+
+// =============================================================================
+// SIMD Anchor Selection
+// =============================================================================
+
+/**
+ * @brief Rough frequency rank of each byte in typical text (higher = commoner)
+ *
+ * Only the ordering matters: it picks which pattern byte the SIMD scan
+ * checks alongside the first one.
+ */
+inline constexpr std::array<std::uint8_t, 256> byte_ranks = [] {
+    std::array<std::uint8_t, 256> ranks{};
+    for (size_type c = 0; c < ranks.size(); ++c) {
+        ranks[c] = c < 0x80 ? 80 : 40;
+    }
+    for (char c : std::string_view("\n,.-_/")) {
+        ranks[static_cast<unsigned char>(c)] = 160;
+    }
+    for (size_type c = '0'; c <= '9'; ++c) {
+        ranks[c] = 150;
+    }
+    constexpr std::string_view by_frequency = " etaoinshrdlcumwfgypbvkjxqz";
+    for (size_type i = 0; i < by_frequency.size(); ++i) {
+        auto c = static_cast<unsigned char>(by_frequency[i]);
+        ranks[c] = static_cast<std::uint8_t>(255 - i);
+        if (c >= 'a') {
+            ranks[c - 'a' + 'A'] = static_cast<std::uint8_t>(120 - i);
+        }
+    }
+    return ranks;
+}();
+
+/**
+ * @brief Offset of the rarest byte after the first, or 0 if m < 2
+ *
+ * Bytes equal to pattern[0] are avoided, since they add no selectivity
+ * to the first-byte comparison.
+ */
+[[nodiscard]] constexpr size_type select_anchor(std::string_view pattern) noexcept {
+    size_type best = 0;
+    int best_rank = 0x1000;
+    for (size_type i = 1; i < pattern.size(); ++i) {
+        int rank = byte_ranks[static_cast<unsigned char>(pattern[i])];
+        if (pattern[i] == pattern[0]) {
+            rank += 0x100;
+        }
+        if (rank < best_rank) {
+            best_rank = rank;
+            best = i;
+        }
+    }
+    return best;
+}
+
+} // namespace kmp::detail
@@ -0,0 +1,253 @@
+#pragma once
+
+/**
+ * @file masked.hpp
+ * @brief Literal patterns with wildcard (don't-care) bytes
+ *
+ * A masked literal is a byte string plus a per-byte mask: text matches at
+ * p when (text[p + i] & mask[i]) == bytes[i] for every i. Mask 0xFF is an
+ * exact byte, 0x00 a wildcard, and 0xF0 / 0x0F a half-byte wildcard
+ * ("4?" / "?5" in signature syntax).
+ *
+ * The scan looks for the two rarest exact bytes with the SIMD pair search,
+ * then verifies candidates with AND-mask-and-compare vectors.
+ */
+
+#include "../config.hpp"
+#include "literal.hpp"
+#include "simd/dispatch.hpp"
+
+#if KMP_HAS_AVX512
+    #include "simd/avx512.hpp"
+#endif
+#if KMP_HAS_AVX2
+    #include "simd/avx2.hpp"
+#endif
+#if KMP_HAS_SSE42
+    #include "simd/sse42.hpp"
+#endif
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace kmp::detail {
+
+// =============================================================================
+// Signature Parsing
+// =============================================================================
+
+/**
+ * @brief Value of a hex digit, or -1
+ */
+[[nodiscard]] constexpr int hex_digit(char c) noexcept {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Parse a hex signature such as "48 8B ?? ?? 89 45"
+ *
+ * Tokens are separated by whitespace. Each is two hex digits, either of
+ * which may be '?' (a wildcard nibble); a lone "?" is a wildcard byte.
+ * Appends the masked bytes and the mask.
+ *
+ * @throws std::runtime_error on a malformed token
+ */
+inline void parse_signature(std::string_view signature, std::string& bytes, std::string& mask) {
+    size_type i = 0;
+    while (i < signature.size()) {
+        if (signature[i] == ' ' || signature[i] == '\t' || signature[i] == '\n') {
+            ++i;
+            continue;
+        }
+
+        size_type end = i;
+        while (end < signature.size() && signature[end] != ' ' &&
+               signature[end] != '\t' && signature[end] != '\n') {
+            ++end;
+        }
+        const std::string_view token = signature.substr(i, end - i);
+        i = end;
+
+        if (token == "?") {
+            bytes += '\0';
+            mask += '\0';
+            continue;
+        }
+        if (token.size() != 2) {
+            throw std::runtime_error("Invalid signature byte: " + std::string(token));
+        }
+
+        unsigned value = 0;
+        unsigned nibbles = 0;
+        for (char c : token) {
+            value <<= 4;
+            nibbles <<= 4;
+            if (c == '?') {
+                continue;
+            }
+            const int digit = hex_digit(c);
+            if (digit < 0) {
+                throw std::runtime_error("Invalid signature byte: " + std::string(token));
+            }
+            value |= static_cast<unsigned>(digit);
+            nibbles |= 0xF;
+        }
+        bytes += static_cast<char>(value);
+        mask += static_cast<char>(nibbles);
+    }
+}
+
+// =============================================================================
+// Anchor Selection
+// =============================================================================
+
+/**
+ * @brief Byte ranks for binary images (higher = commoner)
+ *
+ * byte_ranks with zero, 0xFF, int3 (0xCC) and nop (0x90) padding ranked
+ * commonest, since they fill executables.
+ */
+inline constexpr std::array<std::uint8_t, 256> binary_byte_ranks = [] {
+    auto ranks = byte_ranks;
+    for (unsigned c : {0x00u, 0xFFu, 0xCCu, 0x90u}) {
+        ranks[c] = 255;
+    }
+    return ranks;
+}();
+
+/**
+ * @brief Offsets of the exact bytes the SIMD scan looks for
+ *
+ * first <= second; second == first when the pattern has a single exact
+ * byte. found is false if it has none (every byte is (partly) wildcard).
+ */
+struct masked_anchors {
+    size_type first = 0;
+    size_type second = 0;
+    bool found = false;
+};
+
+/**
+ * @brief Pick the two rarest exact bytes, preferring distinct values
+ */
+[[nodiscard]] inline masked_anchors select_masked_anchors(
+    std::string_view bytes,
+    std::string_view mask
+) noexcept {
+    auto rank_of = [&](size_type i) {
+        return static_cast<int>(binary_byte_ranks[static_cast<unsigned char>(bytes[i])]);
+    };
+
+    masked_anchors anchors;
+    size_type best = 0;
+    for (size_type i = 0; i < bytes.size(); ++i) {
+        if (static_cast<unsigned char>(mask[i]) == 0xFF &&
+            (!anchors.found || rank_of(i) < rank_of(best))) {
+            best = i;
+            anchors.found = true;
+        }
+    }
+    if (!anchors.found) {
+        return anchors;
+    }
+
+    size_type other = best;
+    int other_rank = 0x1000;
+    for (size_type i = 0; i < bytes.size(); ++i) {
+        if (i == best || static_cast<unsigned char>(mask[i]) != 0xFF) {
+            continue;
+        }
+        int rank = rank_of(i);
+        if (bytes[i] == bytes[best]) {
+            rank += 0x100;
+        }
+        if (rank < other_rank) {
+            other_rank = rank;
+            other = i;
+        }
+    }
+
+    anchors.first = best < other ? best : other;
+    anchors.second = best < other ? other : best;
+    return anchors;
+}
+
+// =============================================================================
+// Matching
+// =============================================================================
+
+/**
+ * @brief Whether (a[i] & mask[i]) == bytes[i] for all i < len
+ */
+[[nodiscard]] inline bool equal_masked(
+    const char* a,
+    const char* bytes,
+    const char* mask,
+    size_type len
+) noexcept {
+    for (size_type i = 0; i < len; ++i) {
+        if ((a[i] & mask[i]) != bytes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief First match of a masked literal in text, or nullptr
+ *
+ * bytes must already be masked and non-empty.
+ */
+[[nodiscard]] inline const char* find_masked(
+    std::string_view text,
+    std::string_view bytes,
+    std::string_view mask,
+    const masked_anchors& anchors
+) noexcept {
+    const size_type n = text.size();
+    const size_type m = bytes.size();
+    if (n < m) {
+        return nullptr;
+    }
+
+    if (anchors.found && n >= config::simd_threshold) {
+        #if KMP_HAS_AVX512
+        if (detail::simd::has_avx512()) {
+            return detail::simd::find_masked_avx512(
+                text.data(), n, bytes.data(), mask.data(), m, anchors.first, anchors.second);
+        }
+        #endif
+        #if KMP_HAS_AVX2
+        if (detail::simd::has_avx2()) {
+            return detail::simd::find_masked_avx2(
+                text.data(), n, bytes.data(), mask.data(), m, anchors.first, anchors.second);
+        }
+        #endif
+        #if KMP_HAS_SSE42
+        if (detail::simd::has_sse42()) {
+            return detail::simd::find_masked_sse42(
+                text.data(), n, bytes.data(), mask.data(), m, anchors.first, anchors.second);
+        }
+        #endif
+    }
+
+    // Scalar fallback: filter on one exact byte when there is one
+    const size_type key = anchors.first;
+    for (size_type p = 0; p + m <= n; ++p) {
+        if (anchors.found && text[p + key] != bytes[key]) {
+            continue;
+        }
+        if (equal_masked(text.data() + p, bytes.data(), mask.data(), m)) {
+            return text.data() + p;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace kmp::detail
@@ -0,0 +1,207 @@
+#pragma once
+
+/**
+ * @file shift_or.hpp
+ * @brief Shift-Or (bitap) matching for literals up to 64 bytes
+ *
+ * Bit i of the state is clear while pattern[0..i] matches the text ending
+ * at the current byte; one shift, OR and table load per byte, with no
+ * data-dependent branches. On small alphabets (DNA, digits, hex) nearly
+ * every byte is a first-byte candidate and the SIMD prefilter of the KMP
+ * kernels stops paying off, while Shift-Or runs at a constant rate.
+ *
+ * The first-match scan runs four interleaved lanes over quarters of the
+ * text, so four independent state chains overlap in the pipeline.
+ */
+
+#include "../config.hpp"
+#include "literal.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace kmp::detail {
+
+/**
+ * @brief Per-byte masks of a pattern (bit i clear where pattern[i] == c)
+ */
+struct shift_or_table {
+    std::array<std::uint64_t, 256> masks;
+    std::uint64_t accept;  // bit m - 1: clear in the state at a match end
+
+    explicit shift_or_table(std::string_view pattern) noexcept
+        : accept(std::uint64_t{1} << (pattern.size() - 1))
+    {
+        masks.fill(~std::uint64_t{0});
+        for (size_type i = 0; i < pattern.size(); ++i) {
+            masks[static_cast<unsigned char>(pattern[i])] &= ~(std::uint64_t{1} << i);
+        }
+    }
+
+    [[nodiscard]] std::uint64_t step(std::uint64_t state, char c) const noexcept {
+        return (state << 1) | masks[static_cast<unsigned char>(c)];
+    }
+};
+
+/**
+ * @brief Whether Shift-Or should replace the SIMD prefilter for this search
+ *
+ * Requires 1 < m <= 64 and a text of at least config::shift_or_min_text
+ * bytes. Samples the start of the text for SIMD pair candidates (pattern[0]
+ * and pattern[anchor], or the rarest byte when anchor is 0); a candidate in
+ * more than one of config::shift_or_density bytes means verification would
+ * dominate.
+ */
+[[nodiscard]] inline bool prefer_shift_or(
+    std::string_view text,
+    std::string_view pattern,
+    size_type anchor
+) noexcept {
+    const size_type m = pattern.size();
+    if (m < 2 || m > 64 || text.size() < config::shift_or_min_text) {
+        return false;
+    }
+
+    if (anchor == 0) {
+        anchor = select_anchor(pattern);
+    }
+    const size_type sample = std::min(config::shift_or_sample, text.size() - m + 1);
+    size_type candidates = 0;
+    for (size_type i = 0; i < sample; ++i) {
+        candidates += text[i] == pattern[0] && text[i + anchor] == pattern[anchor];
+    }
+    return candidates * config::shift_or_density > sample;
+}
+
+/**
+ * @brief Single-lane scan of text[first, last) from state; returns the end
+ *        of the first match, or last
+ */
+[[nodiscard]] inline size_type shift_or_scan(
+    const shift_or_table& table,
+    std::string_view text,
+    size_type first,
+    size_type last,
+    std::uint64_t& state
+) noexcept {
+    for (size_type i = first; i < last; ++i) {
+        state = table.step(state, text[i]);
+        if (!(state & table.accept)) {
+            return i;
+        }
+    }
+    return last;
+}
+
+/**
+ * @brief Position of the first match, or text.size() if none
+ *
+ * Lane k reports match ends in [k * q, (k + 1) * q) for q = n / 4; it
+ * starts m - 1 bytes early so its state is warm. Lanes advance in lock
+ * step until one matches; the lanes before it then finish alone, since
+ * their matches come first.
+ */
+[[nodiscard]] inline size_type shift_or_find(
+    std::string_view text,
+    std::string_view pattern
+) noexcept {
+    const size_type n = text.size();
+    const size_type m = pattern.size();
+    if (n < m) {
+        return n;
+    }
+
+    const shift_or_table table(pattern);
+    const size_type q = n / 4;
+
+    // Too short to split: one lane
+    if (q < m) {
+        std::uint64_t state = ~std::uint64_t{0};
+        const size_type end = shift_or_scan(table, text, 0, n, state);
+        return end == n ? n : end + 1 - m;
+    }
+
+    // Lane k reads text[start[k] + j] for j < steps; lane 0 overruns into
+    // lane 1's range, which only repeats ends lane 1 also sees
+    const size_type steps = q + m - 1;
+    const std::array<size_type, 4> start = {0, q - (m - 1), 2 * q - (m - 1), 3 * q - (m - 1)};
+    const char* t0 = text.data() + start[0];
+    const char* t1 = text.data() + start[1];
+    const char* t2 = text.data() + start[2];
+    const char* t3 = text.data() + start[3];
+
+    std::array<std::uint64_t, 4> state;
+    state.fill(~std::uint64_t{0});
+    std::uint64_t d0 = state[0], d1 = state[1], d2 = state[2], d3 = state[3];
+
+    size_type j = 0;
+    for (; j < steps; ++j) {
+        d0 = table.step(d0, t0[j]);
+        d1 = table.step(d1, t1[j]);
+        d2 = table.step(d2, t2[j]);
+        d3 = table.step(d3, t3[j]);
+        if (!(d0 & d1 & d2 & d3 & table.accept)) {
+            break;
+        }
+    }
+    state = {d0, d1, d2, d3};
+
+    if (j == steps) {
+        // No lane matched; the last lane continues over the remainder
+        const size_type end = shift_or_scan(table, text, start[3] + steps, n, state[3]);
+        return end == n ? n : end + 1 - m;
+    }
+
+    // The first lane that matched at step j; earlier lanes may still match
+    // further on in their own ranges
+    size_type hit = 0;
+    while (state[hit] & table.accept) {
+        ++hit;
+    }
+    for (size_type k = 0; k < hit; ++k) {
+        const size_type last = start[k] + steps;
+        const size_type end = shift_or_scan(table, text, start[k] + j + 1, last, state[k]);
+        if (end != last) {
+            return end + 1 - m;
+        }
+    }
+    return start[hit] + j + 1 - m;
+}
+
+/**
+ * @brief Write match positions to out, stopping after max_matches
+ *
+ * With non_overlapping the state is reset after each match, so the next
+ * match starts after it.
+ */
+template <typename OutputIt>
+OutputIt shift_or_find_all(
+    std::string_view text,
+    std::string_view pattern,
+    OutputIt out,
+    bool non_overlapping,
+    size_type max_matches
+) {
+    const size_type n = text.size();
+    const size_type m = pattern.size();
+    const shift_or_table table(pattern);
+
+    std::uint64_t state = ~std::uint64_t{0};
+    size_type pos = 0;
+    for (size_type found = 0; found < max_matches; ++found) {
+        const size_type end = shift_or_scan(table, text, pos, n, state);
+        if (end == n) {
+            break;
+        }
+        *out++ = end + 1 - m;
+        pos = end + 1;
+        if (non_overlapping) {
+            state = ~std::uint64_t{0};
+        }
+    }
+    return out;
+}
+
+} // namespace kmp::detail
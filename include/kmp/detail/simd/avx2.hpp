@@ -13,6 +13,8 @@
 #if KMP_HAS_AVX2 || defined(_MSC_VER)
 
 #include <immintrin.h>
+#include <bit>
+#include <cstdint>
 #include <cstring>
 
 namespace kmp::detail::simd {
@@ -83,6 +85,67 @@ KMP_FORCE_INLINE const char* find_first_char_avx2(
     return nullptr;
 }
 
+/**
+ * @brief Find first byte from a small set (1-3 bytes) using AVX2
+ *
+ * With stop_at_non_ascii, any byte >= 0x80 also ends the scan. Used by
+ * the DFA to skip over self-loop runs.
+ */
+KMP_FORCE_INLINE const char* find_first_of_avx2(
+    const char* haystack,
+    size_type haystack_len,
+    const char* set,
+    size_type set_size,
+    bool stop_at_non_ascii = false
+) noexcept {
+    if (haystack_len == 0 || set_size == 0) {
+        return nullptr;
+    }
+
+    // Unused slots repeat the first byte
+    const char c0 = set[0];
+    const char c1 = set[set_size > 1 ? 1 : 0];
+    const char c2 = set[set_size > 2 ? 2 : 0];
+    const __m256i n0 = _mm256_set1_epi8(c0);
+    const __m256i n1 = _mm256_set1_epi8(c1);
+    const __m256i n2 = _mm256_set1_epi8(c2);
+    const int high_mask = stop_at_non_ascii ? -1 : 0;
+
+    const char* ptr = haystack;
+    const char* end = haystack + haystack_len;
+
+    while (ptr + 32 <= end) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        __m256i hit = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, n0), _mm256_cmpeq_epi8(chunk, n1)),
+            _mm256_cmpeq_epi8(chunk, n2));
+        int mask = _mm256_movemask_epi8(hit) | (_mm256_movemask_epi8(chunk) & high_mask);
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                _BitScanForward(&idx, static_cast<unsigned long>(mask));
+                return ptr + idx;
+            #else
+                return ptr + __builtin_ctz(static_cast<unsigned>(mask));
+            #endif
+        }
+        ptr += 32;
+    }
+
+    // Scalar fallback for remaining bytes
+    while (ptr < end) {
+        char c = *ptr;
+        if (c == c0 || c == c1 || c == c2 ||
+            (stop_at_non_ascii && static_cast<unsigned char>(c) >= 0x80)) {
+            return ptr;
+        }
+        ++ptr;
+    }
+
+    return nullptr;
+}
+
 /**
  * @brief Compare two strings using AVX2 for quick mismatch detection
  *
@@ -126,16 +189,231 @@ KMP_FORCE_INLINE size_type compare_avx2(
     return len;
 }
 
+/**
+ * @brief Find first position where two anchor bytes both match using AVX2
+ *
+ * Returns the first p < haystack_len with haystack[p] == first and
+ * haystack[p + offset] == second. The caller guarantees that
+ * haystack[haystack_len - 1 + offset] is readable. Checking a second,
+ * rarer byte cuts most false candidates of a first-byte scan.
+ */
+KMP_FORCE_INLINE const char* find_pair_avx2(
+    const char* haystack,
+    size_type haystack_len,
+    char first,
+    char second,
+    size_type offset
+) noexcept {
+    const __m256i n0 = _mm256_set1_epi8(first);
+    const __m256i n1 = _mm256_set1_epi8(second);
+
+    const char* ptr = haystack;
+    const char* end = haystack + haystack_len;
+
+    while (ptr + 32 <= end) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + offset));
+        int mask = _mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(a, n0), _mm256_cmpeq_epi8(b, n1)));
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                _BitScanForward(&idx, static_cast<unsigned long>(mask));
+                return ptr + idx;
+            #else
+                return ptr + __builtin_ctz(static_cast<unsigned>(mask));
+            #endif
+        }
+        ptr += 32;
+    }
+
+    while (ptr < end) {
+        if (*ptr == first && ptr[offset] == second) {
+            return ptr;
+        }
+        ++ptr;
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Element Width Primitives
+// =============================================================================
+
+/**
+ * @brief Broadcast an 8-, 16- or 32-bit element to every lane
+ */
+template <typename T>
+KMP_FORCE_INLINE __m256i broadcast_avx2(T value) noexcept {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_set1_epi8(std::bit_cast<char>(value));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_set1_epi16(std::bit_cast<short>(value));
+    } else {
+        return _mm256_set1_epi32(std::bit_cast<int>(value));
+    }
+}
+
+/**
+ * @brief Compare lanes of sizeof(T) bytes; one mask bit per byte
+ *
+ * An equal element sets sizeof(T) consecutive bits, so the first equal
+ * element is at countr_zero(mask) / sizeof(T).
+ */
+template <typename T>
+KMP_FORCE_INLINE unsigned eq_mask_avx2(__m256i a, __m256i b) noexcept {
+    __m256i cmp;
+    if constexpr (sizeof(T) == 1) {
+        cmp = _mm256_cmpeq_epi8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+        cmp = _mm256_cmpeq_epi16(a, b);
+    } else {
+        cmp = _mm256_cmpeq_epi32(a, b);
+    }
+    return static_cast<unsigned>(_mm256_movemask_epi8(cmp));
+}
+
+/**
+ * @brief find_first_char_avx2() for 8-, 16- and 32-bit elements
+ */
+template <typename T>
+KMP_FORCE_INLINE const T* find_first_elem_avx2(
+    const T* haystack,
+    size_type haystack_len,
+    T needle
+) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return reinterpret_cast<const T*>(find_first_char_avx2(
+            reinterpret_cast<const char*>(haystack), haystack_len,
+            std::bit_cast<char>(needle)));
+    } else {
+        constexpr size_type lanes = 32 / sizeof(T);
+        const __m256i n = broadcast_avx2(needle);
+
+        const T* ptr = haystack;
+        const T* end = haystack + haystack_len;
+
+        while (static_cast<size_type>(end - ptr) >= lanes) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+            unsigned mask = eq_mask_avx2<T>(chunk, n);
+
+            if (mask != 0) {
+                return ptr + std::countr_zero(mask) / sizeof(T);
+            }
+            ptr += lanes;
+        }
+
+        while (ptr < end) {
+            if (*ptr == needle) {
+                return ptr;
+            }
+            ++ptr;
+        }
+
+        return nullptr;
+    }
+}
+
+/**
+ * @brief find_pair_avx2() for 8-, 16- and 32-bit elements
+ */
+template <typename T>
+KMP_FORCE_INLINE const T* find_pair_elem_avx2(
+    const T* haystack,
+    size_type haystack_len,
+    T first,
+    T second,
+    size_type offset
+) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return reinterpret_cast<const T*>(find_pair_avx2(
+            reinterpret_cast<const char*>(haystack), haystack_len,
+            std::bit_cast<char>(first), std::bit_cast<char>(second), offset));
+    } else {
+        constexpr size_type lanes = 32 / sizeof(T);
+        const __m256i n0 = broadcast_avx2(first);
+        const __m256i n1 = broadcast_avx2(second);
+
+        const T* ptr = haystack;
+        const T* end = haystack + haystack_len;
+
+        while (static_cast<size_type>(end - ptr) >= lanes) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + offset));
+            unsigned mask = eq_mask_avx2<T>(a, n0) & eq_mask_avx2<T>(b, n1);
+
+            if (mask != 0) {
+                return ptr + std::countr_zero(mask) / sizeof(T);
+            }
+            ptr += lanes;
+        }
+
+        while (ptr < end) {
+            if (*ptr == first && ptr[offset] == second) {
+                return ptr;
+            }
+            ++ptr;
+        }
+
+        return nullptr;
+    }
+}
+
+/**
+ * @brief compare_avx2() for 8-, 16- and 32-bit elements
+ *
+ * Returns the index of the first mismatching element, or len if equal.
+ */
+template <typename T>
+KMP_FORCE_INLINE size_type compare_elem_avx2(
+    const T* a,
+    const T* b,
+    size_type len
+) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return compare_avx2(reinterpret_cast<const char*>(a),
+                            reinterpret_cast<const char*>(b), len);
+    } else {
+        constexpr size_type lanes = 32 / sizeof(T);
+        size_type i = 0;
+
+        while (i + lanes <= len) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            unsigned mask = eq_mask_avx2<T>(va, vb);
+
+            if (mask != 0xFFFFFFFFu) {
+                return i + std::countr_zero(~mask) / sizeof(T);
+            }
+            i += lanes;
+        }
+
+        while (i < len && a[i] == b[i]) {
+            ++i;
+        }
+
+        return i;
+    }
+}
+
 /**
  * @brief AVX2 accelerated KMP search
+ *
+ * With anchor > 0, candidates must also match pattern[anchor]
+ * (see find_pair_avx2). T is any 8-, 16- or 32-bit element type whose
+ * equality is bitwise.
  */
-template <typename FailureTable>
-KMP_FORCE_INLINE const char* kmp_search_avx2(
-    const char* text,
+template <typename FailureTable, typename T>
+KMP_FORCE_INLINE const T* kmp_search_avx2(
+    const T* text,
     size_type text_len,
-    const char* pattern,
+    const T* pattern,
     size_type pattern_len,
-    const FailureTable& failure
+    const FailureTable& failure,
+    size_type anchor = 0
 ) noexcept {
     if (pattern_len == 0) {
         return text;
@@ -144,21 +422,23 @@ KMP_FORCE_INLINE const char* kmp_search_avx2(
         return nullptr;
     }
 
-    const char first_char = pattern[0];
-    const char* text_ptr = text;
-    const char* text_end = text + text_len - pattern_len + 1;
+    const T first_char = pattern[0];
+    const T* text_ptr = text;
+    const T* text_end = text + text_len - pattern_len + 1;
 
     while (text_ptr < text_end) {
         // AVX2 scan for first character
         size_type remaining = static_cast<size_type>(text_end - text_ptr);
-        const char* match = find_first_char_avx2(text_ptr, remaining, first_char);
+        const T* match = anchor
+            ? find_pair_elem_avx2(text_ptr, remaining, first_char, pattern[anchor], anchor)
+            : find_first_elem_avx2(text_ptr, remaining, first_char);
 
         if (!match) {
             return nullptr;
         }
 
         // Use AVX2 compare for pattern verification
-        size_type match_len = compare_avx2(match, pattern, pattern_len);
+        size_type match_len = compare_elem_avx2(match, pattern, pattern_len);
 
         if (match_len == pattern_len) {
             return match;
@@ -178,30 +458,38 @@ KMP_FORCE_INLINE const char* kmp_search_avx2(
 
 /**
  * @brief Find all occurrences using AVX2
+ *
+ * Matches overlap unless non_overlapping is set, in which case the scan
+ * resumes after each match (leftmost, non-overlapping matches). Stops
+ * after max_matches matches.
  */
-template <typename FailureTable, typename OutputIt>
+template <typename FailureTable, typename OutputIt, typename T>
 KMP_FORCE_INLINE OutputIt kmp_search_all_avx2(
-    const char* text,
+    const T* text,
     size_type text_len,
-    const char* pattern,
+    const T* pattern,
     size_type pattern_len,
     const FailureTable& failure,
-    OutputIt out
+    OutputIt out,
+    size_type anchor = 0,
+    bool non_overlapping = false,
+    size_type max_matches = static_cast<size_type>(-1)
 ) noexcept {
     if (pattern_len == 0 || text_len < pattern_len) {
         return out;
     }
 
-    const char* pos = text;
-    const char* end = text + text_len;
+    const T* pos = text;
+    const T* end = text + text_len;
 
-    while (pos <= end - pattern_len) {
-        const char* match = kmp_search_avx2(
+    for (size_type found = 0; found < max_matches && pos <= end - pattern_len; ++found) {
+        const T* match = kmp_search_avx2(
             pos,
             static_cast<size_type>(end - pos),
             pattern,
             pattern_len,
-            failure
+            failure,
+            anchor
         );
 
         if (!match) {
@@ -209,12 +497,382 @@ KMP_FORCE_INLINE OutputIt kmp_search_all_avx2(
         }
 
         *out++ = static_cast<size_type>(match - text);
-        pos = match + 1;
+        pos = match + (non_overlapping ? pattern_len : 1);
+    }
+
+    return out;
+}
+
+/**
+ * @brief Find last occurrence of character using AVX2 (32 bytes/iteration)
+ *
+ * Scans from the end of the haystack towards the start.
+ */
+KMP_FORCE_INLINE const char* find_last_char_avx2(
+    const char* haystack,
+    size_type haystack_len,
+    char needle_char
+) noexcept {
+    const __m256i needle = _mm256_set1_epi8(needle_char);
+    const char* end = haystack + haystack_len;
+
+    while (end - haystack >= 32) {
+        const char* ptr = end - 32;
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                _BitScanReverse(&idx, static_cast<unsigned long>(mask));
+                return ptr + idx;
+            #else
+                return ptr + (31 - __builtin_clz(static_cast<unsigned>(mask)));
+            #endif
+        }
+        end = ptr;
+    }
+
+    // One 16-byte step before the scalar tail
+    if (end - haystack >= 16) {
+        const char* ptr = end - 16;
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(needle_char)));
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                _BitScanReverse(&idx, static_cast<unsigned long>(mask));
+                return ptr + idx;
+            #else
+                return ptr + (31 - __builtin_clz(static_cast<unsigned>(mask)));
+            #endif
+        }
+        end = ptr;
+    }
+
+    while (end > haystack) {
+        --end;
+        if (*end == needle_char) {
+            return end;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Count equal trailing bytes of a[0..len) and b[0..len) using AVX2
+ *
+ * Reverse counterpart of compare_avx2(): returns len if equal.
+ */
+KMP_FORCE_INLINE size_type compare_last_avx2(
+    const char* a,
+    const char* b,
+    size_type len
+) noexcept {
+    size_type i = 0;  // equal bytes so far, from the end
+
+    while (i + 32 <= len) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + len - i - 32));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + len - i - 32));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+
+        if (mask != 0xFFFFFFFFu) {
+            // Highest mismatching lane is the last mismatch
+            unsigned diff = ~mask;
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                _BitScanReverse(&idx, static_cast<unsigned long>(diff));
+                return i + (31 - idx);
+            #else
+                return i + static_cast<size_type>(__builtin_clz(diff) - 0);
+            #endif
+        }
+        i += 32;
+    }
+
+    while (i < len && a[len - 1 - i] == b[len - 1 - i]) {
+        ++i;
+    }
+
+    return i;
+}
+
+/**
+ * @brief AVX2 accelerated reverse KMP search (last occurrence)
+ *
+ * Runs the KMP automaton right to left: scans backwards for the last
+ * pattern byte, verifies towards the start, and shifts with the failure
+ * function of the reversed pattern (compute_reverse_failure()).
+ *
+ * @return Start of the last match, or nullptr
+ */
+template <typename FailureTable>
+KMP_FORCE_INLINE const char* kmp_search_last_avx2(
+    const char* text,
+    size_type text_len,
+    const char* pattern,
+    size_type pattern_len,
+    const FailureTable& reverse_failure
+) noexcept {
+    if (pattern_len == 0) {
+        return text + text_len;
+    }
+    if (text_len < pattern_len) {
+        return nullptr;
+    }
+
+    const char last_char = pattern[pattern_len - 1];
+    // Candidate match ends lie in [text + pattern_len - 1, text_end)
+    const char* lowest_end = text + pattern_len - 1;
+    const char* text_end = text + text_len;
+
+    while (text_end > lowest_end) {
+        size_type remaining = static_cast<size_type>(text_end - lowest_end);
+        const char* match_end = find_last_char_avx2(lowest_end, remaining, last_char);
+
+        if (!match_end) {
+            return nullptr;
+        }
+
+        const char* start = match_end + 1 - pattern_len;
+        size_type match_len = compare_last_avx2(start, pattern, pattern_len);
+
+        if (match_len == pattern_len) {
+            return start;
+        }
+
+        // Shift left using the reversed pattern's failure function
+        size_type skip = 1;
+        if (match_len > 0) {
+            skip = match_len - reverse_failure[match_len - 1];
+        }
+
+        text_end = match_end + 1 - skip;
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Masked Literals (Wildcard Bytes)
+// =============================================================================
+
+/**
+ * @brief Whether (a[i] & mask[i]) == bytes[i] for all i < len using AVX2
+ *
+ * bytes must already be masked. Used to verify wildcard signatures.
+ */
+KMP_FORCE_INLINE bool equal_masked_avx2(
+    const char* a,
+    const char* bytes,
+    const char* mask,
+    size_type len
+) noexcept {
+    size_type i = 0;
+
+    while (i + 32 <= len) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+        __m256i vm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + i));
+        if (static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_and_si256(va, vm), vb))) != 0xFFFFFFFFu) {
+            return false;
+        }
+        i += 32;
+    }
+
+    for (; i < len; ++i) {
+        if ((a[i] & mask[i]) != bytes[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief First match of a masked literal using AVX2
+ *
+ * Candidates come from a scan for the exact byte at offset first (and at
+ * offset second, if second > first); each is verified with
+ * equal_masked_avx2(). Wildcards break the failure function, so the scan
+ * resumes one byte after a rejected candidate.
+ */
+KMP_FORCE_INLINE const char* find_masked_avx2(
+    const char* text,
+    size_type text_len,
+    const char* bytes,
+    const char* mask,
+    size_type pattern_len,
+    size_type first,
+    size_type second
+) noexcept {
+    if (text_len < pattern_len) {
+        return nullptr;
+    }
+
+    const char* ptr = text;
+    const char* end = text + text_len - pattern_len + 1;
+
+    while (ptr < end) {
+        size_type remaining = static_cast<size_type>(end - ptr);
+        const char* hit = second > first
+            ? find_pair_avx2(ptr + first, remaining, bytes[first], bytes[second], second - first)
+            : find_first_char_avx2(ptr + first, remaining, bytes[first]);
+
+        if (!hit) {
+            return nullptr;
+        }
+
+        const char* candidate = hit - first;
+        if (equal_masked_avx2(candidate, bytes, mask, pattern_len)) {
+            return candidate;
+        }
+        ptr = candidate + 1;
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Approximate Matching (Hamming Distance)
+// =============================================================================
+
+/**
+ * @brief Alignments text[j, j + m) for j < 32 within k mismatches (AVX2)
+ *
+ * Byte lane j counts the mismatches of alignment j, saturating at 255;
+ * bit j of the result is set when the count is <= k. Reads
+ * text[0, 31 + m). Returns early once every lane exceeds k.
+ */
+KMP_FORCE_INLINE std::uint32_t hamming_block_avx2(
+    const char* text,
+    const char* pattern,
+    size_type pattern_len,
+    std::uint8_t k
+) noexcept {
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(k));
+    __m256i mismatches = _mm256_setzero_si256();
+
+    for (size_type i = 0; i < pattern_len; ++i) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        __m256i eq = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(pattern[i]));
+        mismatches = _mm256_adds_epu8(mismatches, _mm256_andnot_si256(eq, one));
+
+        if ((i & 7) == 7 &&
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(mismatches, limit), mismatches)) == 0) {
+            return 0;
+        }
+    }
+
+    return static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(mismatches, limit), mismatches)));
+}
+
+/**
+ * @brief Write every position within k mismatches of pattern to out (AVX2)
+ *
+ * k must be below 255 and below pattern_len. Positions too close to the
+ * end for a full block are checked one at a time.
+ */
+template <typename OutputIt>
+OutputIt hamming_search_all_avx2(
+    const char* text,
+    size_type text_len,
+    const char* pattern,
+    size_type pattern_len,
+    std::uint8_t k,
+    OutputIt out
+) {
+    if (text_len < pattern_len) {
+        return out;
+    }
+
+    size_type pos = 0;
+    while (pos + 31 + pattern_len <= text_len) {
+        auto hits = hamming_block_avx2(text + pos, pattern, pattern_len, k);
+        while (hits != 0) {
+            *out++ = pos + static_cast<size_type>(std::countr_zero(hits));
+            hits &= hits - 1;
+        }
+        pos += 32;
+    }
+
+    for (; pos + pattern_len <= text_len; ++pos) {
+        size_type mismatches = 0;
+        for (size_type i = 0; i < pattern_len && mismatches <= k; ++i) {
+            mismatches += text[pos + i] != pattern[i];
+        }
+        if (mismatches <= k) {
+            *out++ = pos;
+        }
     }
 
     return out;
 }
 
+// =============================================================================
+// Sorted Set Intersection
+// =============================================================================
+
+/**
+ * @brief Intersect two strictly increasing uint32 arrays into out (AVX2)
+ *
+ * Blocks of 8: each block of a is compared against the 8 rotations of
+ * the current block of b (see intersect_sorted_sse42).
+ *
+ * @return Number of values written
+ */
+inline size_type intersect_sorted_avx2(
+    const std::uint32_t* a,
+    size_type a_len,
+    const std::uint32_t* b,
+    size_type b_len,
+    std::uint32_t* out
+) noexcept {
+    size_type i = 0;
+    size_type j = 0;
+    size_type count = 0;
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+
+    while (i + 8 <= a_len && j + 8 <= b_len) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i eq = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+        }
+
+        auto hits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+        while (hits != 0) {
+            out[count++] = a[i + static_cast<size_type>(std::countr_zero(hits))];
+            hits &= hits - 1;
+        }
+
+        const std::uint32_t a_max = a[i + 7];
+        const std::uint32_t b_max = b[j + 7];
+        i += a_max <= b_max ? 8 : 0;
+        j += b_max <= a_max ? 8 : 0;
+    }
+
+    while (i < a_len && j < b_len) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            out[count++] = a[i];
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
 } // namespace kmp::detail::simd
 
 #endif // KMP_HAS_AVX2
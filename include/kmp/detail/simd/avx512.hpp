@@ -13,6 +13,8 @@
 #if KMP_HAS_AVX512 || (defined(_MSC_VER) && defined(__AVX512F__))
 
 #include <immintrin.h>
+#include <bit>
+#include <cstdint>
 #include <cstring>
 
 namespace kmp::detail::simd {
@@ -110,6 +112,73 @@ KMP_FORCE_INLINE const char* find_first_char_avx512(
     return nullptr;
 }
 
+/**
+ * @brief Find first byte from a small set (1-3 bytes) using AVX-512
+ *
+ * With stop_at_non_ascii, any byte >= 0x80 also ends the scan. Used by
+ * the DFA to skip over self-loop runs. The tail is handled with a masked
+ * load instead of narrower vectors.
+ */
+KMP_FORCE_INLINE const char* find_first_of_avx512(
+    const char* haystack,
+    size_type haystack_len,
+    const char* set,
+    size_type set_size,
+    bool stop_at_non_ascii = false
+) noexcept {
+    if (haystack_len == 0 || set_size == 0) {
+        return nullptr;
+    }
+
+    // Unused slots repeat the first byte
+    const __m512i n0 = _mm512_set1_epi8(set[0]);
+    const __m512i n1 = _mm512_set1_epi8(set[set_size > 1 ? 1 : 0]);
+    const __m512i n2 = _mm512_set1_epi8(set[set_size > 2 ? 2 : 0]);
+    const __mmask64 high_mask = stop_at_non_ascii ? ~__mmask64{0} : __mmask64{0};
+
+    const char* ptr = haystack;
+    const char* end = haystack + haystack_len;
+
+    while (ptr < end) {
+        const auto remaining = static_cast<size_type>(end - ptr);
+        const __mmask64 valid = remaining >= 64
+            ? ~__mmask64{0}
+            : ((__mmask64{1} << remaining) - 1);
+
+        __m512i chunk = _mm512_maskz_loadu_epi8(valid, ptr);
+        __mmask64 mask = _mm512_cmpeq_epi8_mask(chunk, n0) |
+                         _mm512_cmpeq_epi8_mask(chunk, n1) |
+                         _mm512_cmpeq_epi8_mask(chunk, n2) |
+                         (_mm512_movepi8_mask(chunk) & high_mask);
+        mask &= valid;
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                #if defined(_M_X64)
+                    _BitScanForward64(&idx, mask);
+                #else
+                    if (static_cast<unsigned long>(mask) != 0) {
+                        _BitScanForward(&idx, static_cast<unsigned long>(mask));
+                    } else {
+                        _BitScanForward(&idx, static_cast<unsigned long>(mask >> 32));
+                        idx += 32;
+                    }
+                #endif
+                return ptr + idx;
+            #else
+                return ptr + __builtin_ctzll(mask);
+            #endif
+        }
+        if (remaining <= 64) {
+            break;
+        }
+        ptr += 64;
+    }
+
+    return nullptr;
+}
+
 /**
  * @brief Compare two strings using AVX-512 for quick mismatch detection
  */
@@ -179,16 +248,237 @@ KMP_FORCE_INLINE size_type compare_avx512(
     return len;
 }
 
+/**
+ * @brief Find first position where two anchor bytes both match using AVX-512
+ *
+ * Returns the first p < haystack_len with haystack[p] == first and
+ * haystack[p + offset] == second. The caller guarantees that
+ * haystack[haystack_len - 1 + offset] is readable; the tail uses masked
+ * loads.
+ */
+KMP_FORCE_INLINE const char* find_pair_avx512(
+    const char* haystack,
+    size_type haystack_len,
+    char first,
+    char second,
+    size_type offset
+) noexcept {
+    const __m512i n0 = _mm512_set1_epi8(first);
+    const __m512i n1 = _mm512_set1_epi8(second);
+
+    const char* ptr = haystack;
+    const char* end = haystack + haystack_len;
+
+    while (ptr < end) {
+        const auto remaining = static_cast<size_type>(end - ptr);
+        const __mmask64 valid = remaining >= 64
+            ? ~__mmask64{0}
+            : ((__mmask64{1} << remaining) - 1);
+
+        __m512i a = _mm512_maskz_loadu_epi8(valid, ptr);
+        __m512i b = _mm512_maskz_loadu_epi8(valid, ptr + offset);
+        __mmask64 mask = _mm512_mask_cmpeq_epi8_mask(
+            _mm512_cmpeq_epi8_mask(a, n0) & valid, b, n1);
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                #if defined(_M_X64)
+                    _BitScanForward64(&idx, mask);
+                #else
+                    if (static_cast<unsigned long>(mask) != 0) {
+                        _BitScanForward(&idx, static_cast<unsigned long>(mask));
+                    } else {
+                        _BitScanForward(&idx, static_cast<unsigned long>(mask >> 32));
+                        idx += 32;
+                    }
+                #endif
+                return ptr + idx;
+            #else
+                return ptr + __builtin_ctzll(mask);
+            #endif
+        }
+        if (remaining <= 64) {
+            break;
+        }
+        ptr += 64;
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Element Width Primitives
+// =============================================================================
+
+/**
+ * @brief Broadcast an 8-, 16- or 32-bit element to every lane
+ */
+template <typename T>
+KMP_FORCE_INLINE __m512i broadcast_avx512(T value) noexcept {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+    if constexpr (sizeof(T) == 1) {
+        return _mm512_set1_epi8(std::bit_cast<char>(value));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm512_set1_epi16(std::bit_cast<short>(value));
+    } else {
+        return _mm512_set1_epi32(std::bit_cast<int>(value));
+    }
+}
+
+/**
+ * @brief Compare lanes of sizeof(T) bytes; one mask bit per element
+ */
+template <typename T>
+KMP_FORCE_INLINE std::uint64_t eq_mask_avx512(__m512i a, __m512i b) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return _mm512_cmpeq_epi8_mask(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm512_cmpeq_epi16_mask(a, b);
+    } else {
+        return _mm512_cmpeq_epi32_mask(a, b);
+    }
+}
+
+/**
+ * @brief find_first_char_avx512() for 8-, 16- and 32-bit elements
+ */
+template <typename T>
+KMP_FORCE_INLINE const T* find_first_elem_avx512(
+    const T* haystack,
+    size_type haystack_len,
+    T needle
+) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return reinterpret_cast<const T*>(find_first_char_avx512(
+            reinterpret_cast<const char*>(haystack), haystack_len,
+            std::bit_cast<char>(needle)));
+    } else {
+        constexpr size_type lanes = 64 / sizeof(T);
+        const __m512i n = broadcast_avx512(needle);
+
+        const T* ptr = haystack;
+        const T* end = haystack + haystack_len;
+
+        while (static_cast<size_type>(end - ptr) >= lanes) {
+            __m512i chunk = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(ptr));
+            std::uint64_t mask = eq_mask_avx512<T>(chunk, n);
+
+            if (mask != 0) {
+                return ptr + std::countr_zero(mask);
+            }
+            ptr += lanes;
+        }
+
+        while (ptr < end) {
+            if (*ptr == needle) {
+                return ptr;
+            }
+            ++ptr;
+        }
+
+        return nullptr;
+    }
+}
+
+/**
+ * @brief find_pair_avx512() for 8-, 16- and 32-bit elements
+ */
+template <typename T>
+KMP_FORCE_INLINE const T* find_pair_elem_avx512(
+    const T* haystack,
+    size_type haystack_len,
+    T first,
+    T second,
+    size_type offset
+) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return reinterpret_cast<const T*>(find_pair_avx512(
+            reinterpret_cast<const char*>(haystack), haystack_len,
+            std::bit_cast<char>(first), std::bit_cast<char>(second), offset));
+    } else {
+        constexpr size_type lanes = 64 / sizeof(T);
+        const __m512i n0 = broadcast_avx512(first);
+        const __m512i n1 = broadcast_avx512(second);
+
+        const T* ptr = haystack;
+        const T* end = haystack + haystack_len;
+
+        while (static_cast<size_type>(end - ptr) >= lanes) {
+            __m512i a = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(ptr));
+            __m512i b = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(ptr + offset));
+            std::uint64_t mask = eq_mask_avx512<T>(a, n0) & eq_mask_avx512<T>(b, n1);
+
+            if (mask != 0) {
+                return ptr + std::countr_zero(mask);
+            }
+            ptr += lanes;
+        }
+
+        while (ptr < end) {
+            if (*ptr == first && ptr[offset] == second) {
+                return ptr;
+            }
+            ++ptr;
+        }
+
+        return nullptr;
+    }
+}
+
+/**
+ * @brief compare_avx512() for 8-, 16- and 32-bit elements
+ *
+ * Returns the index of the first mismatching element, or len if equal.
+ */
+template <typename T>
+KMP_FORCE_INLINE size_type compare_elem_avx512(
+    const T* a,
+    const T* b,
+    size_type len
+) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return compare_avx512(reinterpret_cast<const char*>(a),
+                              reinterpret_cast<const char*>(b), len);
+    } else {
+        constexpr size_type lanes = 64 / sizeof(T);
+        constexpr std::uint64_t all_equal = (std::uint64_t{1} << lanes) - 1;
+        size_type i = 0;
+
+        while (i + lanes <= len) {
+            __m512i va = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(a + i));
+            __m512i vb = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(b + i));
+            std::uint64_t mask = eq_mask_avx512<T>(va, vb);
+
+            if (mask != all_equal) {
+                return i + std::countr_zero(~mask);
+            }
+            i += lanes;
+        }
+
+        while (i < len && a[i] == b[i]) {
+            ++i;
+        }
+
+        return i;
+    }
+}
+
 /**
  * @brief AVX-512 accelerated KMP search
+ *
+ * With anchor > 0, candidates must also match pattern[anchor]
+ * (see find_pair_avx512). T is any 8-, 16- or 32-bit element type whose
+ * equality is bitwise.
  */
-template <typename FailureTable>
-KMP_FORCE_INLINE const char* kmp_search_avx512(
-    const char* text,
+template <typename FailureTable, typename T>
+KMP_FORCE_INLINE const T* kmp_search_avx512(
+    const T* text,
     size_type text_len,
-    const char* pattern,
+    const T* pattern,
     size_type pattern_len,
-    const FailureTable& failure
+    const FailureTable& failure,
+    size_type anchor = 0
 ) noexcept {
     if (pattern_len == 0) {
         return text;
@@ -197,21 +487,23 @@ KMP_FORCE_INLINE const char* kmp_search_avx512(
         return nullptr;
     }
 
-    const char first_char = pattern[0];
-    const char* text_ptr = text;
-    const char* text_end = text + text_len - pattern_len + 1;
+    const T first_char = pattern[0];
+    const T* text_ptr = text;
+    const T* text_end = text + text_len - pattern_len + 1;
 
     while (text_ptr < text_end) {
         // AVX-512 scan for first character
         size_type remaining = static_cast<size_type>(text_end - text_ptr);
-        const char* match = find_first_char_avx512(text_ptr, remaining, first_char);
+        const T* match = anchor
+            ? find_pair_elem_avx512(text_ptr, remaining, first_char, pattern[anchor], anchor)
+            : find_first_elem_avx512(text_ptr, remaining, first_char);
 
         if (!match) {
             return nullptr;
         }
 
         // Use AVX-512 compare for pattern verification
-        size_type match_len = compare_avx512(match, pattern, pattern_len);
+        size_type match_len = compare_elem_avx512(match, pattern, pattern_len);
 
         if (match_len == pattern_len) {
             return match;
@@ -231,30 +523,38 @@ KMP_FORCE_INLINE const char* kmp_search_avx512(
 
 /**
  * @brief Find all occurrences using AVX-512
+ *
+ * Matches overlap unless non_overlapping is set, in which case the scan
+ * resumes after each match (leftmost, non-overlapping matches). Stops
+ * after max_matches matches.
  */
-template <typename FailureTable, typename OutputIt>
+template <typename FailureTable, typename OutputIt, typename T>
 KMP_FORCE_INLINE OutputIt kmp_search_all_avx512(
-    const char* text,
+    const T* text,
     size_type text_len,
-    const char* pattern,
+    const T* pattern,
     size_type pattern_len,
     const FailureTable& failure,
-    OutputIt out
+    OutputIt out,
+    size_type anchor = 0,
+    bool non_overlapping = false,
+    size_type max_matches = static_cast<size_type>(-1)
 ) noexcept {
     if (pattern_len == 0 || text_len < pattern_len) {
         return out;
     }
 
-    const char* pos = text;
-    const char* end = text + text_len;
+    const T* pos = text;
+    const T* end = text + text_len;
 
-    while (pos <= end - pattern_len) {
-        const char* match = kmp_search_avx512(
+    for (size_type found = 0; found < max_matches && pos <= end - pattern_len; ++found) {
+        const T* match = kmp_search_avx512(
             pos,
             static_cast<size_type>(end - pos),
             pattern,
             pattern_len,
-            failure
+            failure,
+            anchor
         );
 
         if (!match) {
@@ -262,12 +562,371 @@ KMP_FORCE_INLINE OutputIt kmp_search_all_avx512(
         }
 
         *out++ = static_cast<size_type>(match - text);
-        pos = match + 1;
+        pos = match + (non_overlapping ? pattern_len : 1);
+    }
+
+    return out;
+}
+
+/**
+ * @brief Find last occurrence of character using AVX-512 (64 bytes/iteration)
+ *
+ * Scans from the end of the haystack towards the start; the final partial
+ * block uses a masked load.
+ */
+KMP_FORCE_INLINE const char* find_last_char_avx512(
+    const char* haystack,
+    size_type haystack_len,
+    char needle_char
+) noexcept {
+    const __m512i needle = _mm512_set1_epi8(needle_char);
+    const char* end = haystack + haystack_len;
+
+    while (end > haystack) {
+        const auto remaining = static_cast<size_type>(end - haystack);
+        const size_type width = remaining >= 64 ? 64 : remaining;
+        const char* ptr = end - width;
+        const __mmask64 valid = width == 64
+            ? ~__mmask64{0}
+            : ((__mmask64{1} << width) - 1);
+
+        __m512i chunk = _mm512_maskz_loadu_epi8(valid, ptr);
+        __mmask64 mask = _mm512_mask_cmpeq_epi8_mask(valid, chunk, needle);
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                #if defined(_M_X64)
+                    _BitScanReverse64(&idx, mask);
+                #else
+                    if ((mask >> 32) != 0) {
+                        _BitScanReverse(&idx, static_cast<unsigned long>(mask >> 32));
+                        idx += 32;
+                    } else {
+                        _BitScanReverse(&idx, static_cast<unsigned long>(mask));
+                    }
+                #endif
+                return ptr + idx;
+            #else
+                return ptr + (63 - __builtin_clzll(mask));
+            #endif
+        }
+        end = ptr;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Count equal trailing bytes of a[0..len) and b[0..len) using AVX-512
+ *
+ * Reverse counterpart of compare_avx512(): returns len if equal.
+ */
+KMP_FORCE_INLINE size_type compare_last_avx512(
+    const char* a,
+    const char* b,
+    size_type len
+) noexcept {
+    size_type i = 0;  // equal bytes so far, from the end
+
+    while (i < len) {
+        const size_type width = len - i >= 64 ? 64 : len - i;
+        const __mmask64 valid = width == 64
+            ? ~__mmask64{0}
+            : ((__mmask64{1} << width) - 1);
+        const size_type offset = len - i - width;
+
+        __m512i va = _mm512_maskz_loadu_epi8(valid, a + offset);
+        __m512i vb = _mm512_maskz_loadu_epi8(valid, b + offset);
+        __mmask64 diff = _mm512_mask_cmpneq_epi8_mask(valid, va, vb);
+
+        if (diff != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                #if defined(_M_X64)
+                    _BitScanReverse64(&idx, diff);
+                #else
+                    if ((diff >> 32) != 0) {
+                        _BitScanReverse(&idx, static_cast<unsigned long>(diff >> 32));
+                        idx += 32;
+                    } else {
+                        _BitScanReverse(&idx, static_cast<unsigned long>(diff));
+                    }
+                #endif
+                return i + (width - 1 - idx);
+            #else
+                return i + (width - 1 - static_cast<size_type>(63 - __builtin_clzll(diff)));
+            #endif
+        }
+        i += width;
+    }
+
+    return len;
+}
+
+/**
+ * @brief AVX-512 accelerated reverse KMP search (last occurrence)
+ *
+ * Runs the KMP automaton right to left: scans backwards for the last
+ * pattern byte, verifies towards the start, and shifts with the failure
+ * function of the reversed pattern (compute_reverse_failure()).
+ *
+ * @return Start of the last match, or nullptr
+ */
+template <typename FailureTable>
+KMP_FORCE_INLINE const char* kmp_search_last_avx512(
+    const char* text,
+    size_type text_len,
+    const char* pattern,
+    size_type pattern_len,
+    const FailureTable& reverse_failure
+) noexcept {
+    if (pattern_len == 0) {
+        return text + text_len;
+    }
+    if (text_len < pattern_len) {
+        return nullptr;
+    }
+
+    const char last_char = pattern[pattern_len - 1];
+    // Candidate match ends lie in [text + pattern_len - 1, text_end)
+    const char* lowest_end = text + pattern_len - 1;
+    const char* text_end = text + text_len;
+
+    while (text_end > lowest_end) {
+        size_type remaining = static_cast<size_type>(text_end - lowest_end);
+        const char* match_end = find_last_char_avx512(lowest_end, remaining, last_char);
+
+        if (!match_end) {
+            return nullptr;
+        }
+
+        const char* start = match_end + 1 - pattern_len;
+        size_type match_len = compare_last_avx512(start, pattern, pattern_len);
+
+        if (match_len == pattern_len) {
+            return start;
+        }
+
+        // Shift left using the reversed pattern's failure function
+        size_type skip = 1;
+        if (match_len > 0) {
+            skip = match_len - reverse_failure[match_len - 1];
+        }
+
+        text_end = match_end + 1 - skip;
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Masked Literals (Wildcard Bytes)
+// =============================================================================
+
+/**
+ * @brief Whether (a[i] & mask[i]) == bytes[i] for all i < len using AVX-512
+ *
+ * bytes must already be masked. The tail uses masked loads.
+ */
+KMP_FORCE_INLINE bool equal_masked_avx512(
+    const char* a,
+    const char* bytes,
+    const char* mask,
+    size_type len
+) noexcept {
+    for (size_type i = 0; i < len; i += 64) {
+        const size_type remaining = len - i;
+        const __mmask64 valid = remaining >= 64
+            ? ~__mmask64{0}
+            : ((__mmask64{1} << remaining) - 1);
+
+        __m512i va = _mm512_maskz_loadu_epi8(valid, a + i);
+        __m512i vb = _mm512_maskz_loadu_epi8(valid, bytes + i);
+        __m512i vm = _mm512_maskz_loadu_epi8(valid, mask + i);
+        if (_mm512_cmpeq_epi8_mask(_mm512_and_si512(va, vm), vb) != ~__mmask64{0}) {
+            return false;
+        }
+    }
+
+    return true;
+}
+/**
+ * @brief First match of a masked literal using AVX-512
+ *
+ * Candidates come from a scan for the exact byte at offset first (and at
+ * offset second, if second > first); each is verified with
+ * equal_masked_avx512(). Wildcards break the failure function, so the scan
+ * resumes one byte after a rejected candidate.
+ */
+KMP_FORCE_INLINE const char* find_masked_avx512(
+    const char* text,
+    size_type text_len,
+    const char* bytes,
+    const char* mask,
+    size_type pattern_len,
+    size_type first,
+    size_type second
+) noexcept {
+    if (text_len < pattern_len) {
+        return nullptr;
+    }
+
+    const char* ptr = text;
+    const char* end = text + text_len - pattern_len + 1;
+
+    while (ptr < end) {
+        size_type remaining = static_cast<size_type>(end - ptr);
+        const char* hit = second > first
+            ? find_pair_avx512(ptr + first, remaining, bytes[first], bytes[second], second - first)
+            : find_first_char_avx512(ptr + first, remaining, bytes[first]);
+
+        if (!hit) {
+            return nullptr;
+        }
+
+        const char* candidate = hit - first;
+        if (equal_masked_avx512(candidate, bytes, mask, pattern_len)) {
+            return candidate;
+        }
+        ptr = candidate + 1;
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Approximate Matching (Hamming Distance)
+// =============================================================================
+
+/**
+ * @brief Alignments text[j, j + m) for j < 64 within k mismatches (AVX-512)
+ *
+ * Byte lane j counts the mismatches of alignment j, saturating at 255;
+ * bit j of the result is set when the count is <= k. Reads
+ * text[0, 63 + m). Returns early once every lane exceeds k.
+ */
+KMP_FORCE_INLINE std::uint64_t hamming_block_avx512(
+    const char* text,
+    const char* pattern,
+    size_type pattern_len,
+    std::uint8_t k
+) noexcept {
+    const __m512i one = _mm512_set1_epi8(1);
+    const __m512i limit = _mm512_set1_epi8(static_cast<char>(k));
+    __m512i mismatches = _mm512_setzero_si512();
+
+    for (size_type i = 0; i < pattern_len; ++i) {
+        __m512i chunk = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(text + i));
+        __mmask64 ne = _mm512_cmpneq_epi8_mask(chunk, _mm512_set1_epi8(pattern[i]));
+        mismatches = _mm512_mask_adds_epu8(mismatches, ne, mismatches, one);
+
+        if ((i & 7) == 7 && _mm512_cmple_epu8_mask(mismatches, limit) == 0) {
+            return 0;
+        }
+    }
+
+    return _mm512_cmple_epu8_mask(mismatches, limit);
+}
+
+/**
+ * @brief Write every position within k mismatches of pattern to out (AVX-512)
+ *
+ * k must be below 255 and below pattern_len. Positions too close to the
+ * end for a full block are checked one at a time.
+ */
+template <typename OutputIt>
+OutputIt hamming_search_all_avx512(
+    const char* text,
+    size_type text_len,
+    const char* pattern,
+    size_type pattern_len,
+    std::uint8_t k,
+    OutputIt out
+) {
+    if (text_len < pattern_len) {
+        return out;
+    }
+
+    size_type pos = 0;
+    while (pos + 63 + pattern_len <= text_len) {
+        auto hits = hamming_block_avx512(text + pos, pattern, pattern_len, k);
+        while (hits != 0) {
+            *out++ = pos + static_cast<size_type>(std::countr_zero(hits));
+            hits &= hits - 1;
+        }
+        pos += 64;
+    }
+
+    for (; pos + pattern_len <= text_len; ++pos) {
+        size_type mismatches = 0;
+        for (size_type i = 0; i < pattern_len && mismatches <= k; ++i) {
+            mismatches += text[pos + i] != pattern[i];
+        }
+        if (mismatches <= k) {
+            *out++ = pos;
+        }
     }
 
     return out;
 }
 
+// =============================================================================
+// Sorted Set Intersection
+// =============================================================================
+
+/**
+ * @brief Intersect two strictly increasing uint32 arrays into out (AVX-512)
+ *
+ * Blocks of 16 compared against the 16 rotations of the other block (see
+ * intersect_sorted_sse42); matches are written with a compress store.
+ *
+ * @return Number of values written
+ */
+inline size_type intersect_sorted_avx512(
+    const std::uint32_t* a,
+    size_type a_len,
+    const std::uint32_t* b,
+    size_type b_len,
+    std::uint32_t* out
+) noexcept {
+    size_type i = 0;
+    size_type j = 0;
+    size_type count = 0;
+    const __m512i rotate = _mm512_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0);
+
+    while (i + 16 <= a_len && j + 16 <= b_len) {
+        const __m512i va = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(a + i));
+        __m512i vb = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(b + j));
+        __mmask16 hits = _mm512_cmpeq_epi32_mask(va, vb);
+        for (int r = 1; r < 16; ++r) {
+            vb = _mm512_permutexvar_epi32(rotate, vb);
+            hits = static_cast<__mmask16>(hits | _mm512_cmpeq_epi32_mask(va, vb));
+        }
+
+        _mm512_mask_compressstoreu_epi32(out + count, hits, va);
+        count += static_cast<size_type>(std::popcount(static_cast<unsigned>(hits)));
+
+        const std::uint32_t a_max = a[i + 15];
+        const std::uint32_t b_max = b[j + 15];
+        i += a_max <= b_max ? 16 : 0;
+        j += b_max <= a_max ? 16 : 0;
+    }
+
+    while (i < a_len && j < b_len) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            out[count++] = a[i];
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
 } // namespace kmp::detail::simd
 
 #endif // KMP_HAS_AVX512
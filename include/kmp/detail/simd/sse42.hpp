@@ -13,6 +13,8 @@
 #if KMP_HAS_SSE42 || defined(_MSC_VER)
 
 #include <nmmintrin.h>  // SSE4.2
+#include <bit>
+#include <cstdint>
 #include <cstring>
 
 namespace kmp::detail::simd {
@@ -67,20 +69,258 @@ KMP_FORCE_INLINE const char* find_first_char_sse42(
     return nullptr;
 }
 
+/**
+ * @brief Find first byte from a small set (1-3 bytes) using SSE
+ *
+ * With stop_at_non_ascii, any byte >= 0x80 also ends the scan. Used by
+ * the DFA to skip over self-loop runs.
+ */
+KMP_FORCE_INLINE const char* find_first_of_sse42(
+    const char* haystack,
+    size_type haystack_len,
+    const char* set,
+    size_type set_size,
+    bool stop_at_non_ascii = false
+) noexcept {
+    if (haystack_len == 0 || set_size == 0) {
+        return nullptr;
+    }
+
+    // Unused slots repeat the first byte
+    const char c0 = set[0];
+    const char c1 = set[set_size > 1 ? 1 : 0];
+    const char c2 = set[set_size > 2 ? 2 : 0];
+    const __m128i n0 = _mm_set1_epi8(c0);
+    const __m128i n1 = _mm_set1_epi8(c1);
+    const __m128i n2 = _mm_set1_epi8(c2);
+    const int high_mask = stop_at_non_ascii ? 0xFFFF : 0;
+
+    const char* ptr = haystack;
+    const char* end = haystack + haystack_len;
+
+    while (ptr + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, n0), _mm_cmpeq_epi8(chunk, n1)),
+            _mm_cmpeq_epi8(chunk, n2));
+        int mask = _mm_movemask_epi8(hit) | (_mm_movemask_epi8(chunk) & high_mask);
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                _BitScanForward(&idx, static_cast<unsigned long>(mask));
+                return ptr + idx;
+            #else
+                return ptr + __builtin_ctz(static_cast<unsigned>(mask));
+            #endif
+        }
+        ptr += 16;
+    }
+
+    // Handle remaining bytes
+    while (ptr < end) {
+        char c = *ptr;
+        if (c == c0 || c == c1 || c == c2 ||
+            (stop_at_non_ascii && static_cast<unsigned char>(c) >= 0x80)) {
+            return ptr;
+        }
+        ++ptr;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Find first position where two anchor bytes both match (SSE2 compares)
+ *
+ * Returns the first p < haystack_len with haystack[p] == first and
+ * haystack[p + offset] == second. The caller guarantees that
+ * haystack[haystack_len - 1 + offset] is readable.
+ */
+KMP_FORCE_INLINE const char* find_pair_sse42(
+    const char* haystack,
+    size_type haystack_len,
+    char first,
+    char second,
+    size_type offset
+) noexcept {
+    const __m128i n0 = _mm_set1_epi8(first);
+    const __m128i n1 = _mm_set1_epi8(second);
+
+    const char* ptr = haystack;
+    const char* end = haystack + haystack_len;
+
+    while (ptr + 16 <= end) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + offset));
+        int mask = _mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, n0), _mm_cmpeq_epi8(b, n1)));
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                _BitScanForward(&idx, static_cast<unsigned long>(mask));
+                return ptr + idx;
+            #else
+                return ptr + __builtin_ctz(static_cast<unsigned>(mask));
+            #endif
+        }
+        ptr += 16;
+    }
+
+    while (ptr < end) {
+        if (*ptr == first && ptr[offset] == second) {
+            return ptr;
+        }
+        ++ptr;
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Element Width Primitives
+// =============================================================================
+
+/**
+ * @brief Broadcast an 8-, 16- or 32-bit element to every lane
+ */
+template <typename T>
+KMP_FORCE_INLINE __m128i broadcast_sse42(T value) noexcept {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+    if constexpr (sizeof(T) == 1) {
+        return _mm_set1_epi8(std::bit_cast<char>(value));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_set1_epi16(std::bit_cast<short>(value));
+    } else {
+        return _mm_set1_epi32(std::bit_cast<int>(value));
+    }
+}
+
+/**
+ * @brief Compare lanes of sizeof(T) bytes; one mask bit per byte
+ *
+ * An equal element sets sizeof(T) consecutive bits, so the first equal
+ * element is at countr_zero(mask) / sizeof(T).
+ */
+template <typename T>
+KMP_FORCE_INLINE unsigned eq_mask_sse42(__m128i a, __m128i b) noexcept {
+    __m128i cmp;
+    if constexpr (sizeof(T) == 1) {
+        cmp = _mm_cmpeq_epi8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+        cmp = _mm_cmpeq_epi16(a, b);
+    } else {
+        cmp = _mm_cmpeq_epi32(a, b);
+    }
+    return static_cast<unsigned>(_mm_movemask_epi8(cmp));
+}
+
+/**
+ * @brief find_first_char_sse42() for 8-, 16- and 32-bit elements
+ */
+template <typename T>
+KMP_FORCE_INLINE const T* find_first_elem_sse42(
+    const T* haystack,
+    size_type haystack_len,
+    T needle
+) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return reinterpret_cast<const T*>(find_first_char_sse42(
+            reinterpret_cast<const char*>(haystack), haystack_len,
+            std::bit_cast<char>(needle)));
+    } else {
+        constexpr size_type lanes = 16 / sizeof(T);
+        const __m128i n = broadcast_sse42(needle);
+
+        const T* ptr = haystack;
+        const T* end = haystack + haystack_len;
+
+        while (static_cast<size_type>(end - ptr) >= lanes) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+            unsigned mask = eq_mask_sse42<T>(chunk, n);
+
+            if (mask != 0) {
+                return ptr + std::countr_zero(mask) / sizeof(T);
+            }
+            ptr += lanes;
+        }
+
+        while (ptr < end) {
+            if (*ptr == needle) {
+                return ptr;
+            }
+            ++ptr;
+        }
+
+        return nullptr;
+    }
+}
+
+/**
+ * @brief find_pair_sse42() for 8-, 16- and 32-bit elements
+ */
+template <typename T>
+KMP_FORCE_INLINE const T* find_pair_elem_sse42(
+    const T* haystack,
+    size_type haystack_len,
+    T first,
+    T second,
+    size_type offset
+) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return reinterpret_cast<const T*>(find_pair_sse42(
+            reinterpret_cast<const char*>(haystack), haystack_len,
+            std::bit_cast<char>(first), std::bit_cast<char>(second), offset));
+    } else {
+        constexpr size_type lanes = 16 / sizeof(T);
+        const __m128i n0 = broadcast_sse42(first);
+        const __m128i n1 = broadcast_sse42(second);
+
+        const T* ptr = haystack;
+        const T* end = haystack + haystack_len;
+
+        while (static_cast<size_type>(end - ptr) >= lanes) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + offset));
+            unsigned mask = eq_mask_sse42<T>(a, n0) & eq_mask_sse42<T>(b, n1);
+
+            if (mask != 0) {
+                return ptr + std::countr_zero(mask) / sizeof(T);
+            }
+            ptr += lanes;
+        }
+
+        while (ptr < end) {
+            if (*ptr == first && ptr[offset] == second) {
+                return ptr;
+            }
+            ++ptr;
+        }
+
+        return nullptr;
+    }
+}
+
 /**
  * @brief SSE4.2 accelerated KMP search
  *
  * Strategy:
  * 1. Use SIMD to quickly scan for first character matches
  * 2. When found, verify full pattern using scalar KMP
+ *
+ * With anchor > 0, candidates must also match pattern[anchor]
+ * (see find_pair_sse42). T is any 8-, 16- or 32-bit element type whose
+ * equality is bitwise.
  */
-template <typename FailureTable>
-KMP_FORCE_INLINE const char* kmp_search_sse42(
-    const char* text,
+template <typename FailureTable, typename T>
+KMP_FORCE_INLINE const T* kmp_search_sse42(
+    const T* text,
     size_type text_len,
-    const char* pattern,
+    const T* pattern,
     size_type pattern_len,
-    const FailureTable& failure
+    const FailureTable& failure,
+    size_type anchor = 0
 ) noexcept {
     if (pattern_len == 0) {
         return text;
@@ -89,14 +329,16 @@ KMP_FORCE_INLINE const char* kmp_search_sse42(
         return nullptr;
     }
 
-    const char first_char = pattern[0];
-    const char* text_ptr = text;
-    const char* text_end = text + text_len - pattern_len + 1;
+    const T first_char = pattern[0];
+    const T* text_ptr = text;
+    const T* text_end = text + text_len - pattern_len + 1;
 
     while (text_ptr < text_end) {
         // SIMD scan for first character
         size_type remaining = static_cast<size_type>(text_end - text_ptr);
-        const char* match = find_first_char_sse42(text_ptr, remaining, first_char);
+        const T* match = anchor
+            ? find_pair_elem_sse42(text_ptr, remaining, first_char, pattern[anchor], anchor)
+            : find_first_elem_sse42(text_ptr, remaining, first_char);
 
         if (!match) {
             return nullptr;
@@ -125,30 +367,38 @@ KMP_FORCE_INLINE const char* kmp_search_sse42(
 
 /**
  * @brief Find all occurrences using SSE4.2
+ *
+ * Matches overlap unless non_overlapping is set, in which case the scan
+ * resumes after each match (leftmost, non-overlapping matches). Stops
+ * after max_matches matches.
  */
-template <typename FailureTable, typename OutputIt>
+template <typename FailureTable, typename OutputIt, typename T>
 KMP_FORCE_INLINE OutputIt kmp_search_all_sse42(
-    const char* text,
+    const T* text,
     size_type text_len,
-    const char* pattern,
+    const T* pattern,
     size_type pattern_len,
     const FailureTable& failure,
-    OutputIt out
+    OutputIt out,
+    size_type anchor = 0,
+    bool non_overlapping = false,
+    size_type max_matches = static_cast<size_type>(-1)
 ) noexcept {
     if (pattern_len == 0 || text_len < pattern_len) {
         return out;
     }
 
-    const char* pos = text;
-    const char* end = text + text_len;
+    const T* pos = text;
+    const T* end = text + text_len;
 
-    while (pos <= end - pattern_len) {
-        const char* match = kmp_search_sse42(
+    for (size_type found = 0; found < max_matches && pos <= end - pattern_len; ++found) {
+        const T* match = kmp_search_sse42(
             pos,
             static_cast<size_type>(end - pos),
             pattern,
             pattern_len,
-            failure
+            failure,
+            anchor
         );
 
         if (!match) {
@@ -156,12 +406,331 @@ KMP_FORCE_INLINE OutputIt kmp_search_all_sse42(
         }
 
         *out++ = static_cast<size_type>(match - text);
-        pos = match + 1;  // Allow overlapping matches
+        pos = match + (non_overlapping ? pattern_len : 1);
+    }
+
+    return out;
+}
+
+/**
+ * @brief Find last occurrence of character (SSE2 compares, 16 bytes/iteration)
+ *
+ * Scans from the end of the haystack towards the start.
+ */
+KMP_FORCE_INLINE const char* find_last_char_sse42(
+    const char* haystack,
+    size_type haystack_len,
+    char needle_char
+) noexcept {
+    const __m128i needle = _mm_set1_epi8(needle_char);
+    const char* end = haystack + haystack_len;
+
+    while (end - haystack >= 16) {
+        const char* ptr = end - 16;
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+
+        if (mask != 0) {
+            #if defined(_MSC_VER)
+                unsigned long idx;
+                _BitScanReverse(&idx, static_cast<unsigned long>(mask));
+                return ptr + idx;
+            #else
+                return ptr + (31 - __builtin_clz(static_cast<unsigned>(mask)));
+            #endif
+        }
+        end = ptr;
+    }
+
+    while (end > haystack) {
+        --end;
+        if (*end == needle_char) {
+            return end;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief SSE4.2 accelerated reverse KMP search (last occurrence)
+ *
+ * Runs the KMP automaton right to left: scans backwards for the last
+ * pattern byte, verifies towards the start, and shifts with the failure
+ * function of the reversed pattern (compute_reverse_failure()).
+ *
+ * @return Start of the last match, or nullptr
+ */
+template <typename FailureTable>
+KMP_FORCE_INLINE const char* kmp_search_last_sse42(
+    const char* text,
+    size_type text_len,
+    const char* pattern,
+    size_type pattern_len,
+    const FailureTable& reverse_failure
+) noexcept {
+    if (pattern_len == 0) {
+        return text + text_len;
+    }
+    if (text_len < pattern_len) {
+        return nullptr;
+    }
+
+    const char last_char = pattern[pattern_len - 1];
+    // Candidate match ends lie in [text + pattern_len - 1, text_end)
+    const char* lowest_end = text + pattern_len - 1;
+    const char* text_end = text + text_len;
+
+    while (text_end > lowest_end) {
+        size_type remaining = static_cast<size_type>(text_end - lowest_end);
+        const char* match_end = find_last_char_sse42(lowest_end, remaining, last_char);
+
+        if (!match_end) {
+            return nullptr;
+        }
+
+        const char* start = match_end + 1 - pattern_len;
+
+        // Verify from the end of the pattern
+        size_type match_len = 0;
+        while (match_len < pattern_len &&
+               start[pattern_len - 1 - match_len] == pattern[pattern_len - 1 - match_len]) {
+            ++match_len;
+        }
+
+        if (match_len == pattern_len) {
+            return start;
+        }
+
+        // Shift left using the reversed pattern's failure function
+        size_type skip = 1;
+        if (match_len > 0) {
+            skip = match_len - reverse_failure[match_len - 1];
+        }
+
+        text_end = match_end + 1 - skip;
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Masked Literals (Wildcard Bytes)
+// =============================================================================
+
+/**
+ * @brief Whether (a[i] & mask[i]) == bytes[i] for all i < len (SSE2 compares)
+ *
+ * bytes must already be masked. Used to verify wildcard signatures.
+ */
+KMP_FORCE_INLINE bool equal_masked_sse42(
+    const char* a,
+    const char* bytes,
+    const char* mask,
+    size_type len
+) noexcept {
+    size_type i = 0;
+
+    while (i + 16 <= len) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+        __m128i vm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(va, vm), vb)) != 0xFFFF) {
+            return false;
+        }
+        i += 16;
+    }
+
+    for (; i < len; ++i) {
+        if ((a[i] & mask[i]) != bytes[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief First match of a masked literal using SSE4.2
+ *
+ * Candidates come from a scan for the exact byte at offset first (and at
+ * offset second, if second > first); each is verified with
+ * equal_masked_sse42(). Wildcards break the failure function, so the scan
+ * resumes one byte after a rejected candidate.
+ */
+KMP_FORCE_INLINE const char* find_masked_sse42(
+    const char* text,
+    size_type text_len,
+    const char* bytes,
+    const char* mask,
+    size_type pattern_len,
+    size_type first,
+    size_type second
+) noexcept {
+    if (text_len < pattern_len) {
+        return nullptr;
+    }
+
+    const char* ptr = text;
+    const char* end = text + text_len - pattern_len + 1;
+
+    while (ptr < end) {
+        size_type remaining = static_cast<size_type>(end - ptr);
+        const char* hit = second > first
+            ? find_pair_sse42(ptr + first, remaining, bytes[first], bytes[second], second - first)
+            : find_first_char_sse42(ptr + first, remaining, bytes[first]);
+
+        if (!hit) {
+            return nullptr;
+        }
+
+        const char* candidate = hit - first;
+        if (equal_masked_sse42(candidate, bytes, mask, pattern_len)) {
+            return candidate;
+        }
+        ptr = candidate + 1;
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Approximate Matching (Hamming Distance)
+// =============================================================================
+
+/**
+ * @brief Alignments text[j, j + m) for j < 16 within k mismatches (SSE4.2)
+ *
+ * Byte lane j counts the mismatches of alignment j, saturating at 255;
+ * bit j of the result is set when the count is <= k. Reads
+ * text[0, 15 + m). Returns early once every lane exceeds k.
+ */
+KMP_FORCE_INLINE std::uint32_t hamming_block_sse42(
+    const char* text,
+    const char* pattern,
+    size_type pattern_len,
+    std::uint8_t k
+) noexcept {
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(k));
+    __m128i mismatches = _mm_setzero_si128();
+
+    for (size_type i = 0; i < pattern_len; ++i) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        __m128i eq = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(pattern[i]));
+        mismatches = _mm_adds_epu8(mismatches, _mm_andnot_si128(eq, one));
+
+        if ((i & 7) == 7 &&
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(mismatches, limit), mismatches)) == 0) {
+            return 0;
+        }
+    }
+
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(mismatches, limit), mismatches)));
+}
+
+/**
+ * @brief Write every position within k mismatches of pattern to out (SSE4.2)
+ *
+ * k must be below 255 and below pattern_len. Positions too close to the
+ * end for a full block are checked one at a time.
+ */
+template <typename OutputIt>
+OutputIt hamming_search_all_sse42(
+    const char* text,
+    size_type text_len,
+    const char* pattern,
+    size_type pattern_len,
+    std::uint8_t k,
+    OutputIt out
+) {
+    if (text_len < pattern_len) {
+        return out;
+    }
+
+    size_type pos = 0;
+    while (pos + 15 + pattern_len <= text_len) {
+        auto hits = hamming_block_sse42(text + pos, pattern, pattern_len, k);
+        while (hits != 0) {
+            *out++ = pos + static_cast<size_type>(std::countr_zero(hits));
+            hits &= hits - 1;
+        }
+        pos += 16;
+    }
+
+    for (; pos + pattern_len <= text_len; ++pos) {
+        size_type mismatches = 0;
+        for (size_type i = 0; i < pattern_len && mismatches <= k; ++i) {
+            mismatches += text[pos + i] != pattern[i];
+        }
+        if (mismatches <= k) {
+            *out++ = pos;
+        }
     }
 
     return out;
 }
 
+// =============================================================================
+// Sorted Set Intersection
+// =============================================================================
+
+/**
+ * @brief Intersect two strictly increasing uint32 arrays into out (SSE4.2)
+ *
+ * Compares a block of 4 from each array against all 4 rotations of the
+ * other, then advances the block with the smaller maximum (both on a
+ * tie). A value occurs at most once per array, so each common value is
+ * written once. out needs room for min(a_len, b_len) values.
+ *
+ * @return Number of values written
+ */
+inline size_type intersect_sorted_sse42(
+    const std::uint32_t* a,
+    size_type a_len,
+    const std::uint32_t* b,
+    size_type b_len,
+    std::uint32_t* out
+) noexcept {
+    size_type i = 0;
+    size_type j = 0;
+    size_type count = 0;
+
+    while (i + 4 <= a_len && j + 4 <= b_len) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39)));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4E)));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93)));
+
+        auto hits = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+        while (hits != 0) {
+            out[count++] = a[i + static_cast<size_type>(std::countr_zero(hits))];
+            hits &= hits - 1;
+        }
+
+        const std::uint32_t a_max = a[i + 3];
+        const std::uint32_t b_max = b[j + 3];
+        i += a_max <= b_max ? 4 : 0;
+        j += b_max <= a_max ? 4 : 0;
+    }
+
+    while (i < a_len && j < b_len) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            out[count++] = a[i];
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
 } // namespace kmp::detail::simd
 
 #endif // KMP_HAS_SSE42
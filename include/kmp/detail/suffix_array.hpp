@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+ * @file suffix_array.hpp
+ * @brief Suffix array (SA-IS) and LCP array construction
+ *
+ * SA-IS (Nong, Zhang and Chan) sorts the LMS substrings by induced
+ * sorting, names them, recurses on the reduced string when names repeat,
+ * and induces the full order from the sorted LMS suffixes: O(n) time and
+ * a few machine words per byte of extra space.
+ *
+ * The LCP array uses Kärkkäinen's PHI variant of Kasai's algorithm. The
+ * permuted LCP is computed in text order, where lcp(i + 1) >= lcp(i) - 1,
+ * so disjoint text ranges can be processed by independent workers.
+ */
+
+#include "../config.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace kmp::detail {
+
+// =============================================================================
+// SA-IS
+// =============================================================================
+
+/**
+ * @brief Suffix array of s over the alphabet [0, upper]
+ *
+ * Index is a signed type wide enough for s.size(); suffixes are ordered
+ * as if s ended with a sentinel smaller than every symbol.
+ */
+template <typename Index>
+[[nodiscard]] std::vector<Index> sa_is(const std::vector<Index>& s, Index upper) {
+    const auto n = static_cast<Index>(s.size());
+    if (n == 0) {
+        return {};
+    }
+    if (n == 1) {
+        return {0};
+    }
+    if (n == 2) {
+        return s[0] < s[1] ? std::vector<Index>{0, 1} : std::vector<Index>{1, 0};
+    }
+
+    // S-type (true) or L-type suffixes; the last one is L against the sentinel
+    std::vector<bool> ls(static_cast<size_type>(n));
+    for (Index i = n - 2; i >= 0; --i) {
+        ls[i] = s[i] == s[i + 1] ? ls[i + 1] : s[i] < s[i + 1];
+    }
+
+    // Bucket starts: L-type suffixes of symbol c fill [sum_l[c], sum_s[c]),
+    // S-type suffixes [sum_s[c], sum_l[c + 1])
+    std::vector<Index> sum_l(static_cast<size_type>(upper) + 1, 0);
+    std::vector<Index> sum_s(static_cast<size_type>(upper) + 1, 0);
+    for (Index i = 0; i < n; ++i) {
+        if (!ls[i]) {
+            ++sum_s[s[i]];
+        } else {
+            ++sum_l[s[i] + 1];
+        }
+    }
+    for (Index c = 0; c <= upper; ++c) {
+        sum_s[c] += sum_l[c];
+        if (c < upper) {
+            sum_l[c + 1] += sum_s[c];
+        }
+    }
+
+    std::vector<Index> sa(static_cast<size_type>(n));
+    std::vector<Index> bucket(static_cast<size_type>(upper) + 1);
+    auto induce = [&](const std::vector<Index>& lms) {
+        std::fill(sa.begin(), sa.end(), Index{-1});
+
+        std::copy(sum_s.begin(), sum_s.end(), bucket.begin());
+        for (Index d : lms) {
+            if (d != n) {
+                sa[bucket[s[d]]++] = d;
+            }
+        }
+
+        std::copy(sum_l.begin(), sum_l.end(), bucket.begin());
+        sa[bucket[s[n - 1]]++] = n - 1;
+        for (Index i = 0; i < n; ++i) {
+            const Index v = sa[i];
+            if (v >= 1 && !ls[v - 1]) {
+                sa[bucket[s[v - 1]]++] = v - 1;
+            }
+        }
+
+        std::copy(sum_l.begin(), sum_l.end(), bucket.begin());
+        for (Index i = n - 1; i >= 0; --i) {
+            const Index v = sa[i];
+            if (v >= 1 && ls[v - 1]) {
+                sa[--bucket[s[v - 1] + 1]] = v - 1;
+            }
+        }
+    };
+
+    // Leftmost S-type positions, numbered in text order
+    std::vector<Index> lms_index(static_cast<size_type>(n) + 1, Index{-1});
+    std::vector<Index> lms;
+    for (Index i = 1; i < n; ++i) {
+        if (!ls[i - 1] && ls[i]) {
+            lms_index[i] = static_cast<Index>(lms.size());
+            lms.push_back(i);
+        }
+    }
+    const auto m = static_cast<Index>(lms.size());
+
+    induce(lms);
+    if (m == 0) {
+        return sa;
+    }
+
+    // Name the LMS substrings in sorted order; equal substrings share a name
+    std::vector<Index> sorted_lms;
+    sorted_lms.reserve(static_cast<size_type>(m));
+    for (Index v : sa) {
+        if (lms_index[v] != -1) {
+            sorted_lms.push_back(v);
+        }
+    }
+
+    std::vector<Index> reduced(static_cast<size_type>(m));
+    Index names = 0;
+    reduced[lms_index[sorted_lms[0]]] = 0;
+    for (Index i = 1; i < m; ++i) {
+        Index l = sorted_lms[i - 1];
+        Index r = sorted_lms[i];
+        const Index end_l = lms_index[l] + 1 < m ? lms[lms_index[l] + 1] : n;
+        const Index end_r = lms_index[r] + 1 < m ? lms[lms_index[r] + 1] : n;
+
+        bool same = end_l - l == end_r - r;
+        if (same) {
+            while (l < end_l && s[l] == s[r]) {
+                ++l;
+                ++r;
+            }
+            same = l != n && s[l] == s[r];
+        }
+        if (!same) {
+            ++names;
+        }
+        reduced[lms_index[sorted_lms[i]]] = names;
+    }
+
+    // Order of the LMS suffixes, from the reduced problem when names repeat
+    const auto reduced_sa = sa_is(reduced, names);
+    for (Index i = 0; i < m; ++i) {
+        sorted_lms[i] = lms[reduced_sa[i]];
+    }
+    induce(sorted_lms);
+    return sa;
+}
+
+/**
+ * @brief Suffix array of a byte string into out (out.size() == text.size())
+ *
+ * Requires text.size() < 2^32.
+ */
+inline void build_suffix_array(std::string_view text, std::uint32_t* out) {
+    auto build = [&]<typename Index>(Index) {
+        std::vector<Index> s(text.size());
+        for (size_type i = 0; i < text.size(); ++i) {
+            s[i] = static_cast<unsigned char>(text[i]);
+        }
+        const auto sa = sa_is<Index>(s, 255);
+        for (size_type i = 0; i < sa.size(); ++i) {
+            out[i] = static_cast<std::uint32_t>(sa[i]);
+        }
+    };
+
+    if (text.size() < (size_type{1} << 31)) {
+        build(std::int32_t{});
+    } else {
+        build(std::int64_t{});
+    }
+}
+
+// =============================================================================
+// LCP Array
+// =============================================================================
+
+/**
+ * @brief LCP array: lcp[0] = 0, lcp[i] = lcp(suffix sa[i - 1], suffix sa[i])
+ *
+ * phi[p] is the suffix sorted just before p. Its permuted LCP is filled
+ * in place of phi, in text order, by up to `workers` threads on disjoint
+ * ranges; each range restarts the running match length at 0.
+ */
+inline void build_lcp_array(
+    std::string_view text,
+    const std::uint32_t* sa,
+    std::uint32_t* lcp,
+    size_type workers
+) {
+    const size_type n = text.size();
+    if (n == 0) {
+        return;
+    }
+
+    constexpr auto none = static_cast<std::uint32_t>(-1);
+    std::vector<std::uint32_t> plcp(n);
+    plcp[sa[0]] = none;
+    for (size_type i = 1; i < n; ++i) {
+        plcp[sa[i]] = sa[i - 1];
+    }
+
+    auto fill_range = [&](size_type first, size_type last) {
+        size_type h = 0;
+        for (size_type p = first; p < last; ++p) {
+            const std::uint32_t previous = plcp[p];
+            if (previous == none) {
+                plcp[p] = 0;
+                h = 0;
+                continue;
+            }
+            while (p + h < n && previous + h < n && text[p + h] == text[previous + h]) {
+                ++h;
+            }
+            plcp[p] = static_cast<std::uint32_t>(h);
+            if (h > 0) {
+                --h;
+            }
+        }
+    };
+
+    workers = std::max<size_type>(1, workers);
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(workers - 1);
+        const size_type chunk = (n + workers - 1) / workers;
+        for (size_type w = 1; w < workers; ++w) {
+            pool.emplace_back(fill_range, std::min(n, w * chunk), std::min(n, (w + 1) * chunk));
+        }
+        fill_range(0, std::min(n, chunk));
+    }
+
+    for (size_type i = 0; i < n; ++i) {
+        lcp[i] = plcp[sa[i]];
+    }
+}
+
+} // namespace kmp::detail
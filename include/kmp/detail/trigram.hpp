@@ -0,0 +1,552 @@
+#pragma once
+
+/**
+ * @file trigram.hpp
+ * @brief Trigram posting lists and the trigram query planner
+ *
+ * Posting lists hold increasing document ids as LEB128-encoded deltas
+ * (one byte per id for dense lists). Decoded lists are intersected with
+ * the SIMD block-compare kernels, or by galloping when one list is much
+ * shorter than the other.
+ *
+ * The planner turns a regex into trigrams that every match must contain,
+ * in conjunctive normal form: a list of clauses, each satisfied when a
+ * document contains any one of its trigrams. It follows Cox's analysis
+ * (Regular Expression Matching with a Trigram Index): every subexpression
+ * tracks either the exact set of strings it matches, or the possible
+ * prefixes and suffixes of its matches plus the trigrams they require.
+ * Sets are capped; when a cap is hit, information is dropped, so the
+ * query only ever gets weaker, never wrong.
+ */
+
+#include "../config.hpp"
+#include "dfa.hpp"
+#include "simd/dispatch.hpp"
+
+#if KMP_HAS_AVX512
+    #include "simd/avx512.hpp"
+#endif
+#if KMP_HAS_AVX2
+    #include "simd/avx2.hpp"
+#endif
+#if KMP_HAS_SSE42
+    #include "simd/sse42.hpp"
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kmp::detail {
+
+/**
+ * @brief Trigram key: the three bytes big-endian in the low 24 bits
+ */
+[[nodiscard]] constexpr std::uint32_t trigram_key(const char* p) noexcept {
+    return (std::uint32_t{static_cast<unsigned char>(p[0])} << 16) |
+           (std::uint32_t{static_cast<unsigned char>(p[1])} << 8) |
+           std::uint32_t{static_cast<unsigned char>(p[2])};
+}
+
+// Trigram clauses in conjunctive normal form (AND of ORs)
+using trigram_cnf = std::vector<std::vector<std::uint32_t>>;
+
+// =============================================================================
+// Posting Lists
+// =============================================================================
+
+/**
+ * @brief Increasing document ids, delta-encoded as LEB128 varints
+ */
+struct posting_list {
+    std::vector<std::uint8_t> bytes;
+    std::uint32_t count = 0;
+    std::uint32_t last = 0;  // last id appended
+
+    void append(std::uint32_t id) {
+        std::uint32_t delta = count == 0 ? id : id - last;
+        while (delta >= 0x80) {
+            bytes.push_back(static_cast<std::uint8_t>(delta | 0x80));
+            delta >>= 7;
+        }
+        bytes.push_back(static_cast<std::uint8_t>(delta));
+        last = id;
+        ++count;
+    }
+
+    /**
+     * @brief Append the decoded ids to out
+     */
+    void decode(std::vector<std::uint32_t>& out) const {
+        const size_type base = out.size();
+        out.resize(base + count);
+        std::uint32_t* dst = out.data() + base;
+
+        const std::uint8_t* p = bytes.data();
+        std::uint32_t id = 0;
+        for (std::uint32_t k = 0; k < count; ++k) {
+            std::uint32_t delta = *p & 0x7F;
+            for (unsigned shift = 7; *p++ & 0x80; shift += 7) {
+                delta |= std::uint32_t{*p & 0x7Fu} << shift;
+            }
+            id += delta;
+            dst[k] = id;
+        }
+    }
+};
+
+// =============================================================================
+// Intersection
+// =============================================================================
+
+/**
+ * @brief Intersect a short sorted array with a long one by galloping
+ */
+inline size_type intersect_galloping(
+    const std::uint32_t* small,
+    size_type small_len,
+    const std::uint32_t* large,
+    size_type large_len,
+    std::uint32_t* out
+) noexcept {
+    size_type count = 0;
+    size_type lo = 0;
+    for (size_type i = 0; i < small_len && lo < large_len; ++i) {
+        const std::uint32_t value = small[i];
+        size_type step = 1;
+        size_type hi = lo;
+        while (hi < large_len && large[hi] < value) {
+            lo = hi + 1;
+            hi += step;
+            step *= 2;
+        }
+        lo = static_cast<size_type>(
+            std::lower_bound(large + lo, large + std::min(hi + 1, large_len), value) - large);
+        if (lo < large_len && large[lo] == value) {
+            out[count++] = value;
+            ++lo;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Intersect two strictly increasing id arrays into out
+ *
+ * out needs room for min(a_len, b_len) ids and must not alias the inputs.
+ *
+ * @return Number of ids written
+ */
+inline size_type intersect_sorted(
+    const std::uint32_t* a,
+    size_type a_len,
+    const std::uint32_t* b,
+    size_type b_len,
+    std::uint32_t* out
+) noexcept {
+    if (a_len > b_len) {
+        std::swap(a, b);
+        std::swap(a_len, b_len);
+    }
+    if (a_len * config::trigram_gallop_ratio < b_len) {
+        return intersect_galloping(a, a_len, b, b_len, out);
+    }
+
+    #if KMP_HAS_AVX512
+    if (simd::has_avx512()) {
+        return simd::intersect_sorted_avx512(a, a_len, b, b_len, out);
+    }
+    #endif
+    #if KMP_HAS_AVX2
+    if (simd::has_avx2()) {
+        return simd::intersect_sorted_avx2(a, a_len, b, b_len, out);
+    }
+    #endif
+    #if KMP_HAS_SSE42
+    if (simd::has_sse42()) {
+        return simd::intersect_sorted_sse42(a, a_len, b, b_len, out);
+    }
+    #endif
+
+    size_type i = 0;
+    size_type j = 0;
+    size_type count = 0;
+    while (i < a_len && j < b_len) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            out[count++] = a[i];
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
+// =============================================================================
+// Query Planning
+// =============================================================================
+
+/**
+ * @brief Clauses requiring one string of set (some trigram of each) to occur
+ *
+ * Clause k holds trigram k of every string (the last one for shorter
+ * strings). Empty if any string is shorter than 3 bytes: it then
+ * requires nothing.
+ */
+inline void add_set_clauses(trigram_cnf& cnf, const std::vector<std::string>& set) {
+    size_type most = 0;
+    for (const auto& s : set) {
+        if (s.size() < 3) {
+            return;
+        }
+        most = std::max(most, s.size() - 2);
+    }
+    for (size_type k = 0; k < most; ++k) {
+        std::vector<std::uint32_t> clause;
+        clause.reserve(set.size());
+        for (const auto& s : set) {
+            clause.push_back(trigram_key(s.data() + std::min(k, s.size() - 3)));
+        }
+        std::sort(clause.begin(), clause.end());
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        cnf.push_back(std::move(clause));
+    }
+}
+
+/**
+ * @brief Drop clauses implied by another (a superset of a shorter clause)
+ */
+inline void simplify_clauses(trigram_cnf& cnf) {
+    std::sort(cnf.begin(), cnf.end(), [](const auto& x, const auto& y) {
+        return x.size() != y.size() ? x.size() < y.size() : x < y;
+    });
+    cnf.erase(std::unique(cnf.begin(), cnf.end()), cnf.end());
+
+    trigram_cnf kept;
+    for (auto& clause : cnf) {
+        const bool implied = std::any_of(kept.begin(), kept.end(), [&](const auto& shorter) {
+            return std::includes(clause.begin(), clause.end(), shorter.begin(), shorter.end());
+        });
+        if (!implied) {
+            kept.push_back(std::move(clause));
+        }
+    }
+    cnf = std::move(kept);
+}
+
+/**
+ * @brief Required trigrams of a regex, by recursive descent over the same
+ *        grammar as nfa_builder
+ *
+ * The pattern is assumed to compile; unknown constructs require nothing.
+ */
+class trigram_planner {
+public:
+    static constexpr size_type max_set = 16;       // strings per exact/prefix/suffix set
+    static constexpr size_type max_clauses = 64;   // clauses kept when OR-ing queries
+    static constexpr size_type max_class = 8;      // larger classes match "any byte"
+
+    explicit trigram_planner(std::string_view pattern)
+        : pattern_(pattern)
+    {}
+
+    [[nodiscard]] trigram_cnf plan() {
+        size_type pos = 0;
+        auto result = parse_alternation(pos);
+        normalize(result);
+        simplify_clauses(result.match);
+        return std::move(result.match);
+    }
+
+private:
+    struct info {
+        bool exact_known = true;
+        std::vector<std::string> exact;   // every string matched (if exact_known)
+        std::vector<std::string> prefix;  // otherwise: matches start with one of these
+        std::vector<std::string> suffix;  // ... and end with one of these
+        trigram_cnf match;                // required by every match
+    };
+
+    std::string_view pattern_;
+
+    [[nodiscard]] static info literal(std::string s) {
+        info r;
+        r.exact.push_back(std::move(s));
+        return r;
+    }
+
+    [[nodiscard]] static info any() {
+        info r;
+        r.exact_known = false;
+        r.prefix = {""};
+        r.suffix = {""};
+        return r;
+    }
+
+    static void dedupe(std::vector<std::string>& set) {
+        std::sort(set.begin(), set.end());
+        set.erase(std::unique(set.begin(), set.end()), set.end());
+    }
+
+    [[nodiscard]] static std::vector<std::string> cross(
+        const std::vector<std::string>& left,
+        const std::vector<std::string>& right
+    ) {
+        std::vector<std::string> result;
+        result.reserve(left.size() * right.size());
+        for (const auto& l : left) {
+            for (const auto& r : right) {
+                result.push_back(l + r);
+            }
+        }
+        dedupe(result);
+        return result;
+    }
+
+    // Only the 2 bytes next to a boundary can form new trigrams there
+    static void trim(std::vector<std::string>& set, bool keep_front) {
+        for (auto& s : set) {
+            if (s.size() > 2) {
+                s = keep_front ? s.substr(0, 2) : s.substr(s.size() - 2);
+            }
+        }
+        dedupe(set);
+        if (set.size() > max_set) {
+            set = {""};
+        }
+    }
+
+    // Switch x from an exact set to prefix / suffix / required trigrams
+    static void normalize(info& x) {
+        if (!x.exact_known) {
+            return;
+        }
+        add_set_clauses(x.match, x.exact);
+        x.prefix = x.exact;
+        x.suffix = x.exact;
+        trim(x.prefix, true);
+        trim(x.suffix, false);
+        x.exact.clear();
+        x.exact_known = false;
+    }
+
+    [[nodiscard]] static info concat(info x, info y) {
+        if (x.exact_known && y.exact_known && x.exact.size() * y.exact.size() <= max_set) {
+            info r;
+            r.exact = cross(x.exact, y.exact);
+            return r;
+        }
+
+        info r;
+        r.exact_known = false;
+        const auto& left = x.exact_known ? x.exact : x.suffix;
+        const auto& right = y.exact_known ? y.exact : y.prefix;
+        if (left.size() * right.size() <= max_set) {
+            add_set_clauses(r.match, cross(left, right));
+        }
+
+        if (x.exact_known && x.exact.size() * (y.exact_known ? y.exact : y.prefix).size() <= max_set) {
+            r.prefix = cross(x.exact, y.exact_known ? y.exact : y.prefix);
+        } else {
+            r.prefix = x.exact_known ? x.exact : x.prefix;
+        }
+        if (y.exact_known && (x.exact_known ? x.exact : x.suffix).size() * y.exact.size() <= max_set) {
+            r.suffix = cross(x.exact_known ? x.exact : x.suffix, y.exact);
+        } else {
+            r.suffix = y.exact_known ? y.exact : y.suffix;
+        }
+        trim(r.prefix, true);
+        trim(r.suffix, false);
+
+        normalize(x);
+        normalize(y);
+        r.match.insert(r.match.end(), x.match.begin(), x.match.end());
+        r.match.insert(r.match.end(), y.match.begin(), y.match.end());
+        return r;
+    }
+
+    [[nodiscard]] static info alternate(info x, info y) {
+        if (x.exact_known && y.exact_known && x.exact.size() + y.exact.size() <= max_set) {
+            x.exact.insert(x.exact.end(), y.exact.begin(), y.exact.end());
+            dedupe(x.exact);
+            return x;
+        }
+
+        normalize(x);
+        normalize(y);
+        info r;
+        r.exact_known = false;
+        r.prefix = x.prefix;
+        r.prefix.insert(r.prefix.end(), y.prefix.begin(), y.prefix.end());
+        r.suffix = x.suffix;
+        r.suffix.insert(r.suffix.end(), y.suffix.begin(), y.suffix.end());
+        trim(r.prefix, true);
+        trim(r.suffix, false);
+
+        // (x1 & x2 ...) | (y1 & y2 ...) = AND of every (xi | yj); dropping
+        // clauses past the cap only weakens the query
+        if (x.match.empty() || y.match.empty()) {
+            return r;
+        }
+        simplify_clauses(x.match);
+        simplify_clauses(y.match);
+        for (const auto& a : x.match) {
+            for (const auto& b : y.match) {
+                if (r.match.size() == max_clauses) {
+                    return r;
+                }
+                std::vector<std::uint32_t> clause;
+                std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(clause));
+                r.match.push_back(std::move(clause));
+            }
+        }
+        return r;
+    }
+
+    info parse_alternation(size_type& pos) {
+        auto left = parse_concatenation(pos);
+        while (pos < pattern_.size() && pattern_[pos] == '|') {
+            ++pos;
+            left = alternate(std::move(left), parse_concatenation(pos));
+        }
+        return left;
+    }
+
+    info parse_concatenation(size_type& pos) {
+        info result = literal("");
+        while (pos < pattern_.size() && pattern_[pos] != '|' && pattern_[pos] != ')') {
+            result = concat(std::move(result), parse_quantified(pos));
+        }
+        return result;
+    }
+
+    info parse_quantified(size_type& pos) {
+        auto base = parse_atom(pos);
+        if (pos >= pattern_.size()) {
+            return base;
+        }
+        switch (pattern_[pos]) {
+            case '*':
+                ++pos;
+                return any();
+            case '+':
+                // x+ = x x*: x's prefixes and suffixes and required trigrams
+                ++pos;
+                normalize(base);
+                return base;
+            case '?':
+                ++pos;
+                return alternate(std::move(base), literal(""));
+            default:
+                return base;
+        }
+    }
+
+    info parse_atom(size_type& pos) {
+        if (pos >= pattern_.size()) {
+            return any();
+        }
+        const char c = pattern_[pos++];
+        switch (c) {
+            case '(': {
+                auto inner = parse_alternation(pos);
+                if (pos < pattern_.size() && pattern_[pos] == ')') {
+                    ++pos;
+                }
+                return inner;
+            }
+            case '[':
+                return parse_class(pos);
+            case '.':
+                return any();
+            case '^':
+            case '$':
+                return literal("");
+            case '\\':
+                return parse_escape(pos);
+            default:
+                return literal(std::string(1, c));
+        }
+    }
+
+    info parse_escape(size_type& pos) {
+        if (pos >= pattern_.size()) {
+            return any();
+        }
+        const char c = pattern_[pos++];
+        switch (c) {
+            case 'd':
+                return from_class(char_class::digit());
+            case 'w':
+            case 'W':
+            case 's':
+            case 'S':
+            case 'D':
+                return any();
+            case 'b':
+            case 'B':
+                return literal("");
+            default:
+                return literal(std::string(1, c));
+        }
+    }
+
+    info parse_class(size_type& pos) {
+        bool negated = false;
+        if (pos < pattern_.size() && pattern_[pos] == '^') {
+            negated = true;
+            ++pos;
+        }
+
+        char_class cc;
+        while (pos < pattern_.size() && pattern_[pos] != ']') {
+            const char c = pattern_[pos++];
+            if (c == '\\' && pos < pattern_.size()) {
+                const char e = pattern_[pos++];
+                if (e == 'd') {
+                    cc.merge(char_class::digit());
+                } else if (e == 'w') {
+                    cc.merge(char_class::word());
+                } else if (e == 's') {
+                    cc.merge(char_class::space());
+                } else {
+                    cc.set(e);
+                }
+            } else if (pos + 1 < pattern_.size() && pattern_[pos] == '-' &&
+                       pattern_[pos + 1] != ']') {
+                cc.set_range(c, pattern_[pos + 1]);
+                pos += 2;
+            } else {
+                cc.set(c);
+            }
+        }
+        if (pos < pattern_.size()) {
+            ++pos;  // consume ']'
+        }
+        if (negated) {
+            cc.flip();
+        }
+        return from_class(cc);
+    }
+
+    [[nodiscard]] static info from_class(const char_class& cc) {
+        info r;
+        for (unsigned c = 0; c < char_class::size; ++c) {
+            if (cc.test(static_cast<char>(c))) {
+                if (r.exact.size() == max_class) {
+                    return any();
+                }
+                r.exact.emplace_back(1, static_cast<char>(c));
+            }
+        }
+        return r;
+    }
+};
+
+} // namespace kmp::detail
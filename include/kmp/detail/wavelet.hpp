@@ -0,0 +1,199 @@
+#pragma once
+
+/**
+ * @file wavelet.hpp
+ * @brief Rank bitvector and wavelet matrix for compressed indexes
+ *
+ * rank_bitvector answers rank in O(1) with hardware popcount: every
+ * 512-bit block stores its cumulative count plus seven 9-bit counts
+ * relative to the block start (Vigna's rank9), 25% over the raw bits.
+ *
+ * wavelet_matrix stores a sequence over an alphabet of 2^levels symbols
+ * as one bitvector per bit of the symbol, each level stably partitioned
+ * by the previous bit. access() and rank() cost O(levels) bitvector ranks.
+ */
+
+#include "../config.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace kmp::detail {
+
+// =============================================================================
+// Rank Bitvector
+// =============================================================================
+
+/**
+ * @brief Bitvector with constant-time rank (set bits, then build())
+ */
+class rank_bitvector {
+public:
+    rank_bitvector() = default;
+
+    explicit rank_bitvector(size_type size)
+        : size_(size)
+        , words_(size / 64 + 1, 0)
+    {}
+
+    void set(size_type i) noexcept {
+        words_[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+
+    /**
+     * @brief Compute the rank directory; call after the last set()
+     */
+    void build() {
+        const size_type blocks = (words_.size() + 7) / 8;
+        directory_.assign(2 * blocks, 0);
+
+        std::uint64_t total = 0;
+        for (size_type b = 0; b < blocks; ++b) {
+            directory_[2 * b] = total;
+            std::uint64_t relative = 0;
+            std::uint64_t packed = 0;
+            for (size_type w = 0; w < 8 && 8 * b + w < words_.size(); ++w) {
+                if (w > 0) {
+                    packed |= relative << (9 * (w - 1));
+                }
+                relative += static_cast<std::uint64_t>(std::popcount(words_[8 * b + w]));
+            }
+            directory_[2 * b + 1] = packed;
+            total += relative;
+        }
+        ones_ = static_cast<size_type>(total);
+    }
+
+    [[nodiscard]] bool test(size_type i) const noexcept {
+        return (words_[i / 64] >> (i % 64)) & 1;
+    }
+
+    /**
+     * @brief Set bits in [0, i), for i <= size()
+     */
+    [[nodiscard]] size_type rank1(size_type i) const noexcept {
+        const size_type word = i / 64;
+        const size_type block = word / 8;
+        const size_type sub = word % 8;
+
+        std::uint64_t rank = directory_[2 * block];
+        if (sub > 0) {
+            rank += (directory_[2 * block + 1] >> (9 * (sub - 1))) & 0x1FF;
+        }
+        const std::uint64_t below = (std::uint64_t{1} << (i % 64)) - 1;
+        rank += static_cast<std::uint64_t>(std::popcount(words_[word] & below));
+        return static_cast<size_type>(rank);
+    }
+
+    [[nodiscard]] size_type rank0(size_type i) const noexcept {
+        return i - rank1(i);
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] size_type ones() const noexcept { return ones_; }
+
+    [[nodiscard]] size_type memory_bytes() const noexcept {
+        return (words_.size() + directory_.size()) * sizeof(std::uint64_t);
+    }
+
+private:
+    size_type size_ = 0;
+    size_type ones_ = 0;
+    std::vector<std::uint64_t> words_;      // one spare word so rank1(size_) is valid
+    std::vector<std::uint64_t> directory_;  // per 512 bits: cumulative, packed relative
+};
+
+// =============================================================================
+// Wavelet Matrix
+// =============================================================================
+
+/**
+ * @brief Sequence of symbols below 2^levels with access and rank
+ *
+ * Level l holds bit (levels - 1 - l) of every symbol, in the order left
+ * by level l - 1: symbols with a 0 bit first, then those with a 1 bit.
+ */
+class wavelet_matrix {
+public:
+    wavelet_matrix() = default;
+
+    wavelet_matrix(std::vector<std::uint8_t> symbols, unsigned levels)
+        : size_(symbols.size())
+        , levels_(levels)
+        , bits_(levels)
+        , zeros_(levels)
+    {
+        std::vector<std::uint8_t> next(symbols.size());
+        for (unsigned l = 0; l < levels; ++l) {
+            const unsigned shift = levels - 1 - l;
+            rank_bitvector bits(size_);
+            for (size_type i = 0; i < size_; ++i) {
+                if ((symbols[i] >> shift) & 1) {
+                    bits.set(i);
+                }
+            }
+            bits.build();
+            zeros_[l] = size_ - bits.ones();
+
+            size_type zero = 0;
+            size_type one = zeros_[l];
+            for (size_type i = 0; i < size_; ++i) {
+                next[(symbols[i] >> shift) & 1 ? one++ : zero++] = symbols[i];
+            }
+            symbols.swap(next);
+            bits_[l] = std::move(bits);
+        }
+    }
+
+    /**
+     * @brief Symbol at position i
+     */
+    [[nodiscard]] std::uint8_t access(size_type i) const noexcept {
+        unsigned symbol = 0;
+        for (unsigned l = 0; l < levels_; ++l) {
+            const bool bit = bits_[l].test(i);
+            symbol = (symbol << 1) | static_cast<unsigned>(bit);
+            i = bit ? zeros_[l] + bits_[l].rank1(i) : bits_[l].rank0(i);
+        }
+        return static_cast<std::uint8_t>(symbol);
+    }
+
+    /**
+     * @brief Occurrences of symbol in [0, i)
+     *
+     * Follows both 0 and i down the levels; they end at the start of the
+     * symbol's block and i's position within it.
+     */
+    [[nodiscard]] size_type rank(std::uint8_t symbol, size_type i) const noexcept {
+        size_type start = 0;
+        for (unsigned l = 0; l < levels_; ++l) {
+            if ((symbol >> (levels_ - 1 - l)) & 1) {
+                start = zeros_[l] + bits_[l].rank1(start);
+                i = zeros_[l] + bits_[l].rank1(i);
+            } else {
+                start = bits_[l].rank0(start);
+                i = bits_[l].rank0(i);
+            }
+        }
+        return i - start;
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+
+    [[nodiscard]] size_type memory_bytes() const noexcept {
+        size_type bytes = 0;
+        for (const auto& bits : bits_) {
+            bytes += bits.memory_bytes();
+        }
+        return bytes;
+    }
+
+private:
+    size_type size_ = 0;
+    unsigned levels_ = 0;
+    std::vector<rank_bitvector> bits_;
+    std::vector<size_type> zeros_;  // zero bits per level
+};
+
+} // namespace kmp::detail
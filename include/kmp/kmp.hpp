@@ -55,6 +55,27 @@
 // Pattern types (literal and regex)
 #include "pattern.hpp"
 
+// Opt-in cache of compiled regexes
+#include "regex_cache.hpp"
+
+// Approximate search (Hamming / edit distance)
+#include "approx.hpp"
+
+// Suffix-array index for repeated queries
+#include "text_index.hpp"
+
+// Compressed (FM) index for large corpora
+#include "fm_index.hpp"
+
+// Trigram inverted index over many documents
+#include "trigram_index.hpp"
+
+// Suffix automaton for a growing corpus
+#include "suffix_automaton.hpp"
+
+// Incremental re-search of an edited text
+#include "match_tracker.hpp"
+
 // Additional namespace-level documentation
 namespace kmp {
 
@@ -66,24 +87,50 @@ namespace kmp {
  *
  * **Search Functions:**
  *   - search()       - Find first occurrence
- *   - search_pos()   - Find first occurrence (returns position)
+ *   - search_pos()   - Find first occurrence (returns position; optional [from, to) window)
+ *   - search_n()     - Find the first k occurrences (stops early)
+ *   - search_all_into() - Write occurrences into a caller buffer (resumable)
+ *   - search_segmented() / search_all_segmented() - Search chunked text (ropes, buffers)
  *   - search_all()   - Find all occurrences (generator)
  *   - search_all_vec() - Find all occurrences (vector)
  *   - count()        - Count occurrences
+ *   (search_pos(), search_all_vec() and count() also take std::byte,
+ *    char16_t, std::uint32_t, ... sequences; see element_sequence)
+ *   (patterns up to 64 bytes over small-alphabet text use a Shift-Or scan)
  *   - contains()     - Check if pattern exists
+ *   - search_last()  - Find last occurrence (reverse KMP)
+ *   - rfind()        - Find last occurrence (returns position)
+ *   - replace_all()  - Replace non-overlapping occurrences
+ *   - approx_search() - Find matches within k mismatches or edits
  *
  * **Pattern Types:**
  *   - literal_pattern - Pre-compiled literal pattern
- *   - regex_pattern   - Compiled regex (DFA)
+ *   - literal_pattern_view - Non-owning literal (arena dictionaries)
+ *   - masked_pattern  - Literal with wildcard bytes (binary signatures)
+ *   - text_index      - Suffix-array index over a static text (count, contains, search_all)
+ *   - fm_index        - Compressed BWT index (O(m) count, sampled positions)
+ *   - trigram_index   - Document collection with trigram postings (literal and regex search)
+ *   - trigram_query   - Required trigrams of a literal or regex (query planner)
+ *   - suffix_automaton - Append-only substring index (count, first occurrence, LCS)
+ *   - match_tracker<> - Text buffer whose matches are updated per edit
+ *   - regex_pattern   - Compiled regex (DFA; find() with groups, replace_all())
+ *   - regex_scratch   - Reusable working memory for regex groups and replacement
  *   - compiled_pattern<> - Compile-time pattern
+ *   - compiled_regex<>   - Compile-time regex (constexpr DFA)
  *
  * **Factory Functions:**
  *   - compile<"pattern">() - Create compile-time pattern
  *   - compile_literal()    - Create runtime literal pattern
+ *   - compile_masked()     - Parse a wildcard signature ("48 8B ?? ?? 89 45")
+ *   - compile_literals_into() - Compile a dictionary into a caller arena
+ *   - compile_literals()   - Compile a dictionary in parallel (literal_set)
  *   - compile_regex()      - Create runtime regex pattern
+ *   - compile_regex<"re">() - Create compile-time regex
+ *   - compile_regex_cached() - Runtime regex through the LRU regex_cache
  *
  * @see search.hpp for search functions
  * @see pattern.hpp for pattern types
+ * @see approx.hpp for approximate search
  */
 
 } // namespace kmp
@@ -0,0 +1,290 @@
+#pragma once
+
+/**
+ * @file match_tracker.hpp
+ * @brief Match positions kept up to date while a text is edited
+ *
+ * Re-running search_all_vec() after every keystroke costs the whole
+ * document. match_tracker owns the text and its match set; an edit only
+ * rescans the starts it can affect:
+ *   - literals: the m - 1 bytes on each side of the edit
+ *   - regexes: back to the earliest start whose DFA scan was still
+ *     running at the edit (compiled_dfa::resync_start), forward until
+ *     the rescanned scans end
+ *
+ * The text lives in a gap buffer with the gap at the last edit. Matches
+ * before the edit point are stored as positions, those after it as
+ * distances from the end of the text, so neither side shifts. Moving the
+ * gap and the split costs the distance moved, which stays small while
+ * edits stay near each other.
+ *
+ * Usage:
+ *   kmp::match_tracker tracker(document, kmp::literal_pattern("TODO"));
+ *   tracker.apply_edit(offset, 0, "x");   // a keystroke
+ *   auto hits = tracker.matches();
+ */
+
+#include "config.hpp"
+#include "pattern.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kmp {
+
+// =============================================================================
+// Match Tracker
+// =============================================================================
+
+/**
+ * @brief A text buffer and the start positions of its matches
+ *
+ * Pattern is literal_pattern (overlapping occurrences, as
+ * search_all_vec() reports them) or regex_pattern (positions where a
+ * match starts, as regex_pattern::search_n() reports them). Const
+ * accessors may run concurrently; apply_edit() needs exclusive access.
+ */
+template <typename Pattern>
+class match_tracker {
+    static_assert(std::same_as<Pattern, literal_pattern> || std::same_as<Pattern, regex_pattern>,
+                  "match_tracker tracks a literal_pattern or a regex_pattern");
+
+public:
+    match_tracker(std::string_view text, Pattern pattern)
+        : pattern_(std::move(pattern))
+        , buffer_(text.size() + config::tracker_gap_bytes, '\0')
+        , gap_begin_(text.size())
+        , gap_end_(buffer_.size())
+    {
+        std::copy(text.begin(), text.end(), buffer_.data());
+        if constexpr (std::same_as<Pattern, literal_pattern>) {
+            before_ = search_all_vec(text, pattern_.pattern());
+        } else {
+            before_ = pattern_.search_n(text, text.size());
+        }
+        split_ = text.size();
+    }
+
+    // =========================================================================
+    // Editing
+    // =========================================================================
+
+    /**
+     * @brief Replace removed bytes at offset with inserted, then update
+     *        the matches
+     *
+     * @throws std::out_of_range if [offset, offset + removed) is outside
+     *         the text
+     */
+    void apply_edit(size_type offset, size_type removed, std::string_view inserted) {
+        const size_type old_size = size();
+        if (offset > old_size || removed > old_size - offset) {
+            throw std::out_of_range("match_tracker edit outside the text");
+        }
+
+        if constexpr (std::same_as<Pattern, literal_pattern>) {
+            edit_literal(offset, removed, inserted);
+        } else {
+            edit_regex(offset, removed, inserted);
+        }
+    }
+
+    // =========================================================================
+    // Accessors
+    // =========================================================================
+
+    [[nodiscard]] size_type size() const noexcept {
+        return buffer_.size() - (gap_end_ - gap_begin_);
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] const Pattern& pattern() const noexcept { return pattern_; }
+
+    /**
+     * @brief Copy of the current text
+     */
+    [[nodiscard]] std::string text() const {
+        std::string result;
+        result.reserve(size());
+        result.append(buffer_.data(), gap_begin_);
+        result.append(buffer_.data() + gap_end_, buffer_.size() - gap_end_);
+        return result;
+    }
+
+    [[nodiscard]] char operator[](size_type pos) const noexcept {
+        return pos < gap_begin_ ? buffer_[pos] : buffer_[pos + (gap_end_ - gap_begin_)];
+    }
+
+    [[nodiscard]] size_type match_count() const noexcept {
+        return before_.size() + after_.size();
+    }
+
+    /**
+     * @brief All match positions, in increasing order
+     */
+    [[nodiscard]] std::vector<size_type> matches() const {
+        return matches(0, size());
+    }
+
+    /**
+     * @brief Match positions in [from, to), in increasing order (e.g. the
+     *        visible lines of an editor)
+     */
+    [[nodiscard]] std::vector<size_type> matches(size_type from, size_type to) const {
+        std::vector<size_type> result;
+        const size_type n = size();
+        to = std::min(to, n);
+        if (from >= to) {
+            return result;
+        }
+
+        auto first = std::lower_bound(before_.begin(), before_.end(), from);
+        auto last = std::lower_bound(first, before_.end(), to);
+        result.assign(first, last);
+
+        // after_ holds distances from the end, so [from, to) is the
+        // distances (n - to, n - from], walked backwards
+        auto leftmost = std::upper_bound(after_.begin(), after_.end(), n - from);
+        auto rightmost = std::upper_bound(after_.begin(), after_.end(), n - to);
+        for (auto it = leftmost; it != rightmost;) {
+            --it;
+            result.push_back(n - *it);
+        }
+        return result;
+    }
+
+private:
+    Pattern pattern_;
+    std::string buffer_;               // text with a gap at [gap_begin_, gap_end_)
+    size_type gap_begin_ = 0;
+    size_type gap_end_ = 0;
+    std::vector<size_type> before_;    // matches < split_, ascending
+    std::vector<size_type> after_;     // matches >= split_, as size() - position, ascending
+    size_type split_ = 0;
+
+    // Text before the gap, contiguous
+    [[nodiscard]] std::string_view prefix() const noexcept {
+        return {buffer_.data(), gap_begin_};
+    }
+
+    void move_gap(size_type pos) {
+        if (pos < gap_begin_) {
+            const size_type count = gap_begin_ - pos;
+            std::memmove(buffer_.data() + gap_end_ - count, buffer_.data() + pos, count);
+            gap_begin_ -= count;
+            gap_end_ -= count;
+        } else if (pos > gap_begin_) {
+            const size_type count = pos - gap_begin_;
+            std::memmove(buffer_.data() + gap_begin_, buffer_.data() + gap_end_, count);
+            gap_begin_ += count;
+            gap_end_ += count;
+        }
+    }
+
+    // Replace [gap_begin_, gap_begin_ + removed) with inserted; the gap
+    // ends up after the inserted bytes
+    void replace_at_gap(size_type removed, std::string_view inserted) {
+        gap_end_ += removed;
+        if (gap_end_ - gap_begin_ < inserted.size()) {
+            const size_type tail = buffer_.size() - gap_end_;
+            const size_type capacity = std::max(
+                buffer_.size() * 2, gap_begin_ + inserted.size() + tail + config::tracker_gap_bytes);
+            std::string grown(capacity, '\0');
+            std::memcpy(grown.data(), buffer_.data(), gap_begin_);
+            std::memcpy(grown.data() + capacity - tail, buffer_.data() + gap_end_, tail);
+            buffer_.swap(grown);
+            gap_end_ = capacity - tail;
+        }
+        std::copy(inserted.begin(), inserted.end(), buffer_.data() + gap_begin_);
+        gap_begin_ += inserted.size();
+    }
+
+    // Move matches between before_ and after_ so that split_ == pos
+    void move_split(size_type pos) {
+        const size_type n = size();
+        while (!before_.empty() && before_.back() >= pos) {
+            after_.push_back(n - before_.back());
+            before_.pop_back();
+        }
+        while (!after_.empty() && n - after_.back() < pos) {
+            before_.push_back(n - after_.back());
+            after_.pop_back();
+        }
+        split_ = pos;
+    }
+
+    // Drop matches in [split_, end) of the text before the edit
+    void drop_until(size_type end) {
+        const size_type n = size();
+        while (!after_.empty() && n - after_.back() < end) {
+            after_.pop_back();
+        }
+    }
+
+    void edit_literal(size_type offset, size_type removed, std::string_view inserted) {
+        const size_type m = pattern_.size();
+        const size_type lo = offset - std::min(offset, m == 0 ? 0 : m - 1);
+
+        // A match starting in [lo, offset + removed) overlaps the edit
+        move_split(lo);
+        drop_until(offset + removed);
+        move_gap(offset);
+        replace_at_gap(removed, inserted);
+        if (m == 0) {
+            return;
+        }
+
+        // New matches start in [lo, offset + inserted) and end by window_end
+        const size_type edit_end = offset + inserted.size();
+        const size_type window_end = std::min(size(), edit_end + m - 1);
+        move_gap(window_end);
+        const std::string_view text = prefix();
+        for (auto pos = search_pos(text, pattern_, lo, window_end); pos;
+             pos = search_pos(text, pattern_, *pos + 1, window_end)) {
+            before_.push_back(*pos);
+        }
+        split_ = edit_end;
+    }
+
+    void edit_regex(size_type offset, size_type removed, std::string_view inserted) {
+        if (pattern_.empty()) {
+            move_gap(offset);
+            replace_at_gap(removed, inserted);
+            return;
+        }
+        const detail::compiled_dfa& dfa = *pattern_.dfa_;
+
+        // Scans from lo onwards may have read the edited bytes; a start at
+        // offset + removed also reads the byte before it (for \b)
+        move_gap(offset);
+        const size_type lo = dfa.resync_start(prefix());
+        move_split(lo);
+        drop_until(offset + removed + 1);
+        replace_at_gap(removed, inserted);
+
+        // Rescan starts [lo, offset + inserted], widening the contiguous
+        // prefix while a scan runs past it
+        const size_type n = size();
+        const size_type edit_end = offset + inserted.size();
+        const size_type last = std::min(edit_end + 1, n);
+        for (size_type pos = lo; pos < last; ++pos) {
+            std::optional<bool> found;
+            while (!(found = dfa.match_at(prefix(), pos, gap_begin_ == n))) {
+                move_gap(std::min(n, gap_begin_ + std::max<size_type>(gap_begin_ - pos, 64)));
+            }
+            if (*found) {
+                before_.push_back(pos);
+            }
+        }
+        split_ = last;
+    }
+};
+
+} // namespace kmp
@@ -6,21 +6,110 @@
  *
  * Provides:
  *   - literal_pattern: For exact string matching (pure KMP)
+ *   - literal_pattern_view: Non-owning literal (arena dictionaries)
+ *   - masked_pattern: Literal with wildcard bytes (binary signatures)
  *   - regex_pattern: For regex matching (DFA engine)
  *   - compile<"pattern">(): Compile-time pattern
+ *   - compile_regex<"regex">(): Compile-time regex DFA
  */
 
 #include "config.hpp"
+#include "search.hpp"
 #include "detail/failure.hpp"
+#include "detail/literal.hpp"
+#include "detail/masked.hpp"
 #include "detail/dfa.hpp"
+#include "detail/capture.hpp"
 
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace kmp {
 
+// =============================================================================
+// Literal Pattern View (Non-owning)
+// =============================================================================
+
+/**
+ * @brief Non-owning reference to a compiled literal
+ *
+ * Points at pattern bytes and a failure table owned elsewhere: a
+ * literal_pattern, or an arena filled by compile_literals_into() (which
+ * may be mmapped). Cheap to copy; the storage must outlive the view.
+ */
+class literal_pattern_view {
+public:
+    constexpr literal_pattern_view() = default;
+
+    literal_pattern_view(
+        std::string_view pattern,
+        const detail::failure_table& failure,
+        size_type anchor
+    ) noexcept
+        : pattern_(pattern)
+        , failure_(failure)
+        , anchor_(static_cast<std::uint32_t>(anchor))
+    {}
+
+    /**
+     * @brief View a compiled block (pattern bytes then failure table)
+     *
+     * The layout is the one written by compile_literals_into(); block must
+     * be 4-byte aligned. The anchor is recomputed from the pattern bytes.
+     */
+    [[nodiscard]] static literal_pattern_view from_block(const std::byte* block, size_type size) noexcept {
+        const auto layout = detail::literal_layout::compute(size);
+        std::string_view pattern{reinterpret_cast<const char*>(block), size};
+        return {pattern, {block + layout.failure_offset, size, layout.width},
+                detail::select_anchor(pattern)};
+    }
+
+    /**
+     * @brief Compile pattern into block and view the result
+     *
+     * block must hold literal_layout::compute(pattern.size()).padded_total()
+     * bytes and be 4-byte aligned.
+     */
+    [[nodiscard]] static literal_pattern_view write(std::string_view pattern, std::byte* block) noexcept {
+        auto failure = detail::write_literal(pattern, block);
+        return {{reinterpret_cast<const char*>(block), pattern.size()},
+                failure, detail::select_anchor(pattern)};
+    }
+
+    [[nodiscard]] std::string_view pattern() const noexcept { return pattern_; }
+    [[nodiscard]] const detail::failure_table& failure() const noexcept { return failure_; }
+    [[nodiscard]] size_type size() const noexcept { return pattern_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return pattern_.empty(); }
+    [[nodiscard]] size_type anchor() const noexcept { return anchor_; }
+
+    [[nodiscard]] char operator[](size_type i) const noexcept {
+        return pattern_[i];
+    }
+
+    [[nodiscard]] auto begin() const noexcept { return pattern_.begin(); }
+    [[nodiscard]] auto end() const noexcept { return pattern_.end(); }
+
+private:
+    std::string_view pattern_;
+    detail::failure_table failure_;
+    std::uint32_t anchor_ = 0;
+};
+
 // =============================================================================
 // Literal Pattern (Pure KMP)
 // =============================================================================
@@ -30,58 +119,438 @@ namespace kmp {
  *
  * Pre-computes the failure function once, allowing efficient
  * multiple searches with the same pattern.
+ *
+ * Pattern bytes and a compact failure table (1, 2 or 4 bytes per entry)
+ * share one block, which is stored inline for short patterns (no
+ * allocation) and as a single heap allocation otherwise. The SIMD anchor,
+ * the rarest byte checked alongside the first, is chosen at construction.
  */
 class literal_pattern {
 public:
-    literal_pattern() = default;
+    // Block bytes that fit without allocating (patterns up to 24 bytes)
+    static constexpr size_type inline_capacity = 48;
+
+    literal_pattern() noexcept
+        : inline_{}
+    {}
 
     explicit literal_pattern(const char* pattern)
-        : pattern_(pattern)
-        , failure_(detail::compute_failure(pattern_.begin(), pattern_.end()))
+        : literal_pattern(std::string_view{pattern})
     {}
 
-    explicit literal_pattern(std::string pattern)
-        : pattern_(std::move(pattern))
-        , failure_(detail::compute_failure(pattern_.begin(), pattern_.end()))
+    explicit literal_pattern(const std::string& pattern)
+        : literal_pattern(std::string_view{pattern})
     {}
 
+    /**
+     * @throws std::length_error if the pattern exceeds 4 GiB
+     */
     explicit literal_pattern(std::string_view pattern)
-        : pattern_(pattern)
-        , failure_(detail::compute_failure(pattern_.begin(), pattern_.end()))
-    {}
+        : inline_{}
+    {
+        if (pattern.size() > detail::literal_layout::max_size) {
+            throw std::length_error("Pattern too long");
+        }
+        std::byte* block = allocate(pattern.size());
+        failure_ = detail::write_literal(pattern, block);
+        anchor_ = static_cast<std::uint32_t>(detail::select_anchor(pattern));
+    }
+
+    literal_pattern(const literal_pattern& other)
+        : inline_{}
+        , anchor_(other.anchor_)
+    {
+        const size_type m = other.size();
+        std::byte* block = allocate(m);
+        if (is_inline_) {
+            std::memcpy(inline_, other.inline_, sizeof(inline_));
+        } else {
+            std::memcpy(block, other.heap_, detail::literal_layout::compute(m).total);
+        }
+        bind(block, m);
+    }
+
+    literal_pattern(literal_pattern&& other) noexcept
+        : inline_{}
+    {
+        take(other);
+    }
+
+    literal_pattern& operator=(const literal_pattern& other) {
+        if (this != &other) {
+            literal_pattern copy(other);
+            release();
+            take(copy);
+        }
+        return *this;
+    }
+
+    literal_pattern& operator=(literal_pattern&& other) noexcept {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~literal_pattern() {
+        release();
+    }
 
     [[nodiscard]] std::string_view pattern() const noexcept {
-        return pattern_;
+        return {reinterpret_cast<const char*>(block()), size()};
     }
 
-    [[nodiscard]] const std::vector<size_type>& failure() const noexcept {
+    [[nodiscard]] const detail::failure_table& failure() const noexcept {
         return failure_;
     }
 
     [[nodiscard]] size_type size() const noexcept {
-        return pattern_.size();
+        return failure_.size();
     }
 
     [[nodiscard]] bool empty() const noexcept {
-        return pattern_.empty();
+        return failure_.empty();
+    }
+
+    /**
+     * @brief Offset of the byte the SIMD scan checks with the first (0 if none)
+     */
+    [[nodiscard]] size_type anchor() const noexcept {
+        return anchor_;
+    }
+
+    /**
+     * @brief Whether the block is stored in the object (no allocation)
+     */
+    [[nodiscard]] bool is_inline() const noexcept {
+        return is_inline_;
     }
 
     [[nodiscard]] char operator[](size_type i) const noexcept {
-        return pattern_[i];
+        return pattern()[i];
     }
 
-    [[nodiscard]] auto begin() const noexcept { return pattern_.begin(); }
-    [[nodiscard]] auto end() const noexcept { return pattern_.end(); }
+    [[nodiscard]] auto begin() const noexcept { return pattern().begin(); }
+    [[nodiscard]] auto end() const noexcept { return pattern().end(); }
+
+    /**
+     * @brief Non-owning view; valid while this pattern is alive and unmodified
+     */
+    [[nodiscard]] literal_pattern_view view() const noexcept {
+        return {pattern(), failure_, anchor_};
+    }
 
 private:
-    std::string pattern_;
-    std::vector<size_type> failure_;
+    union {
+        std::uint64_t* heap_;
+        std::uint64_t inline_[inline_capacity / sizeof(std::uint64_t)];
+    };
+    detail::failure_table failure_;  // also records size and entry width
+    std::uint32_t anchor_ = 0;
+    bool is_inline_ = true;
+
+    [[nodiscard]] const std::byte* block() const noexcept {
+        return reinterpret_cast<const std::byte*>(is_inline_ ? inline_ : heap_);
+    }
+
+    std::byte* allocate(size_type m) {
+        const size_type total = detail::literal_layout::compute(m).total;
+        is_inline_ = total <= inline_capacity;
+        if (is_inline_) {
+            return reinterpret_cast<std::byte*>(inline_);
+        }
+        heap_ = new std::uint64_t[(total + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)];
+        return reinterpret_cast<std::byte*>(heap_);
+    }
+
+    void bind(const std::byte* block, size_type m) noexcept {
+        const auto layout = detail::literal_layout::compute(m);
+        failure_ = {block + layout.failure_offset, m, layout.width};
+    }
+
+    void release() noexcept {
+        if (!is_inline_) {
+            delete[] heap_;
+        }
+        is_inline_ = true;
+        failure_ = {};
+        anchor_ = 0;
+    }
+
+    // Steal other's block, leaving it empty
+    void take(literal_pattern& other) noexcept {
+        const size_type m = other.size();
+        anchor_ = other.anchor_;
+        is_inline_ = other.is_inline_;
+        if (is_inline_) {
+            std::memcpy(inline_, other.inline_, sizeof(inline_));
+        } else {
+            heap_ = other.heap_;
+            other.is_inline_ = true;
+        }
+        bind(block(), m);
+        other.failure_ = {};
+        other.anchor_ = 0;
+    }
+};
+
+// =============================================================================
+// Literal Dictionaries (Arena Storage)
+// =============================================================================
+
+/**
+ * @brief Arena bytes needed by compile_literals_into() for these patterns
+ */
+[[nodiscard]] inline size_type literal_arena_size(std::span<const std::string_view> patterns) noexcept {
+    size_type total = 0;
+    for (auto pattern : patterns) {
+        total += detail::literal_layout::compute(pattern.size()).padded_total();
+    }
+    return total;
+}
+
+/**
+ * @brief Compile many literals into one caller-supplied arena
+ *
+ * Each pattern's block (bytes, then failure table) is written back to back
+ * at 4-byte alignment, and out[i] is set to a view of pattern i. Nothing
+ * is allocated. Blocks can be reopened later with
+ * literal_pattern_view::from_block().
+ *
+ * @return Bytes of the arena used (literal_arena_size(patterns))
+ * @throws std::runtime_error if out is shorter than patterns, or the arena
+ *         is too small or not 4-byte aligned
+ */
+inline size_type compile_literals_into(
+    std::span<const std::string_view> patterns,
+    std::span<std::byte> arena,
+    std::span<literal_pattern_view> out
+) {
+    if (out.size() < patterns.size()) {
+        throw std::runtime_error("Output span smaller than pattern list");
+    }
+    if (reinterpret_cast<std::uintptr_t>(arena.data()) % alignof(std::uint32_t) != 0) {
+        throw std::runtime_error("Literal arena must be 4-byte aligned");
+    }
+    if (arena.size() < literal_arena_size(patterns)) {
+        throw std::runtime_error("Literal arena too small");
+    }
+
+    size_type offset = 0;
+    for (size_type i = 0; i < patterns.size(); ++i) {
+        const auto pattern = patterns[i];
+        if (pattern.size() > detail::literal_layout::max_size) {
+            throw std::length_error("Pattern too long");
+        }
+        out[i] = literal_pattern_view::write(pattern, arena.data() + offset);
+        offset += detail::literal_layout::compute(pattern.size()).padded_total();
+    }
+    return offset;
+}
+
+/**
+ * @brief Literals compiled by compile_literals(): one arena plus views
+ *
+ * Move-only. The views stay valid as long as the set is alive.
+ */
+class literal_set {
+public:
+    literal_set() = default;
+
+    [[nodiscard]] size_type size() const noexcept { return views_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return views_.empty(); }
+
+    [[nodiscard]] const literal_pattern_view& operator[](size_type i) const noexcept {
+        return views_[i];
+    }
+
+    [[nodiscard]] auto begin() const noexcept { return views_.begin(); }
+    [[nodiscard]] auto end() const noexcept { return views_.end(); }
+
+    [[nodiscard]] std::span<const literal_pattern_view> views() const noexcept {
+        return views_;
+    }
+
+    /**
+     * @brief The arena holding every block (see literal_pattern_view::from_block())
+     */
+    [[nodiscard]] std::span<const std::byte> arena() const noexcept {
+        return {reinterpret_cast<const std::byte*>(arena_.get()), arena_size_};
+    }
+
+private:
+    friend literal_set compile_literals(std::span<const std::string_view>, unsigned);
+
+    std::unique_ptr<std::uint32_t[]> arena_;
+    size_type arena_size_ = 0;
+    std::vector<literal_pattern_view> views_;
+};
+
+/**
+ * @brief Compile a pattern list into one arena, in parallel
+ *
+ * Block offsets come from a serial prefix sum over pattern lengths; the
+ * failure tables are then computed by up to `threads` workers (0 = one
+ * per hardware thread) on disjoint index ranges. Small lists, below
+ * config::parallel_compile_grain patterns per worker, stay on the
+ * calling thread.
+ *
+ * @throws std::length_error if a pattern exceeds 4 GiB
+ */
+[[nodiscard]] inline literal_set compile_literals(
+    std::span<const std::string_view> patterns,
+    unsigned threads = 0
+) {
+    const size_type n = patterns.size();
+    literal_set set;
+
+    std::vector<size_type> offsets(n + 1, 0);
+    for (size_type i = 0; i < n; ++i) {
+        if (patterns[i].size() > detail::literal_layout::max_size) {
+            throw std::length_error("Pattern too long");
+        }
+        offsets[i + 1] = offsets[i] +
+            detail::literal_layout::compute(patterns[i].size()).padded_total();
+    }
+
+    set.arena_size_ = offsets[n];
+    set.arena_.reset(new std::uint32_t[set.arena_size_ / sizeof(std::uint32_t)]);
+    set.views_.resize(n);
+
+    auto* base = reinterpret_cast<std::byte*>(set.arena_.get());
+    auto compile_range = [&](size_type first, size_type last) {
+        for (size_type i = first; i < last; ++i) {
+            set.views_[i] = literal_pattern_view::write(patterns[i], base + offsets[i]);
+        }
+    };
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const size_type workers = std::max<size_type>(
+        1, std::min<size_type>(threads, n / config::parallel_compile_grain));
+
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(workers - 1);
+        const size_type chunk = (n + workers - 1) / workers;
+        for (size_type w = 1; w < workers; ++w) {
+            pool.emplace_back(compile_range, w * chunk, std::min(n, (w + 1) * chunk));
+        }
+        compile_range(0, std::min(n, chunk));
+    }
+
+    return set;
+}
+
+// =============================================================================
+// Masked Pattern (Wildcard Bytes)
+// =============================================================================
+
+/**
+ * @brief Literal with a per-byte mask, for binary signatures
+ *
+ * Matches at p when (text[p + i] & mask[i]) == (bytes[i] & mask[i]) for
+ * every i: mask 0xFF is an exact byte, 0x00 matches anything. Built from
+ * bytes and mask, or from a signature like "48 8B ?? ?? 89 45" with
+ * compile_masked().
+ *
+ * The SIMD scan anchors on the two rarest exact bytes and verifies
+ * candidates with masked vector compares. Wildcards defeat the failure
+ * function, so a pattern of mostly wildcards over uniform data degrades
+ * towards O(n*m / vector width).
+ */
+class masked_pattern {
+public:
+    masked_pattern() = default;
+
+    /**
+     * @throws std::runtime_error if bytes and mask differ in length
+     */
+    masked_pattern(std::string_view bytes, std::string_view mask)
+        : bytes_(bytes)
+        , mask_(mask)
+    {
+        if (bytes.size() != mask.size()) {
+            throw std::runtime_error("Mask length differs from pattern length");
+        }
+        for (size_type i = 0; i < bytes_.size(); ++i) {
+            bytes_[i] = static_cast<char>(bytes_[i] & mask_[i]);
+        }
+        anchors_ = detail::select_masked_anchors(bytes_, mask_);
+    }
+
+    /**
+     * @brief Parse a hex signature ("48 8B ?? ?? 89 45", "4? 8B")
+     *
+     * @throws std::runtime_error on a malformed byte
+     */
+    [[nodiscard]] static masked_pattern parse(std::string_view signature) {
+        std::string bytes;
+        std::string mask;
+        detail::parse_signature(signature, bytes, mask);
+        return masked_pattern{bytes, mask};
+    }
+
+    /**
+     * @brief Pattern bytes with wildcard bits cleared
+     */
+    [[nodiscard]] std::string_view bytes() const noexcept { return bytes_; }
+    [[nodiscard]] std::string_view mask() const noexcept { return mask_; }
+    [[nodiscard]] size_type size() const noexcept { return bytes_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return bytes_.empty(); }
+
+    /**
+     * @brief First match at or after from
+     */
+    [[nodiscard]] std::optional<size_type> find(std::string_view text, size_type from = 0) const noexcept {
+        if (from > text.size()) {
+            return std::nullopt;
+        }
+        if (empty()) {
+            return from;
+        }
+        const char* match = detail::find_masked(text.substr(from), bytes_, mask_, anchors_);
+        if (!match) {
+            return std::nullopt;
+        }
+        return static_cast<size_type>(match - text.data());
+    }
+
+private:
+    std::string bytes_;
+    std::string mask_;
+    detail::masked_anchors anchors_;
 };
 
 // =============================================================================
 // Regex Pattern (DFA Engine)
 // =============================================================================
 
+/**
+ * @brief Per-caller scratch space for regex captures and replacement
+ *
+ * Holds the capture engine's working memory, the capture slots and the
+ * parsed template.
+ * Reuse one per thread across calls so matching does not allocate; a
+ * scratch may serve different patterns.
+ */
+class regex_scratch {
+public:
+    regex_scratch() = default;
+
+private:
+    friend class regex_pattern;
+
+    detail::capture_scratch vm_;
+    std::vector<size_type> slots_;
+    std::vector<detail::substitution_piece> pieces_;
+};
+
+template <typename Pattern>
+class match_tracker;
+
 /**
  * @brief Compiled regex pattern with O(n) matching guarantee
  *
@@ -93,12 +562,38 @@ public:
     regex_pattern() = default;
 
     explicit regex_pattern(std::string_view pattern)
-        : source_(pattern)
-        , dfa_(std::make_shared<detail::compiled_dfa>(pattern))
+        : dfa_(std::make_shared<detail::compiled_dfa>(pattern))
+        , captures_(std::make_shared<lazy_captures>())
     {}
 
+    /**
+     * @brief Reconstruct a pattern from serialize() output without copying
+     *
+     * The DFA tables are used in place, so the buffer (e.g. an mmapped
+     * rule pack) must be 8-byte aligned and outlive the pattern.
+     *
+     * @throws std::runtime_error on a bad header, version or byte order
+     */
+    [[nodiscard]] static regex_pattern load(std::span<const std::byte> blob) {
+        regex_pattern result;
+        result.dfa_ = std::make_shared<detail::compiled_dfa>(detail::compiled_dfa::view(blob));
+        result.captures_ = std::make_shared<lazy_captures>();
+        return result;
+    }
+
+    /**
+     * @brief Serialize the compiled DFA to a versioned, byte-order tagged blob
+     * @throws std::runtime_error if the pattern is empty (default-constructed)
+     */
+    [[nodiscard]] std::vector<std::byte> serialize() const {
+        if (!dfa_ || dfa_->empty()) {
+            throw std::runtime_error("Cannot serialize an empty regex pattern");
+        }
+        return dfa_->serialize();
+    }
+
     [[nodiscard]] std::string_view source() const noexcept {
-        return source_;
+        return dfa_ ? dfa_->source() : std::string_view{};
     }
 
     [[nodiscard]] std::optional<size_type> search(std::string_view text) const {
@@ -106,6 +601,45 @@ public:
         return dfa_->search(text);
     }
 
+    /**
+     * @brief Search within [from, to) of text; the position is relative to text
+     *
+     * Bytes next to the window still decide \b and \B.
+     */
+    [[nodiscard]] std::optional<size_type> search(
+        std::string_view text,
+        size_type from,
+        size_type to = std::string_view::npos
+    ) const {
+        if (!dfa_) return std::nullopt;
+        return dfa_->search(text, from, to);
+    }
+
+    /**
+     * @brief First k positions at or after from where a match starts
+     *
+     * Stops scanning at the k-th match; the next page starts at
+     * from = last hit + 1.
+     */
+    [[nodiscard]] std::vector<size_type> search_n(
+        std::string_view text,
+        size_type k,
+        size_type from = 0
+    ) const {
+        std::vector<size_type> results;
+        if (!dfa_) return results;
+        results.reserve(std::min<size_type>(k, 16));
+        while (results.size() < k) {
+            auto found = dfa_->search(text, from);
+            if (!found) {
+                break;
+            }
+            results.push_back(*found);
+            from = *found + 1;
+        }
+        return results;
+    }
+
     [[nodiscard]] bool matches(std::string_view text) const {
         if (!dfa_) return false;
         return dfa_->matches(text);
@@ -119,9 +653,174 @@ public:
         return dfa_ ? dfa_->state_count() : 0;
     }
 
+    /**
+     * @brief Bytes held by the compiled tables (0 for views and empty patterns)
+     */
+    [[nodiscard]] size_type memory_size() const noexcept {
+        return dfa_ && !dfa_->is_view() ? dfa_->blob().size() : 0;
+    }
+
+    /**
+     * @brief Number of capture groups, not counting the whole match
+     */
+    [[nodiscard]] size_type group_count() const {
+        return dfa_ ? captures().group_count() : 0;
+    }
+
+    /**
+     * @brief Find the leftmost-first match at or after from, with groups
+     *
+     * On success slots[2k] and slots[2k + 1] bound group k (group 0 is
+     * the whole match), or are npos if the group did not participate;
+     * slots beyond 2 * (group_count() + 1) are left untouched.
+     */
+    bool find(
+        std::string_view text,
+        std::span<size_type> slots,
+        regex_scratch& scratch,
+        size_type from = 0
+    ) const {
+        if (!dfa_ || !find_slots(text, from, captures(), scratch)) {
+            return false;
+        }
+        const size_type count = std::min(slots.size(), scratch.slots_.size());
+        std::copy_n(scratch.slots_.begin(), count, slots.begin());
+        return true;
+    }
+
+    /**
+     * @brief Replace every match, streaming the output to a sink
+     *
+     * The replacement template may use $1..$9 and ${n} for groups, $0 or
+     * $& for the whole match and $$ for a dollar sign. Matches do not
+     * overlap; after an empty match the next byte is copied unchanged.
+     * The sink is called with consecutive pieces of the output.
+     *
+     * @return Number of replacements made
+     * @throws std::runtime_error if the template names a missing group
+     */
+    template <typename Sink>
+        requires std::invocable<Sink&, std::string_view>
+    size_type replace_all(
+        std::string_view text,
+        std::string_view replacement,
+        Sink&& sink,
+        regex_scratch& scratch
+    ) const {
+        if (!dfa_) {
+            if (!text.empty()) {
+                sink(text);
+            }
+            return 0;
+        }
+
+        const auto& program = captures();
+        detail::parse_substitution(replacement, program.group_count(), scratch.pieces_);
+
+        const auto& slots = scratch.slots_;
+        size_type replaced = 0;
+        size_type copied = 0;  // text consumed so far
+        size_type pos = 0;
+        while (pos <= text.size() && find_slots(text, pos, program, scratch)) {
+            const size_type begin = slots[0];
+            const size_type end = slots[1];
+            if (begin > copied) {
+                sink(text.substr(copied, begin - copied));
+            }
+            for (const auto& piece : scratch.pieces_) {
+                if (piece.group == detail::no_position) {
+                    sink(piece.literal);
+                    continue;
+                }
+                const size_type group_begin = slots[2 * piece.group];
+                const size_type group_end = slots[2 * piece.group + 1];
+                if (group_begin != detail::no_position && group_end > group_begin) {
+                    sink(text.substr(group_begin, group_end - group_begin));
+                }
+            }
+            copied = end;
+            ++replaced;
+            pos = end > begin ? end : end + 1;
+        }
+
+        if (copied < text.size()) {
+            sink(text.substr(copied));
+        }
+        return replaced;
+    }
+
+    /**
+     * @brief Replace every match, appending the output to out
+     * @return Number of replacements made
+     */
+    size_type replace_all(
+        std::string_view text,
+        std::string_view replacement,
+        std::string& out,
+        regex_scratch& scratch
+    ) const {
+        return replace_all(text, replacement,
+                           [&out](std::string_view piece) { out.append(piece); }, scratch);
+    }
+
+    /**
+     * @brief Replace every match (see the sink overload for the syntax)
+     */
+    [[nodiscard]] std::string replace_all(
+        std::string_view text,
+        std::string_view replacement
+    ) const {
+        regex_scratch scratch;
+        std::string result;
+        result.reserve(text.size());
+        replace_all(text, replacement, result, scratch);
+        return result;
+    }
+
 private:
-    std::string source_;
+    template <typename Pattern>
+    friend class match_tracker;
+
+    // Capture program, parsed from source() on first use so that loading
+    // rule packs stays parse-free
+    struct lazy_captures {
+        std::once_flag once;
+        detail::capture_program program;
+    };
+
     std::shared_ptr<detail::compiled_dfa> dfa_;
+    std::shared_ptr<lazy_captures> captures_;
+
+    [[nodiscard]] const detail::capture_program& captures() const {
+        std::call_once(captures_->once, [this] {
+            captures_->program = detail::capture_program(dfa_->source());
+        });
+        return captures_->program;
+    }
+
+    // The DFA locates the leftmost match start and its longest end, then
+    // the capture program resolves the match and groups into scratch.slots_
+    bool find_slots(
+        std::string_view text,
+        size_type from,
+        const detail::capture_program& program,
+        regex_scratch& scratch
+    ) const {
+        auto start = dfa_->search(text, from);
+        if (!start && from <= text.size()) {
+            // search() never reports an empty match at the end of the text
+            start = text.size();
+        }
+        std::optional<size_type> limit;
+        if (start) {
+            limit = dfa_->longest_match(text, *start);
+        }
+        if (!limit) {
+            return false;
+        }
+        scratch.slots_.resize(program.slot_count());
+        return program.match_at(text, *start, *limit, scratch.slots_, scratch.vm_);
+    }
 };
 
 // =============================================================================
@@ -218,6 +917,161 @@ template <fixed_string Pattern>
     return compiled_pattern<Pattern>{};
 }
 
+// =============================================================================
+// Compile-time Regex (constexpr DFA)
+// =============================================================================
+
+/**
+ * @brief Regex compiled to a DFA during constant evaluation
+ *
+ * Parsing and subset construction run in the compiler; only the
+ * transition table (byte class -> next state, narrowest state type that
+ * fits) ends up in the binary, as static read-only data. An invalid or
+ * too complex pattern is a compile error. Matching follows
+ * regex_pattern exactly, without the SIMD acceleration.
+ */
+template <fixed_string Pattern>
+class compiled_regex {
+    static constexpr auto shape_ = [] {
+        detail::dfa_builder builder(Pattern.view());
+        return std::array<size_type, 2>{builder.state_count(), builder.class_count()};
+    }();
+
+public:
+    static constexpr size_type state_count = shape_[0];
+    static constexpr size_type class_count = shape_[1];
+
+    // Smallest unsigned type holding every state id plus the dead marker
+    using state_type = std::conditional_t<(state_count < 0xFF), std::uint8_t,
+                       std::conditional_t<(state_count < 0xFFFF), std::uint16_t,
+                                          std::uint32_t>>;
+
+    static constexpr state_type dead = static_cast<state_type>(-1);
+
+    [[nodiscard]] static constexpr std::string_view pattern() noexcept {
+        return Pattern.view();
+    }
+
+    /**
+     * @brief Position of the first match, or nullopt if not found
+     */
+    [[nodiscard]] static constexpr std::optional<size_type> search(std::string_view text) noexcept {
+        if constexpr (state_count == 0) {
+            return std::nullopt;
+        }
+
+        for (size_type start = 0; start < text.size(); ++start) {
+            size_type state = start_state(text, start);
+            size_type i = start;
+
+            for (; i < text.size(); ++i) {
+                auto c = static_cast<unsigned char>(text[i]);
+                if (accepts_before(state, c)) {
+                    return start;
+                }
+                state_type next = step(state, c);
+                if (next == dead) {
+                    break;
+                }
+                state = next;
+            }
+
+            if (i == text.size() && (tables_.flags[state] & accept_flag)) {
+                return start;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Check if pattern matches the entire text
+     */
+    [[nodiscard]] static constexpr bool matches(std::string_view text) noexcept {
+        if constexpr (state_count == 0) {
+            return false;
+        }
+
+        size_type state = 0;
+        for (char ch : text) {
+            state_type next = step(state, static_cast<unsigned char>(ch));
+            if (next == dead) {
+                return false;
+            }
+            state = next;
+        }
+        return (tables_.flags[state] & accept_flag) != 0;
+    }
+
+private:
+    static constexpr std::uint8_t accept_flag = 0x01;
+    static constexpr std::uint8_t accept_word_flag = 0x02;
+
+    struct tables {
+        std::array<std::uint8_t, 256> byte_class{};
+        std::array<state_type, state_count * class_count> transitions{};  // [state][class]
+        std::array<std::uint8_t, state_count> flags{};
+        size_type start_word = 0;
+        bool has_assertions = false;
+    };
+
+    static constexpr tables tables_ = [] {
+        detail::dfa_builder builder(Pattern.view());
+        tables t;
+        for (size_type c = 0; c < t.byte_class.size(); ++c) {
+            t.byte_class[c] = builder.byte_class(static_cast<unsigned char>(c));
+        }
+        t.transitions.fill(dead);
+        for (size_type s = 0; s < state_count; ++s) {
+            for (size_type c = 0; c < config::ascii_size; ++c) {
+                size_type next = builder.transition(s, static_cast<unsigned char>(c));
+                if (next != detail::no_transition) {
+                    t.transitions[s * class_count + t.byte_class[c]] =
+                        static_cast<state_type>(next);
+                }
+            }
+            t.flags[s] = static_cast<std::uint8_t>(
+                (builder.is_accept(s) ? accept_flag : 0) |
+                (builder.is_accept_word(s) ? accept_word_flag : 0));
+        }
+        t.start_word = builder.start_word();
+        t.has_assertions = builder.has_assertions();
+        return t;
+    }();
+
+    static constexpr detail::char_class word_ = detail::char_class::word();
+
+    [[nodiscard]] static constexpr state_type step(size_type state, unsigned char c) noexcept {
+        return tables_.transitions[state * class_count + tables_.byte_class[c]];
+    }
+
+    [[nodiscard]] static constexpr size_type start_state(std::string_view text, size_type pos) noexcept {
+        return (tables_.has_assertions && pos > 0 && word_.test(text[pos - 1]))
+            ? tables_.start_word : 0;
+    }
+
+    // Whether a match ends at the current position, given the next byte
+    [[nodiscard]] static constexpr bool accepts_before(size_type state, unsigned char next) noexcept {
+        if (tables_.has_assertions && word_.test(static_cast<char>(next))) {
+            return (tables_.flags[state] & accept_word_flag) != 0;
+        }
+        return (tables_.flags[state] & accept_flag) != 0;
+    }
+};
+
+/**
+ * @brief Compile a regex at compile time
+ *
+ * Usage:
+ *   constexpr auto re = kmp::compile_regex<"[a-z]+@[a-z]+">();
+ *   static_assert(re.matches("user@host"));
+ *   auto pos = re.search(text);
+ */
+template <fixed_string Pattern>
+[[nodiscard]] consteval auto compile_regex() {
+    return compiled_regex<Pattern>{};
+}
+
 // =============================================================================
 // Compile Function (Runtime)
 // =============================================================================
@@ -236,20 +1090,258 @@ template <fixed_string Pattern>
     return regex_pattern{pattern};
 }
 
+/**
+ * @brief Compile a wildcard byte signature such as "48 8B ?? ?? 89 45"
+ *
+ * @throws std::runtime_error on a malformed byte
+ */
+[[nodiscard]] inline masked_pattern compile_masked(std::string_view signature) {
+    return masked_pattern::parse(signature);
+}
+
+// =============================================================================
+// Regex Rule Packs
+// =============================================================================
+
+/**
+ * @brief Serialize several regexes into one rule pack
+ *
+ * A rule pack is the serialized blobs back to back. Every blob size is a
+ * multiple of 8 bytes, so all blobs stay aligned when the pack is mmapped.
+ */
+[[nodiscard]] inline std::vector<std::byte> serialize_regex_pack(
+    std::span<const regex_pattern> patterns
+) {
+    std::vector<std::byte> pack;
+    for (const auto& pattern : patterns) {
+        auto blob = pattern.serialize();
+        pack.insert(pack.end(), blob.begin(), blob.end());
+    }
+    return pack;
+}
+
+/**
+ * @brief Load every pattern of a rule pack in place
+ *
+ * No DFA tables are parsed or copied; see regex_pattern::load() for the
+ * alignment and lifetime requirements.
+ */
+[[nodiscard]] inline std::vector<regex_pattern> load_regex_pack(
+    std::span<const std::byte> pack
+) {
+    std::vector<regex_pattern> patterns;
+    while (!pack.empty()) {
+        size_type size = detail::compiled_dfa::blob_size(pack);
+        patterns.push_back(regex_pattern::load(pack.first(size)));
+        pack = pack.subspan(size);
+    }
+    return patterns;
+}
+
 // =============================================================================
 // Search with Compiled Pattern
 // =============================================================================
 
+/**
+ * @brief Search with a compiled literal held elsewhere (see literal_pattern_view)
+ *
+ * Reuses the stored failure table and SIMD anchor.
+ */
+template <std::forward_iterator Iter>
+[[nodiscard]] Iter search(Iter first, Iter last, const literal_pattern_view& pattern) {
+    if (pattern.empty()) {
+        return first;
+    }
+    return detail::search_prepared(
+        first, last, pattern.begin(), pattern.end(), pattern.failure(), pattern.anchor());
+}
+
 /**
  * @brief Search with pre-compiled literal pattern
  */
 template <std::forward_iterator Iter>
-[[nodiscard]] Iter search(Iter first, Iter last, const literal_pattern& pattern);
+[[nodiscard]] Iter search(Iter first, Iter last, const literal_pattern& pattern) {
+    return search(first, last, pattern.view());
+}
+
+/**
+ * @brief Search with a compiled literal, returning a position
+ */
+[[nodiscard]] inline std::optional<size_type> search_pos(
+    std::string_view text,
+    const literal_pattern_view& pattern
+) {
+    auto it = search(text.begin(), text.end(), pattern);
+    if (it == text.end()) {
+        return std::nullopt;
+    }
+    return static_cast<size_type>(it - text.begin());
+}
+
+[[nodiscard]] inline std::optional<size_type> search_pos(
+    std::string_view text,
+    const literal_pattern& pattern
+) {
+    return search_pos(text, pattern.view());
+}
+
+/**
+ * @brief Search a compiled literal within [from, to) of text
+ */
+[[nodiscard]] inline std::optional<size_type> search_pos(
+    std::string_view text,
+    const literal_pattern_view& pattern,
+    size_type from,
+    size_type to = std::string_view::npos
+) {
+    auto found = search_pos(detail::window(text, from, to), pattern);
+    if (!found) {
+        return std::nullopt;
+    }
+    return from + *found;
+}
+
+[[nodiscard]] inline std::optional<size_type> search_pos(
+    std::string_view text,
+    const literal_pattern& pattern,
+    size_type from,
+    size_type to = std::string_view::npos
+) {
+    return search_pos(text, pattern.view(), from, to);
+}
+
+/**
+ * @brief First k occurrences of a compiled literal at or after from
+ */
+[[nodiscard]] inline std::vector<size_type> search_n(
+    std::string_view text,
+    const literal_pattern_view& pattern,
+    size_type k,
+    size_type from = 0
+) {
+    if (pattern.empty() || k == 0 || from >= text.size()) {
+        return {};
+    }
+    return detail::search_n_prepared(
+        text, pattern.pattern(), pattern.failure(), pattern.anchor(), k, from);
+}
+
+[[nodiscard]] inline std::vector<size_type> search_n(
+    std::string_view text,
+    const literal_pattern& pattern,
+    size_type k,
+    size_type from = 0
+) {
+    return search_n(text, pattern.view(), k, from);
+}
+
+/**
+ * @brief Write positions of a compiled literal into a caller buffer
+ *
+ * See search_all_into(std::string_view, std::string_view, ...).
+ */
+[[nodiscard]] inline search_into_result search_all_into(
+    std::string_view text,
+    const literal_pattern_view& pattern,
+    std::span<size_type> out,
+    size_type from = 0,
+    match_mode mode = match_mode::overlapping
+) {
+    if (out.empty()) {
+        return {0, from};
+    }
+    if (pattern.empty() || from >= text.size() || text.size() - from < pattern.size()) {
+        return {0, text.size()};
+    }
+    return detail::search_into_prepared(
+        text, pattern.pattern(), pattern.failure(), pattern.anchor(), out, from, mode);
+}
+
+[[nodiscard]] inline search_into_result search_all_into(
+    std::string_view text,
+    const literal_pattern& pattern,
+    std::span<size_type> out,
+    size_type from = 0,
+    match_mode mode = match_mode::overlapping
+) {
+    return search_all_into(text, pattern.view(), out, from, mode);
+}
+
+/**
+ * @brief Search with a masked pattern, returning a position
+ */
+[[nodiscard]] inline std::optional<size_type> search_pos(
+    std::string_view text,
+    const masked_pattern& pattern
+) {
+    return pattern.find(text);
+}
+
+/**
+ * @brief Search a masked pattern within [from, to) of text
+ */
+[[nodiscard]] inline std::optional<size_type> search_pos(
+    std::string_view text,
+    const masked_pattern& pattern,
+    size_type from,
+    size_type to = std::string_view::npos
+) {
+    auto found = pattern.find(detail::window(text, from, to));
+    if (!found) {
+        return std::nullopt;
+    }
+    return from + *found;
+}
+
+/**
+ * @brief Find all matches of a masked pattern
+ */
+[[nodiscard]] inline std::vector<size_type> search_all_vec(
+    std::string_view text,
+    const masked_pattern& pattern,
+    match_mode mode = match_mode::overlapping
+) {
+    std::vector<size_type> results;
+    if (pattern.empty()) {
+        return results;
+    }
+    const size_type step = mode == match_mode::non_overlapping ? pattern.size() : 1;
+    for (auto pos = pattern.find(text); pos; pos = pattern.find(text, *pos + step)) {
+        results.push_back(*pos);
+    }
+    return results;
+}
+
+/**
+ * @brief Count matches of a masked pattern
+ */
+[[nodiscard]] inline size_type count(
+    std::string_view text,
+    const masked_pattern& pattern,
+    match_mode mode = match_mode::overlapping
+) {
+    size_type result = 0;
+    if (pattern.empty()) {
+        return result;
+    }
+    const size_type step = mode == match_mode::non_overlapping ? pattern.size() : 1;
+    for (auto pos = pattern.find(text); pos; pos = pattern.find(text, *pos + step)) {
+        ++result;
+    }
+    return result;
+}
 
 /**
  * @brief Search with compile-time pattern
  */
 template <std::forward_iterator Iter, fixed_string Pattern>
-[[nodiscard]] Iter search(Iter first, Iter last, const compiled_pattern<Pattern>& pattern);
+[[nodiscard]] Iter search(Iter first, Iter last, const compiled_pattern<Pattern>& pattern) {
+    if constexpr (Pattern.size() == 0) {
+        return first;
+    } else {
+        const auto text = pattern.pattern();
+        return detail::search_prepared(first, last, text.begin(), text.end(), pattern.failure());
+    }
+}
 
 } // namespace kmp
@@ -0,0 +1,187 @@
+#pragma once
+
+/**
+ * @file regex_cache.hpp
+ * @brief Process-wide cache of compiled regex patterns
+ *
+ * Compiling a regex (NFA build plus subset construction) costs far more
+ * than most searches. Callers that see the same sources over and over can
+ * opt in to this cache; nothing else in the library uses it.
+ */
+
+#include "config.hpp"
+#include "pattern.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace kmp {
+
+// =============================================================================
+// Regex Cache
+// =============================================================================
+
+/**
+ * @brief Thread-safe LRU cache of compiled regexes keyed by source
+ *
+ * Returned patterns share their DFA with the cache entry (regex_pattern
+ * holds a shared_ptr), so eviction never invalidates a pattern a caller
+ * still holds. The budget counts compiled tables plus key bytes; a pattern
+ * larger than the whole budget is compiled but not cached.
+ */
+class regex_cache {
+public:
+    struct statistics {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        size_type entries = 0;
+        size_type bytes = 0;
+    };
+
+    explicit regex_cache(size_type capacity_bytes = config::regex_cache_bytes)
+        : capacity_(capacity_bytes)
+    {}
+
+    regex_cache(const regex_cache&) = delete;
+    regex_cache& operator=(const regex_cache&) = delete;
+
+    /**
+     * @brief Process-wide instance with the default budget
+     */
+    [[nodiscard]] static regex_cache& global() {
+        static regex_cache instance;
+        return instance;
+    }
+
+    /**
+     * @brief Return the cached pattern for source, compiling it on a miss
+     *
+     * Compilation runs without holding the lock; if two threads miss on
+     * the same source concurrently, the first insert wins and both get it.
+     *
+     * @throws std::runtime_error if the pattern is invalid (nothing is cached)
+     */
+    [[nodiscard]] regex_pattern get(std::string_view source) {
+        {
+            std::lock_guard lock(mutex_);
+            if (auto* pattern = find_locked(source)) {
+                ++stats_.hits;
+                return *pattern;
+            }
+            ++stats_.misses;
+        }
+
+        regex_pattern compiled{source};
+        const size_type cost = compiled.memory_size() + source.size();
+
+        std::lock_guard lock(mutex_);
+        if (auto* pattern = find_locked(source)) {
+            return *pattern;
+        }
+        if (cost > capacity_) {
+            return compiled;
+        }
+
+        lru_.push_front({std::string(source), compiled, cost});
+        index_.emplace(lru_.front().source, lru_.begin());
+        stats_.bytes += cost;
+        evict_locked(capacity_);
+        return compiled;
+    }
+
+    /**
+     * @brief Change the memory budget, evicting as needed
+     */
+    void set_capacity(size_type capacity_bytes) {
+        std::lock_guard lock(mutex_);
+        capacity_ = capacity_bytes;
+        evict_locked(capacity_);
+    }
+
+    [[nodiscard]] size_type capacity() const {
+        std::lock_guard lock(mutex_);
+        return capacity_;
+    }
+
+    /**
+     * @brief Drop every entry (counters are kept)
+     */
+    void clear() {
+        std::lock_guard lock(mutex_);
+        index_.clear();
+        lru_.clear();
+        stats_.bytes = 0;
+    }
+
+    [[nodiscard]] statistics stats() const {
+        std::lock_guard lock(mutex_);
+        statistics result = stats_;
+        result.entries = lru_.size();
+        return result;
+    }
+
+    void reset_stats() {
+        std::lock_guard lock(mutex_);
+        stats_.hits = stats_.misses = stats_.evictions = 0;
+    }
+
+private:
+    struct entry {
+        std::string source;
+        regex_pattern pattern;
+        size_type cost;
+    };
+
+    // Transparent hash so lookups by string_view don't allocate
+    struct source_hash {
+        using is_transparent = void;
+        [[nodiscard]] size_type operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    using lru_list = std::list<entry>;  // most recently used first
+
+    mutable std::mutex mutex_;
+    lru_list lru_;
+    std::unordered_map<std::string_view, lru_list::iterator, source_hash, std::equal_to<>> index_;
+    size_type capacity_;
+    statistics stats_;
+
+    regex_pattern* find_locked(std::string_view source) {
+        auto it = index_.find(source);
+        if (it == index_.end()) {
+            return nullptr;
+        }
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return &it->second->pattern;
+    }
+
+    void evict_locked(size_type budget) {
+        while (stats_.bytes > budget && !lru_.empty()) {
+            const auto& victim = lru_.back();
+            stats_.bytes -= victim.cost;
+            index_.erase(victim.source);
+            lru_.pop_back();
+            ++stats_.evictions;
+        }
+    }
+};
+
+/**
+ * @brief Compile a regex through the process-wide cache
+ *
+ * Opt-in replacement for compile_regex() when the same sources recur,
+ * e.g. per-request user patterns from a small working set.
+ */
+[[nodiscard]] inline regex_pattern compile_regex_cached(std::string_view source) {
+    return regex_cache::global().get(source);
+}
+
+} // namespace kmp
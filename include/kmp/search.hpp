@@ -14,6 +14,8 @@
 
 #include "config.hpp"
 #include "detail/failure.hpp"
+#include "detail/literal.hpp"
+#include "detail/shift_or.hpp"
 #include "detail/simd/dispatch.hpp"
 
 #if KMP_HAS_AVX512
@@ -29,8 +31,11 @@
 #include <iterator>
 #include <concepts>
 #include <ranges>
+#include <cstring>
+#include <string>
 #include <string_view>
 #include <span>
+#include <type_traits>
 #include <vector>
 #include <optional>
 #include <generator>
@@ -53,6 +58,65 @@ template <typename Iter>
 concept contiguous_char_iterator =
     std::contiguous_iterator<Iter> && char_iterator<Iter>;
 
+/**
+ * @brief Element type the SIMD kernels compare lane by lane
+ *
+ * 8-, 16- or 32-bit scalars whose equality is bitwise: char, std::byte,
+ * char8_t, char16_t, char32_t, std::uint32_t, enums. Floating point is
+ * excluded (0.0 == -0.0, NaN != NaN).
+ */
+template <typename T>
+concept simd_element = std::is_scalar_v<T> &&
+    std::has_unique_object_representations_v<T> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+
+template <typename Iter>
+concept contiguous_simd_iterator = std::contiguous_iterator<Iter> &&
+    simd_element<std::remove_cv_t<std::iter_value_t<Iter>>>;
+
+/**
+ * @brief Contiguous sequence of non-char elements
+ *
+ * E.g. std::vector<std::byte>, std::u16string_view or
+ * std::span<const std::uint32_t>. char text goes through the
+ * std::string_view overloads; built-in arrays are rejected so that string
+ * literals do not bring their terminator into the pattern.
+ */
+template <typename R>
+concept element_sequence = std::ranges::contiguous_range<R> &&
+    std::ranges::sized_range<R> &&
+    !std::is_array_v<std::remove_cvref_t<R>> &&
+    !std::same_as<std::ranges::range_value_t<R>, char>;
+
+/**
+ * @brief Range of contiguous text pieces searched as one logical text
+ *
+ * E.g. std::vector<std::string_view> over rope chunks or iovec buffers.
+ */
+template <typename R>
+concept text_segments = std::ranges::input_range<R> &&
+    std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>;
+
+/**
+ * @brief How search_all() and friends treat matches that overlap
+ *
+ * overlapping reports every match ("aa" occurs 3 times in "aaaa");
+ * non_overlapping reports leftmost matches, resuming after each one
+ * (2 times), as needed by replacement and tokenization.
+ */
+enum class match_mode {
+    overlapping,
+    non_overlapping,
+};
+
+/**
+ * @brief Result of search_all_into()
+ */
+struct search_into_result {
+    size_type written = 0;  // positions stored at the front of the buffer
+    size_type resume = 0;   // pass as from to continue after a full buffer
+};
+
 // =============================================================================
 // Scalar KMP Implementation
 // =============================================================================
@@ -62,40 +126,399 @@ namespace detail {
 /**
  * @brief Pure scalar KMP search (fallback)
  */
-template <std::forward_iterator TextIter, std::forward_iterator PatternIter>
+template <std::forward_iterator TextIter, std::random_access_iterator PatternIter,
+          typename FailureTable = std::vector<size_type>>
 [[nodiscard]] TextIter kmp_search_scalar(
     TextIter text_first,
     TextIter text_last,
     PatternIter pattern_first,
     PatternIter pattern_last,
-    const std::vector<size_type>& failure
+    const FailureTable& failure
 ) {
-    const auto m = static_cast<size_type>(std::distance(pattern_first, pattern_last));
+    const auto m = static_cast<size_type>(pattern_last - pattern_first);
     if (m == 0) {
         return text_first;
     }
 
-    size_type j = 0;  // pattern index
+    size_type j = 0;    // pattern index
+    size_type pos = 0;  // text index of it
 
-    for (auto it = text_first; it != text_last; ++it) {
-        while (j > 0 && *it != *std::next(pattern_first, static_cast<diff_type>(j))) {
+    for (auto it = text_first; it != text_last; ++it, ++pos) {
+        while (j > 0 && *it != pattern_first[static_cast<diff_type>(j)]) {
             j = failure[j - 1];
         }
 
-        if (*it == *std::next(pattern_first, static_cast<diff_type>(j))) {
+        if (*it == pattern_first[static_cast<diff_type>(j)]) {
             ++j;
         }
 
         if (j == m) {
             // Found match - return iterator to start of match
-            return std::next(text_first,
-                std::distance(text_first, it) - static_cast<diff_type>(m) + 1);
+            return std::next(text_first, static_cast<diff_type>(pos + 1 - m));
         }
     }
 
     return text_last;
 }
 
+/**
+ * @brief Scalar KMP search for patterns without random access
+ *
+ * Failure transitions jump to pattern[j]; walking there would cost O(j)
+ * per comparison (O(n*m) overall), so the pattern is copied once.
+ */
+template <std::forward_iterator TextIter, std::forward_iterator PatternIter,
+          typename FailureTable = std::vector<size_type>>
+[[nodiscard]] TextIter kmp_search_scalar(
+    TextIter text_first,
+    TextIter text_last,
+    PatternIter pattern_first,
+    PatternIter pattern_last,
+    const FailureTable& failure
+) {
+    const std::vector<std::iter_value_t<PatternIter>> buffer(pattern_first, pattern_last);
+    return kmp_search_scalar(text_first, text_last, buffer.begin(), buffer.end(), failure);
+}
+
+/**
+ * @brief Search with a precomputed failure table
+ *
+ * Shared by search() and the precompiled pattern overloads. With
+ * anchor > 0 the SIMD scan also checks pattern[anchor] per candidate.
+ * Requires m > 0.
+ */
+template <std::forward_iterator TextIter, std::forward_iterator PatternIter,
+          typename FailureTable>
+[[nodiscard]] TextIter search_prepared(
+    TextIter text_first,
+    TextIter text_last,
+    PatternIter pattern_first,
+    PatternIter pattern_last,
+    const FailureTable& failure,
+    size_type anchor = 0
+) {
+    const auto n = static_cast<size_type>(std::distance(text_first, text_last));
+    const auto m = static_cast<size_type>(std::distance(pattern_first, pattern_last));
+
+    if (n < m) {
+        return text_last;
+    }
+
+    // For contiguous 8/16/32-bit elements, use SIMD acceleration
+    if constexpr (contiguous_simd_iterator<TextIter> &&
+                  contiguous_simd_iterator<PatternIter> &&
+                  std::same_as<std::iter_value_t<TextIter>, std::iter_value_t<PatternIter>>) {
+        using element = std::iter_value_t<TextIter>;
+
+        const element* text_ptr = std::to_address(text_first);
+        const element* pattern_ptr = std::to_address(pattern_first);
+
+        const element* result = nullptr;
+
+        // Small alphabets: most bytes are SIMD candidates, so use Shift-Or
+        if constexpr (std::same_as<element, char>) {
+            const std::string_view text_view(text_ptr, n);
+            const std::string_view pattern_view(pattern_ptr, m);
+            if (detail::prefer_shift_or(text_view, pattern_view, anchor)) {
+                return text_first + static_cast<diff_type>(
+                    detail::shift_or_find(text_view, pattern_view));
+            }
+        }
+
+        // Runtime SIMD dispatch
+        if (n >= config::simd_threshold) {
+            #if KMP_HAS_AVX512
+            if (detail::simd::has_avx512()) {
+                result = detail::simd::kmp_search_avx512(
+                    text_ptr, n, pattern_ptr, m, failure, anchor);
+            } else
+            #endif
+            #if KMP_HAS_AVX2
+            if (detail::simd::has_avx2()) {
+                result = detail::simd::kmp_search_avx2(
+                    text_ptr, n, pattern_ptr, m, failure, anchor);
+            } else
+            #endif
+            #if KMP_HAS_SSE42
+            if (detail::simd::has_sse42()) {
+                result = detail::simd::kmp_search_sse42(
+                    text_ptr, n, pattern_ptr, m, failure, anchor);
+            } else
+            #endif
+            {
+                // Scalar fallback
+                return detail::kmp_search_scalar(
+                    text_first, text_last, pattern_first, pattern_last, failure);
+            }
+
+            if (result) {
+                return text_first + (result - text_ptr);
+            }
+            return text_last;
+        }
+    }
+
+    // Scalar fallback for non-contiguous or small inputs
+    return detail::kmp_search_scalar(
+        text_first, text_last, pattern_first, pattern_last, failure);
+}
+
+/**
+ * @brief Clamp [from, to) to text; returns the window's text
+ */
+[[nodiscard]] inline std::string_view window(
+    std::string_view text,
+    size_type& from,
+    size_type to
+) noexcept {
+    to = std::min(to, text.size());
+    from = std::min(from, to);
+    return text.substr(from, to - from);
+}
+
+/**
+ * @brief Output iterator that hands each written position to a callback
+ */
+template <typename F>
+class callback_output_iterator {
+public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = diff_type;
+    using pointer = void;
+    using reference = void;
+
+    explicit callback_output_iterator(F f) : f_(std::move(f)) {}
+
+    callback_output_iterator& operator*() noexcept { return *this; }
+    callback_output_iterator& operator++() noexcept { return *this; }
+    callback_output_iterator& operator++(int) noexcept { return *this; }
+
+    callback_output_iterator& operator=(size_type pos) {
+        f_(pos);
+        return *this;
+    }
+
+private:
+    F f_;
+};
+
+/**
+ * @brief Write match positions to out (SIMD search-all kernels)
+ *
+ * Stops after max_matches positions. Elements that are not simd_element
+ * take the scalar loop.
+ */
+template <typename T, typename FailureTable, typename OutputIt>
+OutputIt find_all(
+    std::span<const T> text,
+    std::span<const T> pattern,
+    const FailureTable& failure,
+    OutputIt out,
+    match_mode mode,
+    size_type anchor = 0,
+    size_type max_matches = static_cast<size_type>(-1)
+) {
+    const size_type n = text.size();
+    const size_type m = pattern.size();
+    if (m == 0 || n < m) {
+        return out;
+    }
+
+    const bool non_overlapping = mode == match_mode::non_overlapping;
+
+    // Small alphabets: most bytes are SIMD candidates, so use Shift-Or
+    if constexpr (std::same_as<T, char>) {
+        const std::string_view text_view(text.data(), n);
+        const std::string_view pattern_view(pattern.data(), m);
+        if (detail::prefer_shift_or(text_view, pattern_view, anchor)) {
+            return detail::shift_or_find_all(
+                text_view, pattern_view, out, non_overlapping, max_matches);
+        }
+    }
+
+    // Runtime SIMD dispatch
+    if constexpr (simd_element<T>) {
+        if (n >= config::simd_threshold) {
+            #if KMP_HAS_AVX512
+            if (detail::simd::has_avx512()) {
+                return detail::simd::kmp_search_all_avx512(
+                    text.data(), n, pattern.data(), m, failure, out,
+                    anchor, non_overlapping, max_matches);
+            }
+            #endif
+            #if KMP_HAS_AVX2
+            if (detail::simd::has_avx2()) {
+                return detail::simd::kmp_search_all_avx2(
+                    text.data(), n, pattern.data(), m, failure, out,
+                    anchor, non_overlapping, max_matches);
+            }
+            #endif
+            #if KMP_HAS_SSE42
+            if (detail::simd::has_sse42()) {
+                return detail::simd::kmp_search_all_sse42(
+                    text.data(), n, pattern.data(), m, failure, out,
+                    anchor, non_overlapping, max_matches);
+            }
+            #endif
+        }
+    }
+
+    // Scalar fallback
+    size_type j = 0;
+    size_type found = 0;
+    for (size_type i = 0; i < n && found < max_matches; ++i) {
+        while (j > 0 && text[i] != pattern[j]) {
+            j = failure[j - 1];
+        }
+        if (text[i] == pattern[j]) {
+            ++j;
+        }
+        if (j == m) {
+            *out++ = i - m + 1;
+            ++found;
+            j = non_overlapping ? 0 : failure[j - 1];
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief find_all() over char text
+ */
+template <typename FailureTable, typename OutputIt>
+OutputIt find_all(
+    std::string_view text,
+    std::string_view pattern,
+    const FailureTable& failure,
+    OutputIt out,
+    match_mode mode,
+    size_type anchor = 0,
+    size_type max_matches = static_cast<size_type>(-1)
+) {
+    return find_all(std::span<const char>(text), std::span<const char>(pattern),
+                    failure, out, mode, anchor, max_matches);
+}
+
+/**
+ * @brief First k match positions at or after from, overlapping
+ *
+ * The search-all kernel stops at the k-th match. Requires m > 0 and
+ * from <= text.size().
+ */
+template <typename FailureTable>
+[[nodiscard]] std::vector<size_type> search_n_prepared(
+    std::string_view text,
+    std::string_view pattern,
+    const FailureTable& failure,
+    size_type anchor,
+    size_type k,
+    size_type from
+) {
+    std::vector<size_type> results;
+    results.reserve(std::min<size_type>(k, 16));
+    find_all(text.substr(from), pattern, failure,
+             callback_output_iterator([&](size_type pos) { results.push_back(from + pos); }),
+             match_mode::overlapping, anchor, k);
+    return results;
+}
+
+/**
+ * @brief search_all_into() body. Requires m > 0, a non-empty out and
+ * from < text.size()
+ */
+template <typename FailureTable>
+[[nodiscard]] search_into_result search_into_prepared(
+    std::string_view text,
+    std::string_view pattern,
+    const FailureTable& failure,
+    size_type anchor,
+    std::span<size_type> out,
+    size_type from,
+    match_mode mode
+) {
+    size_type written = 0;
+    find_all(text.substr(from), pattern, failure,
+             callback_output_iterator([&](size_type pos) { out[written++] = from + pos; }),
+             mode, anchor, out.size());
+
+    if (written < out.size()) {
+        return {written, text.size()};
+    }
+    const size_type step = mode == match_mode::overlapping ? 1 : pattern.size();
+    return {written, out[written - 1] + step};
+}
+
+/**
+ * @brief Write match positions across segments, in logical offsets
+ *
+ * Matches inside a segment come from the SIMD search-all kernel. Only
+ * matches crossing a boundary need the KMP state carried over: the
+ * first m - 1 bytes of a segment are scanned with it, and the state at
+ * the segment's end is rebuilt from its last m - 1 bytes. Segments too
+ * short for that are scanned with the carried state throughout.
+ * Stops after max_matches positions. Requires m > 0.
+ */
+template <typename Segments, typename FailureTable, typename OutputIt>
+OutputIt segmented_find_all(
+    Segments&& segments,
+    std::string_view pattern,
+    const FailureTable& failure,
+    size_type anchor,
+    OutputIt out,
+    size_type max_matches = static_cast<size_type>(-1)
+) {
+    const size_type m = pattern.size();
+    size_type found = 0;
+    size_type base = 0;  // logical offset of the current segment
+    size_type j = 0;     // KMP state carried across boundaries
+
+    // Continue KMP from state j over segment[first, last)
+    auto scan = [&](std::string_view segment, size_type first, size_type last) {
+        for (size_type i = first; i < last && found < max_matches; ++i) {
+            while (j > 0 && segment[i] != pattern[j]) {
+                j = failure[j - 1];
+            }
+            if (segment[i] == pattern[j]) {
+                ++j;
+            }
+            if (j == m) {
+                *out++ = base + i + 1 - m;
+                ++found;
+                j = failure[j - 1];
+            }
+        }
+    };
+
+    for (auto&& piece : segments) {
+        const std::string_view segment(piece);
+        const size_type n = segment.size();
+
+        if (n < config::simd_threshold || n < 2 * m) {
+            scan(segment, 0, n);
+        } else {
+            // Matches ending in the first m - 1 bytes start in earlier segments
+            scan(segment, 0, m - 1);
+            if (found < max_matches) {
+                auto counted = callback_output_iterator([&](size_type pos) {
+                    *out++ = base + pos;
+                    ++found;
+                });
+                find_all(segment, pattern, failure, counted, match_mode::overlapping, anchor,
+                         max_matches - found);
+            }
+            j = 0;
+            scan(segment, n - (m - 1), n);
+        }
+
+        if (found == max_matches) {
+            break;
+        }
+        base += n;
+    }
+    return out;
+}
+
 } // namespace detail
 
 // =============================================================================
@@ -135,7 +558,131 @@ template <std::forward_iterator TextIter, std::forward_iterator PatternIter>
     // Compute failure function
     auto failure = detail::compute_failure(pattern_first, pattern_last);
 
-    // For contiguous char iterators, use SIMD acceleration
+    return detail::search_prepared(
+        text_first, text_last, pattern_first, pattern_last, failure);
+}
+
+// =============================================================================
+// Convenience Overloads
+// =============================================================================
+
+/**
+ * @brief Search using string_view
+ */
+[[nodiscard]] inline std::string_view::iterator search(
+    std::string_view text,
+    std::string_view pattern
+) {
+    auto it = search(text.begin(), text.end(), pattern.begin(), pattern.end());
+    return it;
+}
+
+/**
+ * @brief Search returning position instead of iterator
+ */
+[[nodiscard]] inline std::optional<size_type> search_pos(
+    std::string_view text,
+    std::string_view pattern
+) {
+    auto it = search(text.begin(), text.end(), pattern.begin(), pattern.end());
+    if (it == text.end()) {
+        return std::nullopt;
+    }
+    return static_cast<size_type>(std::distance(text.begin(), it));
+}
+
+/**
+ * @brief Search within the window [from, to) of text
+ *
+ * Only matches lying entirely inside the window are found; the position
+ * is relative to text. Bounds past the end are clamped, so to defaults to
+ * the end of text.
+ */
+[[nodiscard]] inline std::optional<size_type> search_pos(
+    std::string_view text,
+    std::string_view pattern,
+    size_type from,
+    size_type to = std::string_view::npos
+) {
+    auto found = search_pos(detail::window(text, from, to), pattern);
+    if (!found) {
+        return std::nullopt;
+    }
+    return from + *found;
+}
+
+// =============================================================================
+// Bounded Search
+// =============================================================================
+
+/**
+ * @brief Find the first k occurrences at or after from
+ *
+ * Matches may overlap, as in search_all(). The search stops at the k-th
+ * match, so asking for a page of hits costs only the text scanned to
+ * find them; the next page starts at from = last hit + 1.
+ *
+ * @return Up to k match positions (empty for an empty pattern)
+ */
+[[nodiscard]] inline std::vector<size_type> search_n(
+    std::string_view text,
+    std::string_view pattern,
+    size_type k,
+    size_type from = 0
+) {
+    if (pattern.empty() || k == 0 || from >= text.size() || text.size() - from < pattern.size()) {
+        return {};
+    }
+    auto failure = detail::compute_failure(pattern.begin(), pattern.end());
+    return detail::search_n_prepared(text, pattern, failure, detail::select_anchor(pattern), k, from);
+}
+
+// =============================================================================
+// Reverse Search (Last Occurrence)
+// =============================================================================
+
+/**
+ * @brief Find the last occurrence of pattern in text
+ *
+ * Runs KMP right to left over the reversed pattern, so it stops at the
+ * first match from the end instead of enumerating every match.
+ *
+ * @return Iterator to the start of the last match, or text_last if not
+ *         found (or if the pattern is empty, like std::find_end)
+ *
+ * Complexity: O(n + m) time, O(m) space
+ */
+template <std::bidirectional_iterator TextIter, std::bidirectional_iterator PatternIter>
+[[nodiscard]] TextIter search_last(
+    TextIter text_first,
+    TextIter text_last,
+    PatternIter pattern_first,
+    PatternIter pattern_last
+) {
+    const auto n = static_cast<size_type>(std::distance(text_first, text_last));
+    const auto m = static_cast<size_type>(std::distance(pattern_first, pattern_last));
+
+    if (m == 0 || n < m) {
+        return text_last;
+    }
+
+    auto reverse_failure = detail::compute_reverse_failure(pattern_first, pattern_last);
+
+    // Forward KMP over the reversed text and pattern
+    auto search_scalar = [&]() {
+        auto rtext_last = std::make_reverse_iterator(text_first);
+        auto rit = detail::kmp_search_scalar(
+            std::make_reverse_iterator(text_last), rtext_last,
+            std::make_reverse_iterator(pattern_last), std::make_reverse_iterator(pattern_first),
+            reverse_failure);
+
+        if (rit == rtext_last) {
+            return text_last;
+        }
+        // The reversed match spans [rit, rit + m); its base is one past the end
+        return std::prev(rit.base(), static_cast<diff_type>(m));
+    };
+
     if constexpr (contiguous_char_iterator<TextIter> &&
                   contiguous_char_iterator<PatternIter>) {
 
@@ -148,26 +695,25 @@ template <std::forward_iterator TextIter, std::forward_iterator PatternIter>
         if (n >= config::simd_threshold) {
             #if KMP_HAS_AVX512
             if (detail::simd::has_avx512()) {
-                result = detail::simd::kmp_search_avx512(
-                    text_ptr, n, pattern_ptr, m, failure);
+                result = detail::simd::kmp_search_last_avx512(
+                    text_ptr, n, pattern_ptr, m, reverse_failure);
             } else
             #endif
             #if KMP_HAS_AVX2
             if (detail::simd::has_avx2()) {
-                result = detail::simd::kmp_search_avx2(
-                    text_ptr, n, pattern_ptr, m, failure);
+                result = detail::simd::kmp_search_last_avx2(
+                    text_ptr, n, pattern_ptr, m, reverse_failure);
             } else
             #endif
             #if KMP_HAS_SSE42
             if (detail::simd::has_sse42()) {
-                result = detail::simd::kmp_search_sse42(
-                    text_ptr, n, pattern_ptr, m, failure);
+                result = detail::simd::kmp_search_last_sse42(
+                    text_ptr, n, pattern_ptr, m, reverse_failure);
             } else
             #endif
             {
                 // Scalar fallback
-                return detail::kmp_search_scalar(
-                    text_first, text_last, pattern_first, pattern_last, failure);
+                return search_scalar();
             }
 
             if (result) {
@@ -178,37 +724,26 @@ template <std::forward_iterator TextIter, std::forward_iterator PatternIter>
     }
 
     // Scalar fallback for non-contiguous or small inputs
-    return detail::kmp_search_scalar(
-        text_first, text_last, pattern_first, pattern_last, failure);
-}
-
-// =============================================================================
-// Convenience Overloads
-// =============================================================================
-
-/**
- * @brief Search using string_view
- */
-[[nodiscard]] inline std::string_view::iterator search(
-    std::string_view text,
-    std::string_view pattern
-) {
-    auto it = search(text.begin(), text.end(), pattern.begin(), pattern.end());
-    return it;
+    return search_scalar();
 }
 
 /**
- * @brief Search returning position instead of iterator
+ * @brief Position of the last occurrence of pattern in text
+ *
+ * Like std::string_view::rfind: an empty pattern matches at text.size().
  */
-[[nodiscard]] inline std::optional<size_type> search_pos(
+[[nodiscard]] inline std::optional<size_type> rfind(
     std::string_view text,
     std::string_view pattern
 ) {
-    auto it = search(text.begin(), text.end(), pattern.begin(), pattern.end());
+    if (pattern.empty()) {
+        return text.size();
+    }
+    auto it = search_last(text.begin(), text.end(), pattern.begin(), pattern.end());
     if (it == text.end()) {
         return std::nullopt;
     }
-    return static_cast<size_type>(std::distance(text.begin(), it));
+    return static_cast<size_type>(it - text.begin());
 }
 
 // =============================================================================
@@ -219,13 +754,14 @@ template <std::forward_iterator TextIter, std::forward_iterator PatternIter>
  * @brief Find all occurrences of pattern in text
  *
  * Returns a C++23 generator that yields positions of all matches.
- * Allows overlapping matches.
+ * Allows overlapping matches unless mode is match_mode::non_overlapping.
  *
  * @return std::generator<size_type> yielding match positions
  */
 [[nodiscard]] inline std::generator<size_type> search_all(
     std::string_view text,
-    std::string_view pattern
+    std::string_view pattern,
+    match_mode mode = match_mode::overlapping
 ) {
     const auto n = text.size();
     const auto m = pattern.size();
@@ -248,22 +784,29 @@ template <std::forward_iterator TextIter, std::forward_iterator PatternIter>
 
         if (j == m) {
             co_yield i - m + 1;
-            j = failure[j - 1];  // Continue searching (overlapping)
+            // Continue searching (overlapping), or restart after the match
+            j = mode == match_mode::overlapping ? failure[j - 1] : 0;
         }
     }
 }
 
 /**
  * @brief Find all occurrences and return as vector
+ *
+ * Uses the SIMD search-all kernels for large texts.
  */
 [[nodiscard]] inline std::vector<size_type> search_all_vec(
     std::string_view text,
-    std::string_view pattern
+    std::string_view pattern,
+    match_mode mode = match_mode::overlapping
 ) {
     std::vector<size_type> results;
-    for (auto pos : search_all(text, pattern)) {
-        results.push_back(pos);
+    if (pattern.empty() || text.size() < pattern.size()) {
+        return results;
     }
+    auto failure = detail::compute_failure(pattern.begin(), pattern.end());
+    detail::find_all(text, pattern, failure, std::back_inserter(results), mode,
+                     detail::select_anchor(pattern));
     return results;
 }
 
@@ -276,12 +819,245 @@ template <std::forward_iterator TextIter, std::forward_iterator PatternIter>
  */
 [[nodiscard]] inline size_type count(
     std::string_view text,
-    std::string_view pattern
+    std::string_view pattern,
+    match_mode mode = match_mode::overlapping
 ) {
+    if (pattern.empty() || text.size() < pattern.size()) {
+        return 0;
+    }
+    auto failure = detail::compute_failure(pattern.begin(), pattern.end());
     size_type result = 0;
-    for ([[maybe_unused]] auto _ : search_all(text, pattern)) {
-        ++result;
+    detail::find_all(text, pattern, failure,
+                     detail::callback_output_iterator([&](size_type) { ++result; }),
+                     mode, detail::select_anchor(pattern));
+    return result;
+}
+
+// =============================================================================
+// Output-Buffer Search
+// =============================================================================
+
+/**
+ * @brief Write match positions into a caller-provided buffer
+ *
+ * Fills out with positions of matches starting at or after from and
+ * stops as soon as it is full, without allocating. While written equals
+ * out.size() more matches may follow; call again with from = resume.
+ * Otherwise the scan reached the end of the text and resume is text.size().
+ */
+[[nodiscard]] inline search_into_result search_all_into(
+    std::string_view text,
+    std::string_view pattern,
+    std::span<size_type> out,
+    size_type from = 0,
+    match_mode mode = match_mode::overlapping
+) {
+    if (out.empty()) {
+        return {0, from};
+    }
+    if (pattern.empty() || from >= text.size() || text.size() - from < pattern.size()) {
+        return {0, text.size()};
+    }
+    auto failure = detail::compute_failure(pattern.begin(), pattern.end());
+    return detail::search_into_prepared(
+        text, pattern, failure, detail::select_anchor(pattern), out, from, mode);
+}
+
+// =============================================================================
+// Segmented Search
+// =============================================================================
+
+/**
+ * @brief Find the first occurrence in text split across segments
+ *
+ * Searches the concatenation of the segments without copying them;
+ * matches may cross segment boundaries. Each segment is scanned with the
+ * SIMD kernels, and positions are logical offsets into the concatenation.
+ *
+ * @return Logical position of the first match (0 for an empty pattern)
+ */
+template <text_segments Segments>
+[[nodiscard]] std::optional<size_type> search_segmented(
+    Segments&& segments,
+    std::string_view pattern
+) {
+    if (pattern.empty()) {
+        return 0;
+    }
+    auto failure = detail::compute_failure(pattern.begin(), pattern.end());
+    std::optional<size_type> result;
+    detail::segmented_find_all(
+        segments, pattern, failure, detail::select_anchor(pattern),
+        detail::callback_output_iterator([&](size_type pos) { result = pos; }), 1);
+    return result;
+}
+
+/**
+ * @brief Write every (overlapping) occurrence across segments to out
+ */
+template <text_segments Segments, std::output_iterator<size_type> OutputIt>
+OutputIt search_all_segmented(
+    Segments&& segments,
+    std::string_view pattern,
+    OutputIt out
+) {
+    if (pattern.empty()) {
+        return out;
+    }
+    auto failure = detail::compute_failure(pattern.begin(), pattern.end());
+    return detail::segmented_find_all(
+        segments, pattern, failure, detail::select_anchor(pattern), out);
+}
+
+/**
+ * @brief Find every (overlapping) occurrence across segments
+ */
+template <text_segments Segments>
+[[nodiscard]] std::vector<size_type> search_all_segmented(
+    Segments&& segments,
+    std::string_view pattern
+) {
+    std::vector<size_type> results;
+    search_all_segmented(std::forward<Segments>(segments), pattern, std::back_inserter(results));
+    return results;
+}
+
+// =============================================================================
+// Replace All
+// =============================================================================
+
+/**
+ * @brief Replace every non-overlapping occurrence of pattern
+ *
+ * The first pass counts leftmost non-overlapping matches, giving the exact
+ * output size; the second writes the result into a single allocation with
+ * bulk memcpys. An empty pattern leaves the text unchanged.
+ */
+[[nodiscard]] inline std::string replace_all(
+    std::string_view text,
+    std::string_view pattern,
+    std::string_view replacement
+) {
+    const size_type m = pattern.size();
+    if (m == 0 || text.size() < m) {
+        return std::string(text);
+    }
+
+    auto failure = detail::compute_failure(pattern.begin(), pattern.end());
+    const size_type anchor = detail::select_anchor(pattern);
+
+    size_type matches = 0;
+    detail::find_all(text, pattern, failure,
+                     detail::callback_output_iterator([&](size_type) { ++matches; }),
+                     match_mode::non_overlapping, anchor);
+    if (matches == 0) {
+        return std::string(text);
     }
+
+    const size_type size = text.size() - matches * m + matches * replacement.size();
+    std::string result;
+    result.resize_and_overwrite(size, [&](char* buffer, size_type) {
+        char* dst = buffer;
+        size_type copied = 0;  // text consumed so far
+
+        detail::find_all(text, pattern, failure,
+            detail::callback_output_iterator([&](size_type pos) {
+                std::memcpy(dst, text.data() + copied, pos - copied);
+                dst += pos - copied;
+                if (!replacement.empty()) {
+                    std::memcpy(dst, replacement.data(), replacement.size());
+                    dst += replacement.size();
+                }
+                copied = pos + m;
+            }),
+            match_mode::non_overlapping, anchor);
+
+        std::memcpy(dst, text.data() + copied, text.size() - copied);
+        return size;
+    });
+    return result;
+}
+
+// =============================================================================
+// Element Sequences
+// =============================================================================
+
+namespace detail {
+
+template <element_sequence R>
+[[nodiscard]] auto as_span(const R& r) noexcept {
+    return std::span<const std::ranges::range_value_t<R>>(
+        std::ranges::data(r), std::ranges::size(r));
+}
+
+} // namespace detail
+
+/**
+ * @brief Find the first occurrence in a sequence of non-char elements
+ *
+ * Byte dumps (std::byte, std::uint8_t), UTF-16/32 text and 32-bit ID
+ * streams use the SIMD kernels at their own element width; other element
+ * types fall back to scalar KMP. Positions count elements, not bytes.
+ */
+template <element_sequence Text, element_sequence Pattern>
+    requires std::same_as<std::ranges::range_value_t<Text>,
+                          std::ranges::range_value_t<Pattern>>
+[[nodiscard]] std::optional<size_type> search_pos(
+    const Text& text,
+    const Pattern& pattern
+) {
+    const auto t = detail::as_span(text);
+    const auto p = detail::as_span(pattern);
+    auto it = search(t.begin(), t.end(), p.begin(), p.end());
+    if (it == t.end()) {
+        return std::nullopt;
+    }
+    return static_cast<size_type>(it - t.begin());
+}
+
+/**
+ * @brief Find all occurrences in a sequence of non-char elements
+ */
+template <element_sequence Text, element_sequence Pattern>
+    requires std::same_as<std::ranges::range_value_t<Text>,
+                          std::ranges::range_value_t<Pattern>>
+[[nodiscard]] std::vector<size_type> search_all_vec(
+    const Text& text,
+    const Pattern& pattern,
+    match_mode mode = match_mode::overlapping
+) {
+    const auto t = detail::as_span(text);
+    const auto p = detail::as_span(pattern);
+    std::vector<size_type> results;
+    if (p.empty() || t.size() < p.size()) {
+        return results;
+    }
+    auto failure = detail::compute_failure(p.begin(), p.end());
+    detail::find_all(t, p, failure, std::back_inserter(results), mode);
+    return results;
+}
+
+/**
+ * @brief Count occurrences in a sequence of non-char elements
+ */
+template <element_sequence Text, element_sequence Pattern>
+    requires std::same_as<std::ranges::range_value_t<Text>,
+                          std::ranges::range_value_t<Pattern>>
+[[nodiscard]] size_type count(
+    const Text& text,
+    const Pattern& pattern,
+    match_mode mode = match_mode::overlapping
+) {
+    const auto t = detail::as_span(text);
+    const auto p = detail::as_span(pattern);
+    if (p.empty() || t.size() < p.size()) {
+        return 0;
+    }
+    auto failure = detail::compute_failure(p.begin(), p.end());
+    size_type result = 0;
+    detail::find_all(t, p, failure,
+                     detail::callback_output_iterator([&](size_type) { ++result; }),
+                     mode);
     return result;
 }
 
@@ -0,0 +1,484 @@
+#pragma once
+
+/**
+ * @file suffix_automaton.hpp
+ * @brief Suffix automaton: substring index that grows by appending
+ *
+ * text_index and fm_index are built once over a static text; appending to
+ * the corpus means rebuilding them. The suffix automaton is extended one
+ * byte at a time in amortized O(1) and answers substring queries in O(m)
+ * at any point in between.
+ *
+ * Usage:
+ *   kmp::suffix_automaton automaton;
+ *   automaton.append(chunk);                   // as the corpus grows
+ *   automaton.contains("needle");              // O(m)
+ *   automaton.count("needle");                 // occurrences
+ *   auto common = automaton.longest_common_substring(other);
+ */
+
+#include "config.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace kmp {
+
+/**
+ * @brief Longest substring shared by the indexed text and another string
+ *
+ * position is its first occurrence in the text. length is 0 if the two
+ * share no byte.
+ */
+struct common_substring {
+    size_type position = 0;
+    size_type other_position = 0;
+    size_type length = 0;
+};
+
+// =============================================================================
+// Suffix Automaton
+// =============================================================================
+
+/**
+ * @brief Minimal DFA of all substrings of the text, built online
+ *
+ * A state stands for a set of substrings that end at the same positions;
+ * it has at most 2n - 1 states and 3n - 4 transitions. States are 32-byte
+ * records in one array that hold up to 3 transitions inline, so most
+ * steps touch one cache line. Larger states move their transitions to a
+ * pooled slot sized to a power of two (key bytes, then targets), and past
+ * config::automaton_dense_edges to a 256-entry table. Expect 60-100 bytes
+ * per text byte; prefer text_index or fm_index for static corpora.
+ *
+ * Occurrence counts need a pass over the suffix-link tree. It runs on the
+ * first count() after an append and is reused until the next append.
+ * Thread-safe for concurrent queries, not for concurrent append().
+ */
+class suffix_automaton {
+public:
+    suffix_automaton()
+        : counts_(std::make_shared<lazy_counts>())
+    {
+        new_state(0, 0, false);
+        states_[0].link = none;
+    }
+
+    explicit suffix_automaton(std::string_view text)
+        : suffix_automaton()
+    {
+        append(text);
+    }
+
+    // =========================================================================
+    // Construction
+    // =========================================================================
+
+    /**
+     * @brief Extend the text by one byte
+     * @throws std::length_error once the text reaches 2^31 - 1 bytes
+     */
+    void append(char c) {
+        if (size_ >= max_size) {
+            throw std::length_error("Text too large for suffix_automaton");
+        }
+        const auto byte = static_cast<unsigned char>(c);
+        const auto cur = new_state(states_[last_].len + 1, static_cast<std::uint32_t>(size_), false);
+
+        std::uint32_t p = last_;
+        while (p != none && target(p, byte) == 0) {
+            add_edge(p, byte, cur);
+            p = states_[p].link;
+        }
+
+        if (p == none) {
+            states_[cur].link = 0;
+        } else {
+            const std::uint32_t q = target(p, byte);
+            if (states_[p].len + 1 == states_[q].len) {
+                states_[cur].link = q;
+            } else {
+                const auto clone = new_state(states_[p].len + 1, states_[q].first_end, true);
+                copy_edges(q, clone);
+                states_[clone].link = states_[q].link;
+                while (p != none && target(p, byte) == q) {
+                    set_edge(p, byte, clone);
+                    p = states_[p].link;
+                }
+                states_[q].link = clone;
+                states_[cur].link = clone;
+            }
+        }
+
+        last_ = cur;
+        ++size_;
+        if (counts_.use_count() > 1 || counts_->valid) {
+            counts_ = std::make_shared<lazy_counts>();
+        }
+    }
+
+    /**
+     * @brief Extend the text by every byte of text
+     */
+    void append(std::string_view text) {
+        if (text.size() > max_size - size_) {
+            throw std::length_error("Text too large for suffix_automaton");
+        }
+        states_.reserve(states_.size() + 2 * text.size());
+        for (char c : text) {
+            append(c);
+        }
+    }
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+
+    /**
+     * @brief Whether pattern occurs in the text; false for an empty pattern
+     */
+    [[nodiscard]] bool contains(std::string_view pattern) const noexcept {
+        return find_state(pattern) != none;
+    }
+
+    /**
+     * @brief Occurrences of pattern (overlapping); 0 for an empty pattern
+     *
+     * The first call after append() derives the counts of all states in
+     * O(states).
+     */
+    [[nodiscard]] size_type count(std::string_view pattern) const {
+        const std::uint32_t s = find_state(pattern);
+        return s == none ? 0 : occurrences()[s];
+    }
+
+    /**
+     * @brief First occurrence of pattern
+     */
+    [[nodiscard]] std::optional<size_type> search_pos(std::string_view pattern) const noexcept {
+        const std::uint32_t s = find_state(pattern);
+        if (s == none) {
+            return std::nullopt;
+        }
+        return size_type{states_[s].first_end} + 1 - pattern.size();
+    }
+
+    /**
+     * @brief Length of the longest prefix of pattern that occurs in the text
+     */
+    [[nodiscard]] size_type longest_prefix(std::string_view pattern) const noexcept {
+        std::uint32_t s = 0;
+        for (size_type i = 0; i < pattern.size(); ++i) {
+            s = target(s, static_cast<unsigned char>(pattern[i]));
+            if (s == 0) {
+                return i;
+            }
+        }
+        return pattern.size();
+    }
+
+    /**
+     * @brief Longest substring of other that occurs in the text, O(|other|)
+     *
+     * Ties go to the earliest position in other.
+     */
+    [[nodiscard]] common_substring longest_common_substring(std::string_view other) const noexcept {
+        common_substring best;
+        std::uint32_t s = 0;
+        size_type length = 0;
+        for (size_type i = 0; i < other.size(); ++i) {
+            const auto byte = static_cast<unsigned char>(other[i]);
+            while (s != 0 && target(s, byte) == 0) {
+                s = states_[s].link;
+                length = states_[s].len;
+            }
+            if (const std::uint32_t next = target(s, byte); next != 0) {
+                s = next;
+                ++length;
+            } else {
+                length = 0;
+            }
+
+            if (length > best.length) {
+                best.length = length;
+                best.position = size_type{states_[s].first_end} + 1 - length;
+                best.other_position = i + 1 - length;
+            }
+        }
+        return best;
+    }
+
+    // =========================================================================
+    // Accessors
+    // =========================================================================
+
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_type state_count() const noexcept { return states_.size(); }
+
+    /**
+     * @brief Heap bytes held by the automaton (excluding cached counts)
+     */
+    [[nodiscard]] size_type memory_bytes() const noexcept {
+        size_type bytes = states_.capacity() * sizeof(state) +
+                          (pool_.capacity() + dense_.capacity()) * sizeof(std::uint32_t);
+        for (const auto& list : free_slots_) {
+            bytes += list.capacity() * sizeof(std::uint32_t);
+        }
+        return bytes;
+    }
+
+private:
+    static constexpr std::uint32_t none = 0xFFFFFFFF;
+    static constexpr size_type max_size = 0x7FFFFFFF;  // 2n states must fit in uint32
+    static constexpr unsigned inline_edges = 3;
+
+    // Edge storage of a state: inline, pool slot of 2 << storage edges, or dense
+    static constexpr std::uint8_t inline_storage = 0;
+    static constexpr std::uint8_t dense_storage = 0xFF;
+    static constexpr unsigned slot_classes = std::countr_zero(config::automaton_dense_edges) - 1;
+
+    static_assert(std::has_single_bit(config::automaton_dense_edges) &&
+                  config::automaton_dense_edges >= 4 && config::automaton_dense_edges <= 128);
+
+    // One record per state, half a cache line. Transitions to state 0 never
+    // occur, so target 0 means "no edge".
+    struct alignas(32) state {
+        std::uint32_t len = 0;        // longest substring of the state
+        std::uint32_t link = 0;       // suffix link
+        std::uint32_t first_end = 0;  // end position of the first occurrence
+        std::uint8_t edge_count = 0;  // unused for dense states
+        std::uint8_t storage = inline_storage;
+        bool clone = false;           // created by a split; owns no end position
+        std::uint8_t keys[inline_edges] = {};
+        std::uint32_t targets[inline_edges] = {};  // targets[0]: slot offset or
+                                                   // dense index once spilled
+    };
+    static_assert(sizeof(state) == 32);
+
+    // Occurrences per state, derived on first use after an append
+    struct lazy_counts {
+        std::once_flag once;
+        bool valid = false;
+        std::vector<std::uint32_t> counts;
+    };
+
+    std::vector<state> states_;
+    std::vector<std::uint32_t> pool_;   // slots: capacity / 4 words of keys, then targets
+    std::vector<std::uint32_t> dense_;  // 256 targets per dense state
+    std::vector<std::uint32_t> free_slots_[slot_classes];
+    std::uint32_t last_ = 0;            // state of the whole text
+    size_type size_ = 0;
+    std::shared_ptr<lazy_counts> counts_;
+
+    [[nodiscard]] static constexpr unsigned capacity(std::uint8_t storage) noexcept {
+        return storage == inline_storage ? inline_edges : 2u << storage;
+    }
+
+    [[nodiscard]] static constexpr size_type slot_words(std::uint8_t storage) noexcept {
+        return capacity(storage) / 4 + capacity(storage);
+    }
+
+    std::uint32_t new_state(std::uint32_t len, std::uint32_t first_end, bool clone) {
+        state s;
+        s.len = len;
+        s.first_end = first_end;
+        s.clone = clone;
+        states_.push_back(s);
+        return static_cast<std::uint32_t>(states_.size() - 1);
+    }
+
+    // Keys and targets of a sparse (inline or slot) state
+    [[nodiscard]] const std::uint8_t* keys(const state& st) const noexcept {
+        return st.storage == inline_storage
+            ? st.keys
+            : reinterpret_cast<const std::uint8_t*>(pool_.data() + st.targets[0]);
+    }
+
+    [[nodiscard]] const std::uint32_t* targets(const state& st) const noexcept {
+        return st.storage == inline_storage
+            ? st.targets
+            : pool_.data() + st.targets[0] + capacity(st.storage) / 4;
+    }
+
+    [[nodiscard]] std::uint8_t* keys(state& st) noexcept {
+        return st.storage == inline_storage
+            ? st.keys
+            : reinterpret_cast<std::uint8_t*>(pool_.data() + st.targets[0]);
+    }
+
+    [[nodiscard]] std::uint32_t* targets(state& st) noexcept {
+        return st.storage == inline_storage
+            ? st.targets
+            : pool_.data() + st.targets[0] + capacity(st.storage) / 4;
+    }
+
+    [[nodiscard]] std::uint32_t target(std::uint32_t s, unsigned char byte) const noexcept {
+        const state& st = states_[s];
+        if (st.storage == dense_storage) {
+            return dense_[size_type{st.targets[0]} * 256 + byte];
+        }
+        const std::uint8_t* k = keys(st);
+        for (unsigned i = 0; i < st.edge_count; ++i) {
+            if (k[i] == byte) {
+                return targets(st)[i];
+            }
+        }
+        return 0;
+    }
+
+    std::uint32_t allocate_slot(std::uint8_t storage) {
+        auto& free_list = free_slots_[storage - 1];
+        if (!free_list.empty()) {
+            const std::uint32_t offset = free_list.back();
+            free_list.pop_back();
+            return offset;
+        }
+        const auto offset = static_cast<std::uint32_t>(pool_.size());
+        pool_.resize(pool_.size() + slot_words(storage));
+        return offset;
+    }
+
+    std::uint32_t allocate_dense() {
+        const auto index = static_cast<std::uint32_t>(dense_.size() / 256);
+        dense_.resize(dense_.size() + 256, 0);
+        return index;
+    }
+
+    void add_edge(std::uint32_t s, unsigned char byte, std::uint32_t to) {
+        if (states_[s].storage != dense_storage &&
+            states_[s].edge_count == capacity(states_[s].storage)) {
+            grow(s);
+        }
+        state& st = states_[s];
+        if (st.storage == dense_storage) {
+            dense_[size_type{st.targets[0]} * 256 + byte] = to;
+            return;
+        }
+        keys(st)[st.edge_count] = byte;
+        targets(st)[st.edge_count] = to;
+        ++st.edge_count;
+    }
+
+    void set_edge(std::uint32_t s, unsigned char byte, std::uint32_t to) noexcept {
+        state& st = states_[s];
+        if (st.storage == dense_storage) {
+            dense_[size_type{st.targets[0]} * 256 + byte] = to;
+            return;
+        }
+        const std::uint8_t* k = keys(st);
+        for (unsigned i = 0; i < st.edge_count; ++i) {
+            if (k[i] == byte) {
+                targets(st)[i] = to;
+                return;
+            }
+        }
+    }
+
+    // Move full edges to a slot twice the size, or to a dense table
+    void grow(std::uint32_t s) {
+        const state old = states_[s];
+        std::uint8_t old_keys[128];
+        std::uint32_t old_targets[128];
+        std::copy_n(keys(old), old.edge_count, old_keys);
+        std::copy_n(targets(old), old.edge_count, old_targets);
+        if (old.storage != inline_storage) {
+            free_slots_[old.storage - 1].push_back(old.targets[0]);
+        }
+
+        state& st = states_[s];
+        if (capacity(old.storage) >= config::automaton_dense_edges) {
+            const std::uint32_t index = allocate_dense();
+            for (unsigned i = 0; i < old.edge_count; ++i) {
+                dense_[size_type{index} * 256 + old_keys[i]] = old_targets[i];
+            }
+            st.storage = dense_storage;
+            st.targets[0] = index;
+            return;
+        }
+        st.storage = static_cast<std::uint8_t>(old.storage + 1);
+        st.targets[0] = allocate_slot(st.storage);
+        std::copy_n(old_keys, old.edge_count, keys(st));
+        std::copy_n(old_targets, old.edge_count, targets(st));
+    }
+
+    // Give a fresh clone the edges of from
+    void copy_edges(std::uint32_t from, std::uint32_t to) {
+        const state src = states_[from];
+        state& dst = states_[to];
+        dst.edge_count = src.edge_count;
+        dst.storage = src.storage;
+
+        if (src.storage == inline_storage) {
+            std::copy_n(src.keys, inline_edges, dst.keys);
+            std::copy_n(src.targets, inline_edges, dst.targets);
+        } else if (src.storage == dense_storage) {
+            const std::uint32_t index = allocate_dense();
+            std::copy_n(dense_.begin() + size_type{src.targets[0]} * 256, 256,
+                        dense_.begin() + size_type{index} * 256);
+            dst.targets[0] = index;
+        } else {
+            const std::uint32_t offset = allocate_slot(src.storage);
+            std::copy_n(pool_.begin() + src.targets[0], slot_words(src.storage),
+                        pool_.begin() + offset);
+            dst.targets[0] = offset;
+        }
+    }
+
+    [[nodiscard]] std::uint32_t find_state(std::string_view pattern) const noexcept {
+        if (pattern.empty() || pattern.size() > size_) {
+            return none;
+        }
+        std::uint32_t s = 0;
+        for (char c : pattern) {
+            s = target(s, static_cast<unsigned char>(c));
+            if (s == 0) {
+                return none;
+            }
+        }
+        return s;
+    }
+
+    // Every non-clone state ends one prefix of the text; a state's
+    // occurrences are those in its suffix-link subtree. Longer states are
+    // deeper, so summing into the link in decreasing len order suffices.
+    [[nodiscard]] const std::vector<std::uint32_t>& occurrences() const {
+        std::call_once(counts_->once, [this] {
+            const size_type n = states_.size();
+            std::vector<std::uint32_t> by_len(size_ + 2, 0);
+            for (const auto& st : states_) {
+                ++by_len[st.len + 1];
+            }
+            for (size_type i = 1; i < by_len.size(); ++i) {
+                by_len[i] += by_len[i - 1];
+            }
+            std::vector<std::uint32_t> order(n);
+            for (size_type s = 0; s < n; ++s) {
+                order[by_len[states_[s].len]++] = static_cast<std::uint32_t>(s);
+            }
+
+            auto& counts = counts_->counts;
+            counts.assign(n, 0);
+            for (size_type s = 1; s < n; ++s) {
+                counts[s] = states_[s].clone ? 0 : 1;
+            }
+            for (size_type i = n; i-- > 1;) {
+                const std::uint32_t s = order[i];
+                if (states_[s].link != none) {
+                    counts[states_[s].link] += counts[s];
+                }
+            }
+            counts_->valid = true;
+        });
+        return counts_->counts;
+    }
+};
+
+} // namespace kmp
@@ -0,0 +1,403 @@
+#pragma once
+
+/**
+ * @file text_index.hpp
+ * @brief Suffix-array index for repeated queries over a static text
+ *
+ * A search scans the whole text; an index pays O(n) once and then answers
+ * each query with a binary search over the sorted suffixes. Worth it when
+ * the same corpus is queried many times.
+ *
+ * Usage:
+ *   kmp::text_index index(corpus);
+ *   auto n = index.count("needle");                  // O(m log n)
+ *   auto blob = index.serialize();                   // write to disk ...
+ *   auto mapped = kmp::text_index::view(file_bytes); // ... mmap it back
+ */
+
+#include "config.hpp"
+#include "detail/suffix_array.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <generator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace kmp {
+
+namespace detail {
+
+// =============================================================================
+// Index Blob Layout
+// =============================================================================
+
+/**
+ * @brief Header of a text_index blob
+ *
+ * Followed by three 8-byte aligned sections: the text, the suffix array
+ * and the LCP array (std::uint32_t each). Built indexes use the same
+ * layout in memory, so a serialized blob can be queried in place.
+ */
+struct text_index_header {
+    static constexpr std::array<char, 4> expected_magic{'K', 'S', 'A', 'I'};
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::uint32_t native_endian_tag = 0x01020304;
+    static constexpr std::uint32_t swapped_endian_tag = 0x04030201;
+
+    std::array<char, 4> magic;
+    std::uint32_t endian_tag;
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t text_size;
+    std::uint64_t total_size;
+};
+
+static_assert(sizeof(text_index_header) == 32);
+
+/**
+ * @brief Section offsets of a text_index blob
+ */
+struct text_index_layout {
+    size_type text;
+    size_type suffixes;
+    size_type lcp;
+    size_type total;
+
+    [[nodiscard]] static text_index_layout compute(size_type n) noexcept {
+        auto align8 = [](size_type v) { return (v + 7) & ~size_type{7}; };
+        text_index_layout layout;
+        layout.text = sizeof(text_index_header);
+        layout.suffixes = align8(layout.text + n);
+        layout.lcp = align8(layout.suffixes + n * sizeof(std::uint32_t));
+        layout.total = align8(layout.lcp + n * sizeof(std::uint32_t));
+        return layout;
+    }
+};
+
+} // namespace detail
+
+// =============================================================================
+// Text Index
+// =============================================================================
+
+/**
+ * @brief Suffix array and LCP array over a copy of a text
+ *
+ * Queries binary-search the suffix array, skipping the prefix already
+ * shared with both ends of the search interval, so a lookup compares
+ * O(m log n) bytes at worst and close to O(m + log n) in practice.
+ * Either owns its blob (built from a text) or views a serialized blob in
+ * caller memory, e.g. an mmapped index file. Thread-safe for concurrent
+ * queries.
+ */
+class text_index {
+public:
+    text_index() = default;
+
+    /**
+     * @brief Build the index for a copy of text
+     *
+     * The suffix array is built with SA-IS; the LCP array by up to
+     * `threads` workers (0 = one per hardware thread), each taking at
+     * least config::parallel_index_grain bytes of text.
+     *
+     * @throws std::length_error if the text is 4 GiB or larger
+     */
+    explicit text_index(std::string_view text, unsigned threads = 0) {
+        if (text.size() >= size_type{0xFFFFFFFF}) {
+            throw std::length_error("Text too large for text_index");
+        }
+
+        const size_type n = text.size();
+        const auto layout = detail::text_index_layout::compute(n);
+        storage_.assign(layout.total / sizeof(std::uint64_t), 0);
+        auto* base = reinterpret_cast<std::byte*>(storage_.data());
+
+        detail::text_index_header header{};
+        header.magic = detail::text_index_header::expected_magic;
+        header.endian_tag = detail::text_index_header::native_endian_tag;
+        header.version = detail::text_index_header::current_version;
+        header.text_size = n;
+        header.total_size = layout.total;
+        std::memcpy(base, &header, sizeof(header));
+        if (n > 0) {
+            std::memcpy(base + layout.text, text.data(), n);
+        }
+
+        auto* suffixes = reinterpret_cast<std::uint32_t*>(base + layout.suffixes);
+        auto* lcp = reinterpret_cast<std::uint32_t*>(base + layout.lcp);
+        detail::build_suffix_array(text, suffixes);
+
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        const size_type workers = std::max<size_type>(
+            1, std::min<size_type>(threads, n / config::parallel_index_grain));
+        detail::build_lcp_array(text, suffixes, lcp, workers);
+
+        bind(base);
+    }
+
+    /**
+     * @brief Use a serialized index in place, without copying or rebuilding
+     *
+     * The blob must be 8-byte aligned (mmapped files and serialize()
+     * output are) and outlive the returned index. Only the header is
+     * checked; the arrays are trusted to come from serialize().
+     *
+     * @throws std::runtime_error if the header is invalid, from another
+     *         format version, or was written with a different byte order
+     */
+    [[nodiscard]] static text_index view(std::span<const std::byte> blob) {
+        validate(blob);
+        text_index index;
+        index.bind(blob.data());
+        return index;
+    }
+
+    text_index(const text_index& other)
+        : storage_(other.storage_)
+    {
+        bind(storage_.empty() ? other.blob_ : reinterpret_cast<const std::byte*>(storage_.data()));
+    }
+
+    text_index(text_index&& other) noexcept
+        : storage_(std::move(other.storage_))
+    {
+        bind(storage_.empty() ? other.blob_ : reinterpret_cast<const std::byte*>(storage_.data()));
+        other.bind(nullptr);
+    }
+
+    text_index& operator=(text_index other) noexcept {
+        storage_ = std::move(other.storage_);
+        bind(storage_.empty() ? other.blob_ : reinterpret_cast<const std::byte*>(storage_.data()));
+        other.bind(nullptr);
+        return *this;
+    }
+
+    ~text_index() = default;
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+
+    /**
+     * @brief Start positions of pattern, in suffix order (not sorted)
+     *
+     * A view into the suffix array; empty if the pattern does not occur.
+     * An empty pattern matches nowhere, as in search.hpp.
+     */
+    [[nodiscard]] std::span<const std::uint32_t> equal_range(std::string_view pattern) const noexcept {
+        if (pattern.empty() || pattern.size() > text_.size()) {
+            return {};
+        }
+        const size_type first = bound(pattern, false);
+        const size_type last = bound(pattern, true);
+        return suffixes_.subspan(first, last - first);
+    }
+
+    [[nodiscard]] size_type count(std::string_view pattern) const noexcept {
+        return equal_range(pattern).size();
+    }
+
+    [[nodiscard]] bool contains(std::string_view pattern) const noexcept {
+        return !equal_range(pattern).empty();
+    }
+
+    /**
+     * @brief First occurrence of pattern (O(m log n + occurrences))
+     */
+    [[nodiscard]] std::optional<size_type> search_pos(std::string_view pattern) const noexcept {
+        const auto range = equal_range(pattern);
+        if (range.empty()) {
+            return std::nullopt;
+        }
+        return *std::min_element(range.begin(), range.end());
+    }
+
+    /**
+     * @brief All occurrences of pattern, in increasing order (overlapping)
+     */
+    [[nodiscard]] std::vector<size_type> search_all_vec(std::string_view pattern) const {
+        const auto range = equal_range(pattern);
+        std::vector<size_type> positions(range.begin(), range.end());
+        std::sort(positions.begin(), positions.end());
+        return positions;
+    }
+
+    /**
+     * @brief All occurrences of pattern, in increasing order (generator)
+     */
+    [[nodiscard]] std::generator<size_type> search_all(std::string_view pattern) const {
+        for (size_type pos : search_all_vec(pattern)) {
+            co_yield pos;
+        }
+    }
+
+    /**
+     * @brief Longest substring that occurs at least twice (first by position
+     *        among equally long ones); empty if none
+     */
+    [[nodiscard]] std::string_view longest_repeat() const noexcept {
+        size_type best = 0;
+        size_type pos = 0;
+        for (size_type i = 1; i < lcp_.size(); ++i) {
+            const size_type start = std::min(suffixes_[i - 1], suffixes_[i]);
+            if (lcp_[i] > best || (lcp_[i] == best && best > 0 && start < pos)) {
+                best = lcp_[i];
+                pos = start;
+            }
+        }
+        return text_.substr(pos, best);
+    }
+
+    // =========================================================================
+    // Accessors
+    // =========================================================================
+
+    [[nodiscard]] std::string_view text() const noexcept { return text_; }
+    [[nodiscard]] size_type size() const noexcept { return text_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return text_.empty(); }
+
+    /**
+     * @brief Suffix start positions in lexicographic order
+     */
+    [[nodiscard]] std::span<const std::uint32_t> suffix_array() const noexcept { return suffixes_; }
+
+    /**
+     * @brief lcp()[i]: common prefix length of suffixes i - 1 and i (lcp()[0] = 0)
+     */
+    [[nodiscard]] std::span<const std::uint32_t> lcp() const noexcept { return lcp_; }
+
+    /**
+     * @brief Whether the arrays live in caller memory (see view())
+     */
+    [[nodiscard]] bool is_view() const noexcept {
+        return blob_ != nullptr && storage_.empty();
+    }
+
+    /**
+     * @brief Index blob bytes; empty for a default-constructed index
+     */
+    [[nodiscard]] std::span<const std::byte> blob() const noexcept {
+        if (!blob_) {
+            return {};
+        }
+        return {blob_, static_cast<size_type>(header().total_size)};
+    }
+
+    /**
+     * @brief Copy the index blob into a new buffer (see view())
+     */
+    [[nodiscard]] std::vector<std::byte> serialize() const {
+        auto bytes = blob();
+        return {bytes.begin(), bytes.end()};
+    }
+
+private:
+    std::vector<std::uint64_t> storage_;  // owned blob; empty for views
+    const std::byte* blob_ = nullptr;
+
+    std::string_view text_;
+    std::span<const std::uint32_t> suffixes_;
+    std::span<const std::uint32_t> lcp_;
+
+    [[nodiscard]] const detail::text_index_header& header() const noexcept {
+        return *reinterpret_cast<const detail::text_index_header*>(blob_);
+    }
+
+    /**
+     * @brief First suffix whose m-byte prefix is >= pattern, or > pattern
+     *        with upper
+     *
+     * Suffixes between the interval ends share at least min(lo_match,
+     * hi_match) bytes with the pattern, so comparisons start there.
+     */
+    [[nodiscard]] size_type bound(std::string_view pattern, bool upper) const noexcept {
+        const size_type m = pattern.size();
+        const size_type n = text_.size();
+        size_type lo = 0;
+        size_type hi = n;
+        size_type lo_match = 0;
+        size_type hi_match = 0;
+
+        while (lo < hi) {
+            const size_type mid = lo + (hi - lo) / 2;
+            const size_type pos = suffixes_[mid];
+            size_type i = std::min(lo_match, hi_match);
+            while (i < m && pos + i < n && text_[pos + i] == pattern[i]) {
+                ++i;
+            }
+
+            // Suffix prefix < pattern: a proper prefix, or a smaller byte
+            const bool less = i < m && (pos + i == n ||
+                static_cast<unsigned char>(text_[pos + i]) < static_cast<unsigned char>(pattern[i]));
+            if (less || (upper && i == m)) {
+                lo = mid + 1;
+                lo_match = i;
+            } else {
+                hi = mid;
+                hi_match = i;
+            }
+        }
+        return lo;
+    }
+
+    static detail::text_index_header validate(std::span<const std::byte> blob) {
+        if (blob.size() < sizeof(detail::text_index_header)) {
+            throw std::runtime_error("Index blob too small");
+        }
+        if (reinterpret_cast<std::uintptr_t>(blob.data()) % alignof(std::uint64_t) != 0) {
+            throw std::runtime_error("Index blob must be 8-byte aligned");
+        }
+
+        detail::text_index_header h;
+        std::memcpy(&h, blob.data(), sizeof(h));
+
+        if (h.magic != detail::text_index_header::expected_magic) {
+            throw std::runtime_error("Not a text index blob");
+        }
+        if (h.endian_tag == detail::text_index_header::swapped_endian_tag) {
+            throw std::runtime_error("Index blob was written with a different byte order");
+        }
+        if (h.endian_tag != detail::text_index_header::native_endian_tag) {
+            throw std::runtime_error("Corrupt index blob header");
+        }
+        if (h.version != detail::text_index_header::current_version) {
+            throw std::runtime_error("Unsupported index blob version");
+        }
+        if (h.text_size >= 0xFFFFFFFFu ||
+            h.total_size != detail::text_index_layout::compute(h.text_size).total) {
+            throw std::runtime_error("Corrupt index blob header");
+        }
+        if (blob.size() < h.total_size) {
+            throw std::runtime_error("Index blob truncated");
+        }
+        return h;
+    }
+
+    void bind(const std::byte* blob) noexcept {
+        blob_ = blob;
+        if (!blob) {
+            text_ = {};
+            suffixes_ = {};
+            lcp_ = {};
+            return;
+        }
+
+        const auto n = static_cast<size_type>(header().text_size);
+        const auto layout = detail::text_index_layout::compute(n);
+        text_ = {reinterpret_cast<const char*>(blob + layout.text), n};
+        suffixes_ = {reinterpret_cast<const std::uint32_t*>(blob + layout.suffixes), n};
+        lcp_ = {reinterpret_cast<const std::uint32_t*>(blob + layout.lcp), n};
+    }
+};
+
+} // namespace kmp
@@ -0,0 +1,278 @@
+#pragma once
+
+/**
+ * @file trigram_index.hpp
+ * @brief Trigram inverted index for searching many small documents
+ *
+ * Scanning every document costs the whole collection per query. The index
+ * maps each trigram (3-byte substring) to the documents containing it, so
+ * a query first narrows the collection to documents holding every trigram
+ * a match needs, then verifies only those with the regular search.
+ *
+ * Usage:
+ *   kmp::trigram_index index;
+ *   for (auto& doc : docs) index.add(doc);
+ *   auto ids = index.search(kmp::literal_pattern("needle"));
+ *   auto hits = index.search(kmp::regex_pattern("err(or|no) [0-9]+"));
+ */
+
+#include "config.hpp"
+#include "pattern.hpp"
+#include "detail/trigram.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace kmp {
+
+// =============================================================================
+// Trigram Query
+// =============================================================================
+
+/**
+ * @brief Trigrams a document must contain to possibly match a pattern
+ *
+ * An AND of clauses, each an OR of trigram keys (see
+ * detail::trigram_key()). No clauses means every document is a candidate,
+ * e.g. for patterns shorter than 3 bytes or regexes like "a.*b".
+ */
+struct trigram_query {
+    std::vector<std::vector<std::uint32_t>> clauses;
+
+    [[nodiscard]] bool matches_all() const noexcept { return clauses.empty(); }
+
+    /**
+     * @brief Every trigram of a literal
+     */
+    [[nodiscard]] static trigram_query plan(std::string_view literal) {
+        trigram_query query;
+        detail::add_set_clauses(query.clauses, {std::string(literal)});
+        detail::simplify_clauses(query.clauses);
+        return query;
+    }
+
+    [[nodiscard]] static trigram_query plan(const literal_pattern& pattern) {
+        return plan(pattern.pattern());
+    }
+
+    /**
+     * @brief Trigrams required by the regex's literal factors, e.g.
+     *        "(foo|bar)baz" needs foo or bar, oob or arb, oba or rba, and baz
+     */
+    [[nodiscard]] static trigram_query plan(const regex_pattern& pattern) {
+        trigram_query query;
+        query.clauses = detail::trigram_planner(pattern.source()).plan();
+        return query;
+    }
+};
+
+// =============================================================================
+// Trigram Index
+// =============================================================================
+
+/**
+ * @brief Documents with per-trigram posting lists of document ids
+ *
+ * Keeps a copy of every document for verification. Ids are assigned in
+ * insertion order starting at 0. Queries take the clauses rarest first
+ * and stop once the remaining ones would cost more to decode than
+ * verifying the candidates left (config::trigram_verify_cost).
+ * Thread-safe for concurrent queries, not for concurrent add().
+ */
+class trigram_index {
+public:
+    trigram_index() = default;
+
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+    explicit trigram_index(R&& documents) {
+        for (auto&& document : documents) {
+            add(std::string_view(document));
+        }
+    }
+
+    /**
+     * @brief Add a document and index its trigrams
+     * @return The document's id
+     * @throws std::length_error past 2^32 - 1 documents
+     */
+    size_type add(std::string_view document) {
+        if (size() >= size_type{0xFFFFFFFF}) {
+            throw std::length_error("Too many documents for trigram_index");
+        }
+        const auto id = static_cast<std::uint32_t>(size());
+        text_.append(document);
+        offsets_.push_back(text_.size());
+
+        if (document.size() >= 3) {
+            keys_.clear();
+            for (size_type i = 0; i + 3 <= document.size(); ++i) {
+                keys_.push_back(detail::trigram_key(document.data() + i));
+            }
+            std::sort(keys_.begin(), keys_.end());
+            keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+            for (std::uint32_t key : keys_) {
+                postings_[key].append(id);
+            }
+        }
+        return id;
+    }
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+
+    /**
+     * @brief Ids of documents that may satisfy query, in increasing order
+     *
+     * A superset of the matching documents; skipped clauses only make it
+     * larger.
+     */
+    [[nodiscard]] std::vector<size_type> candidates(const trigram_query& query) const {
+        const auto ids = candidate_ids(query);
+        return {ids.begin(), ids.end()};
+    }
+
+    /**
+     * @brief Ids of documents containing pattern; none for an empty pattern
+     */
+    [[nodiscard]] std::vector<size_type> search(const literal_pattern& pattern) const {
+        std::vector<size_type> result;
+        if (pattern.empty()) {
+            return result;
+        }
+        for (std::uint32_t id : candidate_ids(trigram_query::plan(pattern))) {
+            if (search_pos(document(id), pattern)) {
+                result.push_back(id);
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::vector<size_type> search(std::string_view literal) const {
+        return search(literal_pattern(literal));
+    }
+
+    /**
+     * @brief Ids of documents in which pattern finds a match
+     */
+    [[nodiscard]] std::vector<size_type> search(const regex_pattern& pattern) const {
+        std::vector<size_type> result;
+        if (pattern.empty()) {
+            return result;
+        }
+        for (std::uint32_t id : candidate_ids(trigram_query::plan(pattern))) {
+            if (pattern.search(document(id))) {
+                result.push_back(id);
+            }
+        }
+        return result;
+    }
+
+    // =========================================================================
+    // Accessors
+    // =========================================================================
+
+    [[nodiscard]] size_type size() const noexcept { return offsets_.size() - 1; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] std::string_view document(size_type id) const noexcept {
+        return std::string_view(text_).substr(offsets_[id], offsets_[id + 1] - offsets_[id]);
+    }
+
+    /**
+     * @brief Distinct trigrams indexed
+     */
+    [[nodiscard]] size_type trigram_count() const noexcept { return postings_.size(); }
+
+    /**
+     * @brief Bytes of encoded posting lists
+     */
+    [[nodiscard]] size_type posting_bytes() const noexcept {
+        size_type bytes = 0;
+        for (const auto& [key, list] : postings_) {
+            bytes += list.bytes.size();
+        }
+        return bytes;
+    }
+
+private:
+    std::string text_;                    // documents back to back
+    std::vector<size_type> offsets_{0};   // document i is [offsets_[i], offsets_[i + 1])
+    std::unordered_map<std::uint32_t, detail::posting_list> postings_;
+    std::vector<std::uint32_t> keys_;     // add() scratch
+
+    [[nodiscard]] std::vector<std::uint32_t> candidate_ids(const trigram_query& query) const {
+        std::vector<std::uint32_t> result;
+        if (query.matches_all()) {
+            result.resize(size());
+            std::iota(result.begin(), result.end(), std::uint32_t{0});
+            return result;
+        }
+
+        // Upper bound on each clause's documents; a clause with none fails
+        struct planned_clause {
+            size_type estimate;
+            const std::vector<std::uint32_t>* trigrams;
+        };
+        std::vector<planned_clause> plan;
+        plan.reserve(query.clauses.size());
+        for (const auto& clause : query.clauses) {
+            size_type estimate = 0;
+            for (std::uint32_t key : clause) {
+                if (auto it = postings_.find(key); it != postings_.end()) {
+                    estimate += it->second.count;
+                }
+            }
+            if (estimate == 0) {
+                return result;
+            }
+            plan.push_back({estimate, &clause});
+        }
+        std::sort(plan.begin(), plan.end(), [](const auto& x, const auto& y) {
+            return x.estimate < y.estimate;
+        });
+
+        std::vector<std::uint32_t> ids;
+        std::vector<std::uint32_t> next;
+        for (size_type c = 0; c < plan.size(); ++c) {
+            if (c > 0 && plan[c].estimate > result.size() * config::trigram_verify_cost) {
+                break;
+            }
+
+            ids.clear();
+            for (std::uint32_t key : *plan[c].trigrams) {
+                if (auto it = postings_.find(key); it != postings_.end()) {
+                    it->second.decode(ids);
+                }
+            }
+            if (plan[c].trigrams->size() > 1) {
+                std::sort(ids.begin(), ids.end());
+                ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            }
+
+            if (c == 0) {
+                result.swap(ids);
+            } else {
+                next.resize(std::min(result.size(), ids.size()));
+                next.resize(detail::intersect_sorted(
+                    result.data(), result.size(), ids.data(), ids.size(), next.data()));
+                result.swap(next);
+            }
+            if (result.empty()) {
+                break;
+            }
+        }
+        return result;
+    }
+};
+
+} // namespace kmp
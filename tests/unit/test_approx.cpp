@@ -0,0 +1,231 @@
+/**
+ * @file test_approx.cpp
+ * @brief Unit tests for approximate (Hamming / edit distance) search
+ */
+
+#include <gtest/gtest.h>
+#include <kmp/kmp.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace kmp;
+
+class ApproxTest : public ::testing::Test {
+protected:
+    static std::string random_text(std::mt19937& rng, size_type n, std::string_view alphabet) {
+        std::string text(n, ' ');
+        for (auto& c : text) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        return text;
+    }
+
+    static std::vector<approx_match> naive_hamming(
+        std::string_view text, std::string_view pattern, size_type k
+    ) {
+        std::vector<approx_match> result;
+        for (size_type p = 0; p + pattern.size() <= text.size(); ++p) {
+            size_type d = 0;
+            for (size_type i = 0; i < pattern.size(); ++i) {
+                d += text[p + i] != pattern[i];
+            }
+            if (d <= k) {
+                result.push_back({p, pattern.size(), d});
+            }
+        }
+        return result;
+    }
+
+    static size_type levenshtein(std::string_view a, std::string_view b) {
+        std::vector<size_type> row(b.size() + 1);
+        for (size_type j = 0; j <= b.size(); ++j) {
+            row[j] = j;
+        }
+        for (size_type i = 1; i <= a.size(); ++i) {
+            size_type diagonal = row[0];
+            row[0] = i;
+            for (size_type j = 1; j <= b.size(); ++j) {
+                const size_type up = row[j];
+                row[j] = std::min({row[j] + 1, row[j - 1] + 1,
+                                   diagonal + (a[i - 1] != b[j - 1])});
+                diagonal = up;
+            }
+        }
+        return row[b.size()];
+    }
+
+    // Sellers' DP: smallest distance of pattern to a substring ending at j
+    static std::vector<size_type> end_distances(std::string_view text, std::string_view pattern) {
+        const size_type m = pattern.size();
+        std::vector<size_type> column(m + 1);
+        for (size_type i = 0; i <= m; ++i) {
+            column[i] = i;
+        }
+        std::vector<size_type> result;
+        for (char c : text) {
+            size_type diagonal = column[0];
+            for (size_type i = 1; i <= m; ++i) {
+                const size_type left = column[i];
+                column[i] = std::min({column[i] + 1, column[i - 1] + 1,
+                                      diagonal + (pattern[i - 1] != c)});
+                diagonal = left;
+            }
+            result.push_back(column[m]);
+        }
+        return result;
+    }
+
+    // Reference for the documented edit semantics
+    static std::vector<approx_match> naive_edit(
+        std::string_view text, std::string_view pattern, size_type k
+    ) {
+        const auto d = end_distances(text, pattern);
+        std::vector<approx_match> result;
+        size_type j = 0;
+        while (j < d.size()) {
+            if (d[j] > k) {
+                ++j;
+                continue;
+            }
+            size_type best_end = j;
+            for (; j < d.size() && d[j] <= k; ++j) {
+                if (d[j] < d[best_end]) {
+                    best_end = j;
+                }
+            }
+            const size_type distance = d[best_end];
+            for (size_type length = 0; length <= best_end + 1; ++length) {
+                const auto sub = text.substr(best_end + 1 - length, length);
+                if (levenshtein(pattern, sub) == distance) {
+                    result.push_back({best_end + 1 - length, length, distance});
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+};
+
+// =============================================================================
+// Hamming Distance Tests
+// =============================================================================
+
+TEST_F(ApproxTest, HammingBasic) {
+    auto matches = approx_search("the cat sat on the hat", "cat", 1, distance_metric::hamming);
+
+    std::vector<approx_match> expected = {{4, 3, 0}, {8, 3, 1}, {19, 3, 1}};
+    EXPECT_EQ(matches, expected);
+}
+
+TEST_F(ApproxTest, HammingExactOnly) {
+    auto matches = approx_search("abcabcabd", "abc", 0, distance_metric::hamming);
+
+    std::vector<approx_match> expected = {{0, 3, 0}, {3, 3, 0}};
+    EXPECT_EQ(matches, expected);
+}
+
+TEST_F(ApproxTest, HammingEdgeCases) {
+    EXPECT_TRUE(approx_search("abc", "", 1, distance_metric::hamming).empty());
+    EXPECT_TRUE(approx_search("ab", "abc", 1, distance_metric::hamming).empty());
+    EXPECT_EQ(approx_search("xyzw", "ab", 2, distance_metric::hamming).size(), 3);
+}
+
+TEST_F(ApproxTest, HammingMatchesNaive) {
+    // Covers bitap (short texts), the SIMD blocks and their scalar tails,
+    // and patterns longer than one bitap word
+    std::mt19937 rng(7);
+    for (int trial = 0; trial < 60; ++trial) {
+        const std::string_view alphabet = trial % 2 ? "ACGT" : "ab";
+        const size_type n = 1 + rng() % 2000;
+        const size_type m = 1 + rng() % (trial % 3 == 0 ? 100 : 20);
+        const size_type k = rng() % 4;
+        std::string text = random_text(rng, n, alphabet);
+        std::string pattern = random_text(rng, m, alphabet);
+        if (n > m) {
+            text.replace(rng() % (n - m), m, pattern);
+        }
+
+        EXPECT_EQ(approx_search(text, pattern, k, distance_metric::hamming),
+                  naive_hamming(text, pattern, k))
+            << "n=" << n << " m=" << m << " k=" << k;
+    }
+}
+
+// =============================================================================
+// Edit Distance Tests
+// =============================================================================
+
+TEST_F(ApproxTest, EditTypos) {
+    const std::string text = "it is neccessary to be necesary, but not nesessery";
+    auto matches = approx_search(text, "necessary", 2);
+
+    ASSERT_EQ(matches.size(), 3);
+    EXPECT_EQ(text.substr(matches[0].position, matches[0].length), "neccessary");
+    EXPECT_EQ(matches[0].distance, 1);
+    EXPECT_EQ(text.substr(matches[1].position, matches[1].length), "necesary");
+    EXPECT_EQ(matches[1].distance, 1);
+    EXPECT_EQ(text.substr(matches[2].position, matches[2].length), "nesessery");
+    EXPECT_EQ(matches[2].distance, 2);
+}
+
+TEST_F(ApproxTest, EditExact) {
+    auto matches = approx_search("hello world", "world", 0);
+
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ(matches[0], (approx_match{6, 5, 0}));
+}
+
+TEST_F(ApproxTest, EditTextShorterThanPattern) {
+    auto matches = approx_search("helo", "hello", 1);
+
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ(matches[0], (approx_match{0, 4, 1}));
+}
+
+TEST_F(ApproxTest, EditMatchesNaive) {
+    std::mt19937 rng(11);
+    for (int trial = 0; trial < 60; ++trial) {
+        const std::string_view alphabet = trial % 2 ? "ACGT" : "abcdefgh";
+        const size_type n = 1 + rng() % 400;
+        const size_type m = 1 + rng() % (trial % 4 == 0 ? 150 : 30);
+        const size_type k = rng() % std::min<size_type>(m, 5);
+        std::string text = random_text(rng, n, alphabet);
+        std::string pattern = random_text(rng, m, alphabet);
+        if (n > m) {
+            text.replace(rng() % (n - m), m, pattern);
+        }
+
+        EXPECT_EQ(approx_search(text, pattern, k), naive_edit(text, pattern, k))
+            << "n=" << n << " m=" << m << " k=" << k;
+    }
+}
+
+TEST_F(ApproxTest, EditLongTextMatchesNaive) {
+    // Several interleaved-lane chunks, with hits near lane boundaries
+    std::mt19937 rng(5);
+    std::string text = random_text(rng, 300000, "ACGT");
+    const std::string pattern = "ACGTTGCAACGTAG";
+    for (size_type pos = 16384 - 7; pos < text.size() - 32; pos += 16384 - 3) {
+        std::string variant = pattern;
+        variant[rng() % variant.size()] = 'T';
+        variant.erase(rng() % variant.size(), 1);
+        text.replace(pos, variant.size(), variant);
+    }
+
+    EXPECT_EQ(approx_search(text, pattern, 2), naive_edit(text, pattern, 2));
+}
+
+TEST_F(ApproxTest, EditDistancesAreExact) {
+    std::mt19937 rng(3);
+    const std::string text = random_text(rng, 5000, "abcd");
+    const std::string pattern = "abcdabcaabdc";
+
+    for (const auto& match : approx_search(text, pattern, 3)) {
+        EXPECT_LE(match.distance, 3);
+        EXPECT_EQ(levenshtein(pattern, std::string_view(text).substr(match.position, match.length)),
+                  match.distance);
+    }
+}
@@ -409,6 +409,37 @@ TEST_F(ConcurrencyTest, ConcurrentRegexCreation) {
     }
 }
 
+// =============================================================================
+// Shared Regex Cache
+// =============================================================================
+
+TEST_F(ConcurrencyTest, RegexCacheConcurrentGet) {
+    regex_cache cache;
+    const std::vector<std::string> sources = {"[0-9]+", "a(b|c)*d", "\\bword\\b", "x+y?z"};
+
+    std::vector<std::future<bool>> futures;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        futures.push_back(std::async(std::launch::async, [&, i]() {
+            for (int j = 0; j < ITERATIONS_PER_THREAD; ++j) {
+                auto regex = cache.get(sources[(i + j) % sources.size()]);
+                if (regex.empty()) {
+                    return false;
+                }
+            }
+            return true;
+        }));
+    }
+
+    for (auto& f : futures) {
+        EXPECT_TRUE(f.get());
+    }
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses,
+              static_cast<std::uint64_t>(NUM_THREADS * ITERATIONS_PER_THREAD));
+    EXPECT_EQ(stats.entries, sources.size());
+}
+
 // =============================================================================
 // Mixed Operations Concurrent
 // =============================================================================
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 #include <kmp/kmp.hpp>
 #include <kmp/detail/failure.hpp>
+#include <forward_list>
 #include <string>
 #include <vector>
 
@@ -87,3 +88,13 @@ TEST_F(FailureFunctionTest, SpanOverload) {
         EXPECT_EQ(result[i], expected[i]);
     }
 }
+
+TEST_F(FailureFunctionTest, ForwardIteratorMatchesRandomAccess) {
+    std::string pattern = "ABCDABCDABCEABCDABCDABCDABCE";
+    std::forward_list<char> list(pattern.begin(), pattern.end());
+
+    EXPECT_EQ(compute_failure(list.begin(), list.end()),
+              compute_failure(pattern.begin(), pattern.end()));
+    EXPECT_EQ(compute_failure_optimized(list.begin(), list.end()),
+              compute_failure_optimized(pattern.begin(), pattern.end()));
+}
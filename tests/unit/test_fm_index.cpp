@@ -0,0 +1,130 @@
+/**
+ * @file test_fm_index.cpp
+ * @brief Unit tests for the FM-index
+ */
+
+#include <gtest/gtest.h>
+#include <kmp/kmp.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace kmp;
+
+class FmIndexTest : public ::testing::Test {
+protected:
+    static std::string random_text(std::mt19937& rng, size_type n, std::string_view alphabet) {
+        std::string text(n, ' ');
+        for (auto& c : text) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        return text;
+    }
+
+    static std::string all_bytes_text(std::mt19937& rng, size_type n) {
+        std::string text(n, ' ');
+        for (auto& c : text) {
+            c = static_cast<char>(rng() % 256);
+        }
+        return text;
+    }
+};
+
+// =============================================================================
+// Basic Queries
+// =============================================================================
+
+TEST_F(FmIndexTest, Banana) {
+    fm_index index("banana");
+
+    EXPECT_EQ(index.size(), 6);
+    EXPECT_EQ(index.count("ana"), 2);
+    EXPECT_EQ(index.count("a"), 3);
+    EXPECT_EQ(index.count("banana"), 1);
+    EXPECT_EQ(index.count("nab"), 0);
+    EXPECT_EQ(index.count("x"), 0);
+    EXPECT_EQ(index.search_all_vec("ana"), (std::vector<size_type>{1, 3}));
+    EXPECT_EQ(index.search_pos("na"), 2);
+    EXPECT_FALSE(index.search_pos("bananas").has_value());
+}
+
+TEST_F(FmIndexTest, EmptyTextAndPattern) {
+    fm_index empty("");
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.count("a"), 0);
+    EXPECT_TRUE(empty.search_all_vec("a").empty());
+
+    fm_index index("abc");
+    EXPECT_EQ(index.count(""), 0);
+    EXPECT_FALSE(index.contains(""));
+}
+
+TEST_F(FmIndexTest, SingleSymbolText) {
+    // One-symbol alphabet: the wavelet matrix still has one level
+    fm_index index(std::string(100, 'a'), 7);
+
+    EXPECT_EQ(index.count("a"), 100);
+    EXPECT_EQ(index.count("aaaaa"), 96);
+    EXPECT_EQ(index.search_all_vec(std::string(99, 'a')), (std::vector<size_type>{0, 1}));
+}
+
+TEST_F(FmIndexTest, GeneratorMatchesVector) {
+    fm_index index("abracadabra abracadabra");
+
+    std::vector<size_type> positions;
+    for (size_type pos : index.search_all("abra")) {
+        positions.push_back(pos);
+    }
+    EXPECT_EQ(positions, index.search_all_vec("abra"));
+    EXPECT_EQ(positions, (std::vector<size_type>{0, 7, 12, 19}));
+}
+
+// =============================================================================
+// Agreement with Scanning Search
+// =============================================================================
+
+TEST_F(FmIndexTest, MatchesSearchAcrossSampleRates) {
+    std::mt19937 rng(13);
+    for (size_type rate : {size_type{0}, size_type{1}, size_type{3}, size_type{32}, size_type{1000}}) {
+        for (std::string_view alphabet : {std::string_view("ACGT"), std::string_view("ab"),
+                                          std::string_view("abcdefghijklmnopqrstuvwxyz ")}) {
+            const std::string text = random_text(rng, 3000, alphabet);
+            const fm_index index(text, rate);
+
+            for (int q = 0; q < 30; ++q) {
+                const size_type m = 1 + rng() % 12;
+                const std::string pattern = q % 2 ? text.substr(rng() % (text.size() - m), m)
+                                                  : random_text(rng, m, alphabet);
+                EXPECT_EQ(index.count(pattern), count(text, pattern)) << pattern;
+                EXPECT_EQ(index.search_all_vec(pattern), search_all_vec(text, pattern))
+                    << pattern << " rate=" << rate;
+                EXPECT_EQ(index.search_pos(pattern), search_pos(text, pattern));
+            }
+        }
+    }
+}
+
+TEST_F(FmIndexTest, FullByteAlphabet) {
+    // 256 symbols: eight wavelet levels, several rank blocks per level
+    std::mt19937 rng(29);
+    const std::string text = all_bytes_text(rng, 20000);
+    const fm_index index(text, 5);
+
+    for (int q = 0; q < 50; ++q) {
+        const size_type m = 1 + rng() % 3;
+        const std::string pattern = text.substr(rng() % (text.size() - m), m);
+        EXPECT_EQ(index.search_all_vec(pattern), search_all_vec(text, pattern));
+    }
+    EXPECT_EQ(index.count(std::string_view("\0", 1)), count(text, std::string_view("\0", 1)));
+}
+
+TEST_F(FmIndexTest, SmallerThanSuffixArray) {
+    std::mt19937 rng(31);
+    const std::string text = random_text(rng, 1 << 20, "ACGT");
+    const fm_index index(text);
+
+    // 2 bits per base plus directories and samples, well under 4 bytes/base
+    EXPECT_LT(index.memory_bytes(), text.size());
+    EXPECT_EQ(index.count(text.substr(777, 20)), count(text, text.substr(777, 20)));
+}
@@ -0,0 +1,159 @@
+/**
+ * @file test_match_tracker.cpp
+ * @brief Unit tests for incremental re-search after edits
+ */
+
+#include <gtest/gtest.h>
+#include <kmp/kmp.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace kmp;
+
+class MatchTrackerTest : public ::testing::Test {
+protected:
+    static std::string random_text(std::mt19937& rng, size_type n, std::string_view alphabet) {
+        std::string text(n, ' ');
+        for (auto& c : text) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        return text;
+    }
+
+    static std::vector<size_type> expected(std::string_view text, const literal_pattern& pattern) {
+        return search_all_vec(text, pattern.pattern());
+    }
+
+    static std::vector<size_type> expected(std::string_view text, const regex_pattern& pattern) {
+        return pattern.search_n(text, text.size());
+    }
+
+    // Random edits near a moving cursor, checked against a full rescan
+    template <typename Pattern>
+    static void check_random_edits(
+        const Pattern& pattern,
+        std::string_view alphabet,
+        unsigned seed,
+        int edits = 300
+    ) {
+        std::mt19937 rng(seed);
+        std::string text = random_text(rng, 200, alphabet);
+        match_tracker tracker(text, pattern);
+        ASSERT_EQ(tracker.matches(), expected(text, pattern));
+
+        size_type cursor = text.size() / 2;
+        for (int e = 0; e < edits; ++e) {
+            if (rng() % 8 == 0) {
+                cursor = rng() % (text.size() + 1);
+            }
+            const size_type offset = std::min(cursor, text.size());
+            const size_type removed = std::min<size_type>(rng() % 4, text.size() - offset);
+            const std::string inserted = random_text(rng, rng() % 5, alphabet);
+
+            text.replace(offset, removed, inserted);
+            tracker.apply_edit(offset, removed, inserted);
+            cursor = offset + inserted.size();
+
+            ASSERT_EQ(tracker.text(), text);
+            ASSERT_EQ(tracker.matches(), expected(text, pattern))
+                << "edit " << e << " at " << offset << " in \"" << text << "\"";
+        }
+    }
+};
+
+// =============================================================================
+// Literal Patterns
+// =============================================================================
+
+TEST_F(MatchTrackerTest, LiteralKeystrokes) {
+    match_tracker tracker("a TODO and a TOD", literal_pattern("TODO"));
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{2}));
+
+    tracker.apply_edit(16, 0, "O");  // completes the second one
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{2, 13}));
+
+    tracker.apply_edit(4, 1, "");    // "TOO": breaks the first
+    EXPECT_EQ(tracker.text(), "a TOO and a TODO");
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{12}));
+
+    tracker.apply_edit(0, 0, "TODO ");  // shifts the rest
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{0, 17}));
+    EXPECT_EQ(tracker.match_count(), 2);
+}
+
+TEST_F(MatchTrackerTest, LiteralOverlapping) {
+    match_tracker tracker("aaaa", literal_pattern("aa"));
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{0, 1, 2}));
+
+    tracker.apply_edit(2, 0, "b");
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{0, 3}));
+}
+
+TEST_F(MatchTrackerTest, LiteralRandomEdits) {
+    check_random_edits(literal_pattern("ab"), "ab", 1);
+    check_random_edits(literal_pattern("abab"), "ab", 2);
+    check_random_edits(literal_pattern("a"), "abc", 3);
+    check_random_edits(literal_pattern("xyzzy"), "xyz", 4);
+}
+
+// =============================================================================
+// Regex Patterns
+// =============================================================================
+
+TEST_F(MatchTrackerTest, RegexUnboundedResync) {
+    // A 'b' typed at the end completes a match from every earlier 'a'
+    match_tracker tracker("a xx a yy", regex_pattern("a.*b"));
+    EXPECT_TRUE(tracker.matches().empty());
+
+    tracker.apply_edit(9, 0, "b");
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{0, 5}));
+
+    tracker.apply_edit(9, 1, "");
+    EXPECT_TRUE(tracker.matches().empty());
+}
+
+TEST_F(MatchTrackerTest, RegexWordBoundary) {
+    match_tracker tracker("cat catalog", regex_pattern("\\bcat\\b"));
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{0}));
+
+    tracker.apply_edit(7, 4, "");    // "cat cat"
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{0, 4}));
+
+    tracker.apply_edit(4, 0, "x");   // "cat xcat"
+    EXPECT_EQ(tracker.matches(), (std::vector<size_type>{0}));
+}
+
+TEST_F(MatchTrackerTest, RegexRandomEdits) {
+    check_random_edits(regex_pattern("ab+c"), "abc", 5);
+    check_random_edits(regex_pattern("a[^c]*c"), "abc", 6);
+    check_random_edits(regex_pattern("(ab|ba)a?"), "ab ", 7);
+    check_random_edits(regex_pattern("\\bab\\b"), "ab ", 8);
+    check_random_edits(regex_pattern("x*"), "xy", 9);
+}
+
+// =============================================================================
+// Buffer Management
+// =============================================================================
+
+TEST_F(MatchTrackerTest, LargeInsertAndViewport) {
+    match_tracker tracker("", literal_pattern("needle"));
+    EXPECT_TRUE(tracker.empty());
+
+    std::string block;
+    for (int i = 0; i < 2000; ++i) {
+        block += i % 100 == 0 ? "needle" : "hay...";
+    }
+    tracker.apply_edit(0, 0, block);   // larger than the gap
+    EXPECT_EQ(tracker.size(), block.size());
+    EXPECT_EQ(tracker.match_count(), 20);
+
+    tracker.apply_edit(6000, 0, "x");  // split the matches around the gap
+    EXPECT_EQ(tracker.matches(0, 1200), (std::vector<size_type>{0, 600}));
+    EXPECT_EQ(tracker.matches(6000, 6700), (std::vector<size_type>{6001, 6601}));
+    EXPECT_EQ(tracker[6000], 'x');
+
+    EXPECT_THROW(tracker.apply_edit(tracker.size() + 1, 0, "x"), std::out_of_range);
+    EXPECT_THROW(tracker.apply_edit(0, tracker.size() + 1, ""), std::out_of_range);
+}
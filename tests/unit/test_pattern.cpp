@@ -5,7 +5,15 @@
 
 #include <gtest/gtest.h>
 #include <kmp/kmp.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 using namespace kmp;
 
@@ -57,6 +65,265 @@ TEST_F(PatternTest, LiteralPatternIndexAccess) {
     EXPECT_EQ(pat[4], 'o');
 }
 
+TEST_F(PatternTest, LiteralPatternInlineStorage) {
+    literal_pattern short_pat("keyword");
+    literal_pattern long_pat(std::string(100, 'x') + "y");
+
+    EXPECT_TRUE(short_pat.is_inline());
+    EXPECT_FALSE(long_pat.is_inline());
+    EXPECT_EQ(short_pat.failure().width(), 1u);
+    EXPECT_EQ(long_pat.failure()[99], 99u);
+    EXPECT_EQ(long_pat.failure()[100], 0u);
+}
+
+TEST_F(PatternTest, LiteralPatternWideFailureTable) {
+    std::string text(70'000, 'a');
+    literal_pattern pat(text);
+
+    EXPECT_EQ(pat.failure().width(), 4u);
+    EXPECT_EQ(pat.failure().size(), text.size());
+    EXPECT_EQ(pat.failure()[69'999], 69'999u);
+
+    literal_pattern mid(std::string(300, 'a'));
+    EXPECT_EQ(mid.failure().width(), 2u);
+    EXPECT_EQ(mid.failure()[299], 299u);
+}
+
+TEST_F(PatternTest, LiteralPatternCopyAndMove) {
+    for (std::string source : {std::string("abcab"), "abcab" + std::string(64, 'q') + "abcab"}) {
+        const size_type border = source.size() == 5 ? 2 : 5;
+        literal_pattern original(source);
+        literal_pattern copy(original);
+        EXPECT_EQ(copy.pattern(), source);
+        EXPECT_NE(copy.pattern().data(), original.pattern().data());
+        EXPECT_EQ(copy.failure()[source.size() - 1], border);
+
+        literal_pattern moved(std::move(copy));
+        EXPECT_EQ(moved.pattern(), source);
+        EXPECT_EQ(moved.failure()[source.size() - 1], border);
+        EXPECT_TRUE(copy.empty());
+
+        literal_pattern assigned;
+        assigned = moved;
+        EXPECT_EQ(assigned.pattern(), source);
+        assigned = literal_pattern("zz");
+        EXPECT_EQ(assigned.pattern(), "zz");
+    }
+}
+
+TEST_F(PatternTest, LiteralPatternAnchor) {
+    // 'q' is rarer than any other byte of the pattern
+    literal_pattern pat("the quest");
+    EXPECT_EQ(pat.anchor(), 4u);
+    EXPECT_EQ(literal_pattern("a").anchor(), 0u);
+}
+
+TEST_F(PatternTest, LiteralPatternSearch) {
+    std::string text = std::string(200, 'e') + "the quest" + std::string(200, 'e');
+    literal_pattern pat("the quest");
+
+    auto it = search(text.begin(), text.end(), pat);
+    EXPECT_EQ(it - text.begin(), 200);
+    EXPECT_EQ(search_pos(text, pat), 200u);
+    EXPECT_EQ(search_pos(text, literal_pattern("the quiet")), std::nullopt);
+    EXPECT_EQ(search_pos("short text", literal_pattern("text")), 6u);
+    EXPECT_EQ(search_pos(text, literal_pattern("")), 0u);
+}
+
+// =============================================================================
+// Literal Pattern View Tests
+// =============================================================================
+
+TEST_F(PatternTest, LiteralPatternViewOfPattern) {
+    literal_pattern pat("ABABAC");
+    literal_pattern_view view = pat.view();
+
+    EXPECT_EQ(view.pattern().data(), pat.pattern().data());
+    EXPECT_EQ(view.failure()[4], 3u);
+    EXPECT_EQ(view.anchor(), pat.anchor());
+    EXPECT_EQ(search_pos("xxABABACxx", view), 2u);
+}
+
+TEST_F(PatternTest, CompileLiteralsIntoArena) {
+    std::vector<std::string_view> words = {"alpha", "", "ABABAC", std::string_view("beta")};
+    std::string long_word(300, 'z');
+    words.push_back(long_word);
+
+    std::vector<std::uint32_t> storage((literal_arena_size(words) + 3) / 4);
+    std::span<std::byte> arena(reinterpret_cast<std::byte*>(storage.data()), storage.size() * 4);
+    std::vector<literal_pattern_view> views(words.size());
+
+    size_type used = compile_literals_into(words, arena, views);
+    EXPECT_EQ(used, literal_arena_size(words));
+
+    for (size_t i = 0; i < words.size(); ++i) {
+        EXPECT_EQ(views[i].pattern(), words[i]);
+        // Views point into the arena, not at the source strings
+        if (!words[i].empty()) {
+            EXPECT_GE(views[i].pattern().data(), reinterpret_cast<const char*>(arena.data()));
+            EXPECT_LT(views[i].pattern().data(), reinterpret_cast<const char*>(arena.data() + used));
+        }
+    }
+    EXPECT_EQ(views[2].failure()[4], 3u);
+    EXPECT_EQ(views[4].failure().width(), 2u);
+    EXPECT_EQ(views[4].failure()[299], 299u);
+
+    // Reopen a block from its offset, as after mmapping the arena
+    auto reopened = literal_pattern_view::from_block(
+        reinterpret_cast<const std::byte*>(views[2].pattern().data()), 6);
+    EXPECT_EQ(reopened.pattern(), "ABABAC");
+    EXPECT_EQ(reopened.failure()[4], 3u);
+    EXPECT_EQ(search_pos("..ABABAC", reopened), 2u);
+}
+
+TEST_F(PatternTest, CompileLiteralsIntoRejectsSmallArena) {
+    std::vector<std::string_view> words = {"alpha", "beta"};
+    std::vector<std::uint32_t> storage(2);
+    std::span<std::byte> arena(reinterpret_cast<std::byte*>(storage.data()), 8);
+    std::vector<literal_pattern_view> views(words.size());
+
+    EXPECT_THROW((void)compile_literals_into(words, arena, views), std::runtime_error);
+    EXPECT_THROW((void)compile_literals_into(words, arena, std::span(views).first(1)),
+                 std::runtime_error);
+}
+
+TEST_F(PatternTest, CompileLiteralsSmallList) {
+    std::vector<std::string_view> words = {"needle", "", "ABABAC"};
+    auto set = compile_literals(words);
+
+    ASSERT_EQ(set.size(), 3u);
+    EXPECT_EQ(set[0].pattern(), "needle");
+    EXPECT_TRUE(set[1].empty());
+    EXPECT_EQ(set[2].failure()[4], 3u);
+    EXPECT_EQ(set.arena().size(), literal_arena_size(words));
+    EXPECT_EQ(search_pos("haystack needle", set[0]), 9u);
+}
+
+TEST_F(PatternTest, CompileLiteralsParallelMatchesSerial) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 40'000; ++i) {
+        storage.push_back("kw" + std::to_string(i * 7919) + std::string(i % 5, 'a'));
+    }
+    std::vector<std::string_view> words(storage.begin(), storage.end());
+
+    auto parallel = compile_literals(words, 4);
+    auto serial = compile_literals(words, 1);
+
+    ASSERT_EQ(parallel.size(), words.size());
+    ASSERT_EQ(parallel.arena().size(), serial.arena().size());
+    EXPECT_TRUE(std::equal(parallel.arena().begin(), parallel.arena().end(),
+                           serial.arena().begin()));
+    for (size_t i = 0; i < words.size(); i += 997) {
+        EXPECT_EQ(parallel[i].pattern(), words[i]);
+        literal_pattern reference(words[i]);
+        for (size_t j = 0; j < words[i].size(); ++j) {
+            EXPECT_EQ(parallel[i].failure()[j], reference.failure()[j]);
+        }
+    }
+}
+
+TEST_F(PatternTest, LiteralPatternBoundedSearch) {
+    std::string text(300, '.');
+    for (size_type pos : {10u, 120u, 250u}) {
+        text.replace(pos, 6, "needle");
+    }
+    literal_pattern pat("needle");
+
+    EXPECT_EQ(search_pos(text, pat, 11), 120u);
+    EXPECT_EQ(search_pos(text, pat, 11, 125), std::nullopt);
+    EXPECT_EQ(search_pos(text, pat.view(), 11, 126), 120u);
+    EXPECT_EQ(search_n(text, pat, 2), (std::vector<size_type>{10, 120}));
+    EXPECT_EQ(search_n(text, pat.view(), 5, 11), (std::vector<size_type>{120, 250}));
+    EXPECT_TRUE(search_n(text, literal_pattern(""), 5).empty());
+}
+
+TEST_F(PatternTest, LiteralPatternSearchAllInto) {
+    std::string text(300, '.');
+    for (size_type pos : {10u, 120u, 250u}) {
+        text.replace(pos, 6, "needle");
+    }
+    literal_pattern pat("needle");
+    std::array<size_type, 2> buffer{};
+
+    auto first = search_all_into(text, pat, buffer);
+    EXPECT_EQ(first.written, 2u);
+    EXPECT_EQ(buffer[0], 10u);
+    EXPECT_EQ(buffer[1], 120u);
+
+    auto rest = search_all_into(text, pat.view(), buffer, first.resume);
+    EXPECT_EQ(rest.written, 1u);
+    EXPECT_EQ(buffer[0], 250u);
+    EXPECT_EQ(rest.resume, text.size());
+}
+
+// =============================================================================
+// Masked Pattern Tests
+// =============================================================================
+
+TEST_F(PatternTest, MaskedSignature) {
+    auto pat = compile_masked("48 8B ?? ?? 89 45");
+    EXPECT_EQ(pat.size(), 6u);
+
+    std::string image(5000, '\x90');
+    image.replace(3000, 6, "\x48\x8B\x01\x02\x89\x45");
+    image.replace(4000, 6, "\x48\x8B\xF0\xFF\x89\x45");
+    image.replace(4500, 6, "\x48\x8B\xF0\xFF\x89\x46");
+
+    EXPECT_EQ(search_pos(image, pat), 3000u);
+    EXPECT_EQ(search_pos(image, pat, 3001), 4000u);
+    EXPECT_EQ(search_all_vec(image, pat), (std::vector<size_type>{3000, 4000}));
+    EXPECT_EQ(count(image, pat), 2u);
+}
+
+TEST_F(PatternTest, MaskedNibbleWildcards) {
+    auto pat = compile_masked("4? ?B");
+    EXPECT_EQ(search_pos(std::string_view("\x10\x4F\x3B"), pat), 1u);
+    EXPECT_FALSE(search_pos(std::string_view("\x10\x5F\x3B"), pat).has_value());
+}
+
+TEST_F(PatternTest, MaskedAllWildcards) {
+    auto pat = compile_masked("?? ?");
+    EXPECT_EQ(search_all_vec("abcd", pat), (std::vector<size_type>{0, 1, 2}));
+    EXPECT_EQ(count("abcd", pat, match_mode::non_overlapping), 2u);
+}
+
+TEST_F(PatternTest, MaskedInvalidSignature) {
+    EXPECT_THROW(compile_masked("48 8G"), std::runtime_error);
+    EXPECT_THROW(compile_masked("488B"), std::runtime_error);
+    EXPECT_THROW(masked_pattern("ab", "\xFF"), std::runtime_error);
+}
+
+TEST_F(PatternTest, MaskedMatchesNaive) {
+    std::mt19937 gen(17);
+    const std::string_view alphabet = "\x48\x8B\x89\x45";
+
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string text(static_cast<size_t>(1 + gen() % 2000), ' ');
+        for (auto& c : text) c = alphabet[gen() % alphabet.size()];
+
+        const size_t m = 1 + gen() % 70;
+        std::string bytes(m, ' ');
+        std::string mask(m, ' ');
+        for (size_t i = 0; i < m; ++i) {
+            bytes[i] = alphabet[gen() % alphabet.size()];
+            const unsigned r = gen() % 4;
+            mask[i] = static_cast<char>(r == 0 ? 0x00 : (r == 1 ? 0xF0 : 0xFF));
+        }
+        masked_pattern pat(bytes, mask);
+
+        std::vector<size_type> expected;
+        for (size_t p = 0; p + m <= text.size(); ++p) {
+            bool ok = true;
+            for (size_t i = 0; i < m && ok; ++i) {
+                ok = (text[p + i] & mask[i]) == (bytes[i] & mask[i]);
+            }
+            if (ok) expected.push_back(p);
+        }
+
+        EXPECT_EQ(search_all_vec(text, pat), expected) << "trial " << trial;
+    }
+}
+
 // =============================================================================
 // Compile-time Pattern Tests
 // =============================================================================
@@ -87,6 +354,14 @@ TEST_F(PatternTest, CompiledPatternIndexAccess) {
     EXPECT_EQ(pat[4], 'o');
 }
 
+TEST_F(PatternTest, CompiledPatternSearch) {
+    constexpr auto pat = compile<"needle">();
+    std::string text = std::string(100, 'x') + "needle";
+
+    auto it = search(text.begin(), text.end(), pat);
+    EXPECT_EQ(it - text.begin(), 100);
+}
+
 // =============================================================================
 // Compile Functions Tests
 // =============================================================================
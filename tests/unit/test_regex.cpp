@@ -5,7 +5,12 @@
 
 #include <gtest/gtest.h>
 #include <kmp/kmp.hpp>
+#include <algorithm>
+#include <array>
+#include <regex>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 using namespace kmp;
 
@@ -127,6 +132,53 @@ TEST_F(RegexTest, SpaceClass) {
     EXPECT_FALSE(regex.matches("a"));
 }
 
+// =============================================================================
+// Word Boundary Tests
+// =============================================================================
+
+TEST_F(RegexTest, WordBoundaryWholeWord) {
+    auto regex = compile_regex("\\bcat\\b");
+
+    EXPECT_TRUE(regex.matches("cat"));
+    EXPECT_EQ(regex.search("the cat sat"), 4u);
+    EXPECT_EQ(regex.search("cat"), 0u);
+    EXPECT_EQ(regex.search("a cat"), 2u);
+    EXPECT_FALSE(regex.search("concatenate").has_value());
+    EXPECT_FALSE(regex.search("cats").has_value());
+    EXPECT_EQ(regex.search("cats, cat."), 6u);
+}
+
+TEST_F(RegexTest, WordBoundaryAfterWordPrefix) {
+    auto regex = compile_regex("\\bid");
+
+    EXPECT_FALSE(regex.search("grid").has_value());
+    EXPECT_EQ(regex.search("grid id"), 5u);
+    EXPECT_EQ(regex.search("_id id"), 4u);
+}
+
+TEST_F(RegexTest, NonWordBoundary) {
+    auto regex = compile_regex("\\Bcat\\B");
+
+    EXPECT_EQ(regex.search("concatenate"), 3u);
+    EXPECT_FALSE(regex.search("cat").has_value());
+    EXPECT_FALSE(regex.search("a cat b").has_value());
+}
+
+TEST_F(RegexTest, WordBoundaryWithClasses) {
+    auto regex = compile_regex("\\b\\d+\\b");
+
+    EXPECT_EQ(regex.search("abc123 456"), 7u);
+    EXPECT_TRUE(regex.matches("42"));
+    EXPECT_FALSE(regex.matches("42a"));
+}
+
+TEST_F(RegexTest, WordBoundaryInAlternation) {
+    auto regex = compile_regex("\\b(if|else)\\b");
+
+    EXPECT_EQ(regex.search("elsewhere; if (x)"), 11u);
+    EXPECT_FALSE(regex.search("elif endif").has_value());
+}
+
 // =============================================================================
 // Quantifier Tests
 // =============================================================================
@@ -266,6 +318,395 @@ TEST_F(RegexTest, HexColor) {
     EXPECT_FALSE(regex.matches("#GGG"));
 }
 
+// =============================================================================
+// Self-Loop Acceleration Tests
+// =============================================================================
+
+TEST_F(RegexTest, QuotedStringLongRun) {
+    auto regex = compile_regex("\"[^\"]*\"");
+    std::string body(5000, 'x');
+    std::string text = "key = \"" + body + "\";";
+
+    EXPECT_EQ(regex.search(text), 6u);
+    EXPECT_TRUE(regex.matches("\"" + body + "\""));
+    EXPECT_FALSE(regex.matches("\"" + body));
+    EXPECT_FALSE(regex.search("\"" + body).has_value());
+}
+
+TEST_F(RegexTest, WildcardPrefixLongRun) {
+    auto regex = compile_regex(".*ERROR");
+    std::string line(3000, 'e');
+
+    EXPECT_EQ(regex.search(line + "ERROR"), 0u);
+    EXPECT_TRUE(regex.matches(line + "EEERROR"));
+    EXPECT_FALSE(regex.matches(line + "\nERROR"));
+    EXPECT_FALSE(regex.search(line + "ERRO").has_value());
+}
+
+TEST_F(RegexTest, AcceleratedRunStopsAtNonAscii) {
+    auto regex = compile_regex("a[^b]*b");
+    std::string run(200, 'x');
+
+    EXPECT_FALSE(regex.matches("a" + run + "\xC3\xA9" + run + "b"));
+    EXPECT_TRUE(regex.matches("a" + run + run + "b"));
+    EXPECT_EQ(regex.search("a" + run + "\xC3" + "ab"), 202u);
+}
+
+// =============================================================================
+// Multi-Stride Transition Tests
+// =============================================================================
+
+TEST_F(RegexTest, StrideOddAndEvenLengths) {
+    auto regex = compile_regex("([a-z][0-9])+x?");
+
+    EXPECT_TRUE(regex.matches("a1b2c3"));
+    EXPECT_TRUE(regex.matches("a1b2c3x"));
+    EXPECT_FALSE(regex.matches("a1b2c"));
+    EXPECT_FALSE(regex.matches("a1b2c3xx"));
+    EXPECT_FALSE(regex.matches("a1b2\xC3\xA9"));
+}
+
+TEST_F(RegexTest, StrideMatchEndsBetweenPairBytes) {
+    // The match ends after an odd number of bytes inside a longer run
+    auto regex = compile_regex("ab(cd)*e");
+    std::string text = std::string(101, 'z') + "abcdcde" + std::string(50, 'z');
+
+    EXPECT_EQ(regex.search(text), 101u);
+    EXPECT_EQ(compile_regex("zab").search(text), 100u);
+}
+
+TEST_F(RegexTest, StrideWithWordBoundary) {
+    auto regex = compile_regex("[a-z]+\\b");
+
+    EXPECT_TRUE(regex.matches("abcdefg"));
+    EXPECT_EQ(regex.search("12 abc"), 3u);
+}
+
+TEST_F(RegexTest, ByteClassCompression) {
+    detail::compiled_dfa dfa("[a-z]+[0-9]");
+
+    // [a-z], [0-9], every other ASCII byte, and non-ASCII
+    EXPECT_EQ(dfa.byte_class_count(), 4u);
+    EXPECT_TRUE(dfa.has_stride_table());
+}
+
+// =============================================================================
+// Serialization Tests
+// =============================================================================
+
+TEST_F(RegexTest, SerializeRoundTrip) {
+    auto regex = compile_regex("\\b[a-z]+@[a-z]+\\.(com|org)\\b");
+    auto blob = regex.serialize();
+
+    auto loaded = regex_pattern::load(blob);
+    EXPECT_EQ(loaded.source(), regex.source());
+    EXPECT_EQ(loaded.state_count(), regex.state_count());
+
+    for (std::string_view text : {"mail test@example.com now", "x@y.net", "a@b.org", "aa@bb.comx"}) {
+        EXPECT_EQ(loaded.search(text), regex.search(text)) << text;
+        EXPECT_EQ(loaded.matches(text), regex.matches(text)) << text;
+    }
+}
+
+TEST_F(RegexTest, LoadUsesBufferInPlace) {
+    auto blob = compile_regex("ab+c").serialize();
+    auto loaded = regex_pattern::load(blob);
+
+    // The source view points into the caller's buffer: nothing was copied
+    const auto* first = reinterpret_cast<const char*>(blob.data());
+    EXPECT_GE(loaded.source().data(), first);
+    EXPECT_LT(loaded.source().data(), first + blob.size());
+    EXPECT_TRUE(loaded.matches("abbbc"));
+}
+
+TEST_F(RegexTest, RulePackRoundTrip) {
+    std::vector<regex_pattern> rules = {
+        compile_regex("ERROR [0-9]+"),
+        compile_regex("\"[^\"]*\""),
+        compile_regex("\\bcat\\b"),
+    };
+    auto pack = serialize_regex_pack(rules);
+    auto loaded = load_regex_pack(pack);
+
+    ASSERT_EQ(loaded.size(), rules.size());
+    for (size_t i = 0; i < rules.size(); ++i) {
+        EXPECT_EQ(loaded[i].source(), rules[i].source());
+    }
+    EXPECT_EQ(loaded[0].search("x ERROR 42"), 2u);
+    EXPECT_EQ(loaded[1].search("k=\"v\""), 2u);
+    EXPECT_FALSE(loaded[2].search("concat").has_value());
+}
+
+TEST_F(RegexTest, LoadRejectsBadBlobs) {
+    auto blob = compile_regex("abc").serialize();
+
+    auto bad_magic = blob;
+    bad_magic[0] = std::byte{'X'};
+    EXPECT_THROW((void)regex_pattern::load(bad_magic), std::runtime_error);
+
+    auto swapped = blob;
+    std::reverse(swapped.begin() + 4, swapped.begin() + 8);
+    EXPECT_THROW((void)regex_pattern::load(swapped), std::runtime_error);
+
+    auto bad_version = blob;
+    bad_version[8] = std::byte{0x7F};
+    EXPECT_THROW((void)regex_pattern::load(bad_version), std::runtime_error);
+
+    EXPECT_THROW((void)regex_pattern::load(std::span(blob).first(blob.size() - 8)),
+                 std::runtime_error);
+    EXPECT_THROW((void)regex_pattern{}.serialize(), std::runtime_error);
+}
+
+// =============================================================================
+// Compile-time Regex Tests
+// =============================================================================
+
+TEST_F(RegexTest, CompileTimeMatches) {
+    constexpr auto re = compile_regex<"[a-z]+@[a-z]+\\.(com|org)">();
+
+    static_assert(re.matches("user@example.com"));
+    static_assert(!re.matches("user@example.net"));
+    static_assert(re.search("mail: a@b.org").value() == 6);
+    static_assert(!re.search("no address").has_value());
+
+    EXPECT_TRUE(re.matches("x@y.org"));
+    EXPECT_EQ(re.search("to: x@y.com"), 4u);
+}
+
+TEST_F(RegexTest, CompileTimeStateCount) {
+    using re = compiled_regex<"ab*c">;
+
+    static_assert(re::state_count > 0);
+    static_assert(std::is_same_v<re::state_type, std::uint8_t>);
+    EXPECT_EQ(re::state_count, compile_regex("ab*c").state_count());
+}
+
+TEST_F(RegexTest, CompileTimeAgreesWithRuntime) {
+    constexpr auto word = compile_regex<"\\bcat\\b">();
+    constexpr auto quoted = compile_regex<"\"[^\"]*\"">();
+    constexpr auto digits = compile_regex<"[0-9]+">();
+    auto word_rt = compile_regex("\\bcat\\b");
+    auto quoted_rt = compile_regex("\"[^\"]*\"");
+    auto digits_rt = compile_regex("[0-9]+");
+
+    for (std::string_view text : {"cat", "concat", "a cat!", "k=\"v\" x", "\"open",
+                                   "id 4711", "caf\xc3\xa9 42", ""}) {
+        EXPECT_EQ(word.search(text), word_rt.search(text)) << text;
+        EXPECT_EQ(quoted.search(text), quoted_rt.search(text)) << text;
+        EXPECT_EQ(digits.search(text), digits_rt.search(text)) << text;
+        EXPECT_EQ(word.matches(text), word_rt.matches(text)) << text;
+        EXPECT_EQ(digits.matches(text), digits_rt.matches(text)) << text;
+    }
+}
+
+// =============================================================================
+// Regex Cache Tests
+// =============================================================================
+
+TEST_F(RegexTest, CacheReturnsSharedPattern) {
+    regex_cache cache;
+
+    auto first = cache.get("[a-z]+@[a-z]+");
+    auto second = cache.get("[a-z]+@[a-z]+");
+
+    // Both handles share one DFA, so the stored source is the same bytes
+    EXPECT_EQ(first.source().data(), second.source().data());
+    EXPECT_EQ(second.search("mail a@b"), 5u);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_EQ(stats.bytes, first.memory_size() + 13);
+}
+
+TEST_F(RegexTest, CacheEvictsLeastRecentlyUsed) {
+    auto cost = [](std::string_view source) {
+        return compile_regex(source).memory_size() + source.size();
+    };
+    regex_cache cache(cost("aa") + cost("bb"));
+
+    (void)cache.get("aa");
+    (void)cache.get("bb");
+    (void)cache.get("aa");  // "bb" is now least recently used
+    (void)cache.get("cc");
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_LE(stats.bytes, cache.capacity());
+
+    cache.reset_stats();
+    (void)cache.get("aa");
+    (void)cache.get("bb");
+    EXPECT_EQ(cache.stats().hits, 1u);
+    EXPECT_EQ(cache.stats().misses, 1u);
+}
+
+TEST_F(RegexTest, CacheSkipsOversizedAndInvalidPatterns) {
+    regex_cache cache(16);
+
+    auto pattern = cache.get("[0-9]+");
+    EXPECT_TRUE(pattern.matches("42"));
+    EXPECT_EQ(cache.stats().entries, 0u);
+
+    EXPECT_THROW((void)cache.get("(unclosed"), std::runtime_error);
+    EXPECT_EQ(cache.stats().entries, 0u);
+
+    cache.set_capacity(config::regex_cache_bytes);
+    (void)cache.get("[0-9]+");
+    cache.clear();
+    EXPECT_EQ(cache.stats().entries, 0u);
+    EXPECT_EQ(cache.stats().bytes, 0u);
+}
+
+// =============================================================================
+// Bounded Search Tests
+// =============================================================================
+
+TEST_F(RegexTest, SearchWindow) {
+    auto regex = compile_regex("[0-9]+");
+    EXPECT_EQ(regex.search("a1 b22 c333", 2), 4u);
+    EXPECT_EQ(regex.search("a1 b22 c333", 2, 4), std::nullopt);
+    EXPECT_EQ(regex.search("a1 b22 c333", 2, 5), 4u);
+    EXPECT_EQ(regex.search("a1 b22 c333", 20), std::nullopt);
+}
+
+TEST_F(RegexTest, SearchWindowKeepsBoundaryContext) {
+    auto regex = compile_regex("\\bcat\\b");
+    // "cat" inside "concats" is not a word, even when the window cuts it out
+    EXPECT_EQ(regex.search("concats cat", 3, 6), std::nullopt);
+    EXPECT_EQ(regex.search("concats cat", 3), 8u);
+    EXPECT_EQ(regex.search("cat", 0, 3), 0u);
+}
+
+TEST_F(RegexTest, SearchNFirstK) {
+    auto regex = compile_regex("ab+");
+    EXPECT_EQ(regex.search_n("ab abb abbb ab", 3), (std::vector<size_type>{0, 3, 7}));
+    EXPECT_EQ(regex.search_n("ab abb abbb ab", 3, 8), (std::vector<size_type>{12}));
+    EXPECT_TRUE(regex.search_n("ab", 0).empty());
+    EXPECT_TRUE(regex_pattern{}.search_n("ab", 3).empty());
+}
+
+// =============================================================================
+// Capture and Replace Tests
+// =============================================================================
+
+TEST_F(RegexTest, FindReportsGroups) {
+    auto regex = compile_regex("(\\w+)=(\\d+)");
+    regex_scratch scratch;
+    std::array<size_type, 6> slots{};
+
+    EXPECT_EQ(regex.group_count(), 2u);
+    ASSERT_TRUE(regex.find("set a=12;", slots, scratch));
+    EXPECT_EQ(slots[0], 4u);
+    EXPECT_EQ(slots[1], 8u);
+    EXPECT_EQ(slots[2], 4u);
+    EXPECT_EQ(slots[3], 5u);
+    EXPECT_EQ(slots[4], 6u);
+    EXPECT_EQ(slots[5], 8u);
+
+    EXPECT_TRUE(regex.find("a=1 b=2", slots, scratch, 1));
+    EXPECT_EQ(slots[0], 4u);
+    EXPECT_FALSE(regex.find("a=b", slots, scratch));
+}
+
+TEST_F(RegexTest, FindLeftmostFirst) {
+    regex_scratch scratch;
+    std::array<size_type, 4> slots{};
+
+    ASSERT_TRUE(compile_regex("a|ab").find("xab", slots, scratch));
+    EXPECT_EQ(slots[0], 1u);
+    EXPECT_EQ(slots[1], 2u);
+
+    ASSERT_TRUE(compile_regex("(a+)(a*)").find("aaa", slots, scratch));
+    EXPECT_EQ(slots[3], 3u);
+
+    ASSERT_TRUE(compile_regex("(a)|(b)").find("b", slots, scratch));
+    EXPECT_EQ(slots[2], std::string_view::npos);
+}
+
+TEST_F(RegexTest, ReplaceTemplates) {
+    auto regex = compile_regex("(\\w+)=(\\w+)");
+    EXPECT_EQ(regex.replace_all("a=1, b=2", "$2=$1"), "1=a, 2=b");
+    EXPECT_EQ(regex.replace_all("a=1", "[$&] $0"), "[a=1] a=1");
+    EXPECT_EQ(regex.replace_all("a=1", "${1}0 $$1 $x $"), "a0 $1 $x $");
+    EXPECT_EQ(regex.replace_all("no pairs", "$1"), "no pairs");
+    EXPECT_EQ(compile_regex("(a)|(b)").replace_all("abc", "[$1|$2]"), "[a|][|b]c");
+    EXPECT_THROW((void)regex.replace_all("a=1", "$3"), std::runtime_error);
+    EXPECT_THROW((void)regex.replace_all("a=1", "${12}"), std::runtime_error);
+}
+
+TEST_F(RegexTest, ReplaceEmptyMatches) {
+    EXPECT_EQ(compile_regex("x*").replace_all("abc", "-"), "-a-b-c-");
+    EXPECT_EQ(compile_regex("a*").replace_all("baaac", "-"), "-b--c-");
+    EXPECT_EQ(compile_regex("a*").replace_all("", "-"), "-");
+    EXPECT_EQ(compile_regex("\\b").replace_all("hi you", "|"), "|hi| |you|");
+}
+
+TEST_F(RegexTest, ReplaceStreamsToSinkAndReusesScratch) {
+    auto regex = compile_regex("\\d+");
+    regex_scratch scratch;
+
+    std::vector<std::string> pieces;
+    auto replaced = regex.replace_all("id 42 and 7", "#",
+        [&](std::string_view piece) { pieces.emplace_back(piece); }, scratch);
+    EXPECT_EQ(replaced, 2u);
+    EXPECT_EQ(pieces, (std::vector<std::string>{"id ", "#", " and ", "#"}));
+
+    std::string out = "> ";
+    for (int i = 0; i < 3; ++i) {
+        regex.replace_all("pin 1234", "****", out, scratch);
+    }
+    EXPECT_EQ(out, "> pin ****pin ****pin ****");
+
+    // The same scratch serves another pattern
+    out.clear();
+    compile_regex("([a-z]+)@([a-z]+)").replace_all("mail bob@host now", "$1 at $2", out, scratch);
+    EXPECT_EQ(out, "mail bob at host now");
+}
+
+TEST_F(RegexTest, ReplaceAgreesWithStdRegex) {
+    const std::string text =
+        "user=alice id=17 ip=10.0.0.1 mail=alice@example.com "
+        "user=bob id=4242 ip=192.168.1.20 mail=bob@test.org end";
+    const std::pair<const char*, const char*> cases[] = {
+        {"(\\w+)=(\\d+)", "$2:$1"},
+        {"\\d+\\.\\d+\\.\\d+\\.\\d+", "<ip>"},
+        {"([a-z]+)@([a-z]+)\\.(com|org)", "$1 at $2 ($3)"},
+        {"\\bid\\b", "ID"},
+        {"(a|al)(ice|lice)", "[$1/$2]"},
+        {"[0-9]*", "#"},
+    };
+
+    for (auto [pattern, replacement] : cases) {
+        auto expected = std::regex_replace(text, std::regex(pattern), replacement);
+        EXPECT_EQ(compile_regex(pattern).replace_all(text, replacement), expected) << pattern;
+    }
+}
+
+TEST_F(RegexTest, FindLongMatch) {
+    // Past the backtracker's budget the groups come from the Pike VM
+    std::string text = "<" + std::string(100000, 'a') + "b>";
+    auto regex = compile_regex("(a+|c)(a*b)");
+    regex_scratch scratch;
+    std::array<size_type, 6> slots{};
+
+    ASSERT_TRUE(regex.find(text, slots, scratch));
+    EXPECT_EQ(slots[0], 1u);
+    EXPECT_EQ(slots[1], 100002u);
+    EXPECT_EQ(slots[3], 100001u);
+    EXPECT_EQ(slots[4], 100001u);
+    EXPECT_EQ(regex.replace_all(text, "$2"), "<b>");
+}
+
+TEST_F(RegexTest, ReplaceWithLoadedPattern) {
+    auto blob = compile_regex("(\\w+)@(\\w+)").serialize();
+    auto loaded = regex_pattern::load(blob);
+    EXPECT_EQ(loaded.group_count(), 2u);
+    EXPECT_EQ(loaded.replace_all("to: ann@corp", "$1 (at) $2"), "to: ann (at) corp");
+}
+
 // =============================================================================
 // Edge Cases
 // =============================================================================
@@ -5,6 +5,13 @@
 
 #include <gtest/gtest.h>
 #include <kmp/kmp.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <forward_list>
+#include <list>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -175,6 +182,263 @@ TEST_F(SearchTest, SearchAllClassicOverlap) {
     EXPECT_EQ(results[1], 2);
 }
 
+TEST_F(SearchTest, SearchAllNonOverlappingMode) {
+    auto results = search_all_vec("aaaaa", "aa", match_mode::non_overlapping);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0], 0);
+    EXPECT_EQ(results[1], 2);
+
+    std::vector<size_type> generated;
+    for (auto pos : search_all("ababa", "aba", match_mode::non_overlapping)) {
+        generated.push_back(pos);
+    }
+    EXPECT_EQ(generated, std::vector<size_type>{0});
+}
+
+TEST_F(SearchTest, SearchAllNonOverlappingLargeText) {
+    // Long enough for the SIMD kernels; compare against std::string_view::find
+    std::string text;
+    for (int i = 0; i < 500; ++i) {
+        text += (i % 3 == 0) ? "aaaaab" : "aabaa";
+    }
+
+    for (std::string_view pattern : {"aa", "aab", "aaaaab", "baa"}) {
+        std::vector<size_type> expected;
+        for (auto pos = std::string_view(text).find(pattern); pos != std::string_view::npos;
+             pos = std::string_view(text).find(pattern, pos + pattern.size())) {
+            expected.push_back(pos);
+        }
+        EXPECT_EQ(search_all_vec(text, pattern, match_mode::non_overlapping), expected)
+            << pattern;
+        EXPECT_EQ(count(text, pattern, match_mode::non_overlapping), expected.size())
+            << pattern;
+    }
+}
+
+// =============================================================================
+// Bounded Search Tests
+// =============================================================================
+
+TEST_F(SearchTest, SearchPosFrom) {
+    EXPECT_EQ(search_pos("abcabcabc", "abc", 1), 3u);
+    EXPECT_EQ(search_pos("abcabcabc", "abc", 3), 3u);
+    EXPECT_EQ(search_pos("abcabcabc", "abc", 7), std::nullopt);
+    EXPECT_EQ(search_pos("abc", "abc", 100), std::nullopt);
+    EXPECT_EQ(search_pos("abc", "", 2), 2u);
+}
+
+TEST_F(SearchTest, SearchPosWindow) {
+    // Only matches lying entirely inside [from, to) count
+    EXPECT_EQ(search_pos("xxabcxxabc", "abc", 0, 5), 2u);
+    EXPECT_EQ(search_pos("xxabcxxabc", "abc", 0, 4), std::nullopt);
+    EXPECT_EQ(search_pos("xxabcxxabc", "abc", 3, 10), 7u);
+    EXPECT_EQ(search_pos("xxabcxxabc", "abc", 5, 3), std::nullopt);
+}
+
+TEST_F(SearchTest, SearchNFirstK) {
+    EXPECT_EQ(search_n("aaaaa", "aa", 2), (std::vector<size_type>{0, 1}));
+    EXPECT_EQ(search_n("aaaaa", "aa", 10), (std::vector<size_type>{0, 1, 2, 3}));
+    EXPECT_EQ(search_n("ab ab ab", "ab", 2, 1), (std::vector<size_type>{3, 6}));
+    EXPECT_TRUE(search_n("abc", "abc", 0).empty());
+    EXPECT_TRUE(search_n("abc", "", 3).empty());
+    EXPECT_TRUE(search_n("abc", "abc", 3, 3).empty());
+}
+
+TEST_F(SearchTest, SearchNPagesMatchSearchAll) {
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        text += (i % 7 == 0) ? "hit " : "miss ";
+    }
+    auto all = search_all_vec(text, "hit");
+
+    std::vector<size_type> paged;
+    size_type from = 0;
+    for (;;) {
+        auto page = search_n(text, "hit", 10, from);
+        if (page.empty()) break;
+        EXPECT_LE(page.size(), 10u);
+        paged.insert(paged.end(), page.begin(), page.end());
+        from = page.back() + 1;
+    }
+    EXPECT_EQ(paged, all);
+}
+
+TEST_F(SearchTest, SearchAllIntoFillsBuffer) {
+    std::array<size_type, 8> buffer{};
+
+    auto result = search_all_into("abcabcabc", "abc", buffer);
+    EXPECT_EQ(result.written, 3u);
+    EXPECT_EQ(result.resume, 9u);
+    EXPECT_EQ(buffer[0], 0u);
+    EXPECT_EQ(buffer[1], 3u);
+    EXPECT_EQ(buffer[2], 6u);
+
+    result = search_all_into("aaaa", "aa", std::span(buffer).first(2));
+    EXPECT_EQ(result.written, 2u);
+    EXPECT_EQ(result.resume, 2u);
+
+    result = search_all_into("aaaa", "aa", std::span(buffer).first(2), 0,
+                             match_mode::non_overlapping);
+    EXPECT_EQ(result.written, 2u);
+    EXPECT_EQ(buffer[1], 2u);
+    EXPECT_EQ(result.resume, 4u);
+}
+
+TEST_F(SearchTest, SearchAllIntoEdgeCases) {
+    std::array<size_type, 4> buffer{};
+    EXPECT_EQ(search_all_into("abc", "x", buffer).written, 0u);
+    EXPECT_EQ(search_all_into("abc", "x", buffer).resume, 3u);
+    EXPECT_EQ(search_all_into("abc", "", buffer).written, 0u);
+    EXPECT_EQ(search_all_into("abc", "abc", std::span<size_type>{}, 1).resume, 1u);
+    EXPECT_EQ(search_all_into("abc", "abc", buffer, 5).written, 0u);
+}
+
+TEST_F(SearchTest, SearchAllIntoResumeMatchesSearchAll) {
+    // Large enough for the SIMD kernels
+    std::string text;
+    for (int i = 0; i < 3000; ++i) {
+        text += (i % 5 == 0) ? "abab " : "ab ";
+    }
+
+    for (auto mode : {match_mode::overlapping, match_mode::non_overlapping}) {
+        auto expected = search_all_vec(text, "ab", mode);
+        std::vector<size_type> collected;
+        std::array<size_type, 7> buffer{};
+        size_type from = 0;
+        for (;;) {
+            auto [written, resume] = search_all_into(text, "ab", buffer, from, mode);
+            collected.insert(collected.end(), buffer.begin(), buffer.begin() + written);
+            if (written < buffer.size()) break;
+            from = resume;
+        }
+        EXPECT_EQ(collected, expected);
+    }
+}
+
+// =============================================================================
+// Segmented Search Tests
+// =============================================================================
+
+TEST_F(SearchTest, SegmentedMatchAcrossBoundaries) {
+    std::vector<std::string_view> segments = {"xxab", "", "c", "abcab", "cxx"};
+    EXPECT_EQ(search_segmented(segments, "abc"), 2u);
+    EXPECT_EQ(search_all_segmented(segments, "abc"), (std::vector<size_type>{2, 5, 8}));
+    EXPECT_EQ(search_segmented(segments, "xyz"), std::nullopt);
+    EXPECT_EQ(search_segmented(segments, ""), 0u);
+    EXPECT_TRUE(search_all_segmented(std::vector<std::string>{}, "a").empty());
+}
+
+TEST_F(SearchTest, SegmentedMatchesContiguousSearch) {
+    // Random splits, including segments long enough for the SIMD kernels
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<> byte('a', 'c');
+    std::string text(5000, ' ');
+    for (auto& c : text) c = static_cast<char>(byte(gen));
+
+    for (std::string_view pattern : {"a", "ab", "abcab", "aaaa", "cabacabacc"}) {
+        for (int max_len : {1, 7, 70, 400}) {
+            std::uniform_int_distribution<> len(0, max_len);
+            std::vector<std::string> segments;
+            for (size_type pos = 0; pos < text.size();) {
+                auto n = std::min<size_type>(static_cast<size_type>(len(gen)), text.size() - pos);
+                segments.emplace_back(text.substr(pos, n));
+                pos += n;
+            }
+
+            auto expected = search_all_vec(text, pattern);
+            EXPECT_EQ(search_all_segmented(segments, pattern), expected)
+                << pattern << " max_len " << max_len;
+            EXPECT_EQ(search_segmented(segments, pattern), search_pos(text, pattern))
+                << pattern << " max_len " << max_len;
+        }
+    }
+}
+
+// =============================================================================
+// Reverse Search Tests
+// =============================================================================
+
+TEST_F(SearchTest, RfindLastOccurrence) {
+    EXPECT_EQ(rfind("abcabcabc", "abc"), 6u);
+    EXPECT_EQ(rfind("aaaa", "aa"), 2u);
+    EXPECT_EQ(rfind("ABABDABACDABABCABAB", "ABABCABAB"), 10u);
+    EXPECT_FALSE(rfind("hello", "xyz").has_value());
+    EXPECT_FALSE(rfind("ab", "abc").has_value());
+    EXPECT_EQ(rfind("hello", ""), 5u);
+}
+
+TEST_F(SearchTest, ForwardListPattern) {
+    std::string text = "xxabcabcabdxx";
+    std::forward_list<char> pattern = {'a', 'b', 'c', 'a', 'b', 'd'};
+
+    auto it = search(text.begin(), text.end(), pattern.begin(), pattern.end());
+    EXPECT_EQ(it - text.begin(), 5);
+}
+
+TEST_F(SearchTest, ForwardPatternStaysLinear) {
+    // Counts pattern iterator steps; indexing a forward-only pattern in
+    // place would take O(n*m) of them
+    struct counting_iterator {
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+
+        std::forward_list<char>::const_iterator it;
+        size_t* steps;
+
+        char operator*() const { return *it; }
+        counting_iterator& operator++() { ++it; ++*steps; return *this; }
+        counting_iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+        bool operator==(const counting_iterator& other) const { return it == other.it; }
+    };
+    static_assert(std::forward_iterator<counting_iterator>);
+
+    const std::string pattern_text(1000, 'a');
+    std::forward_list<char> pattern(pattern_text.begin(), pattern_text.end());
+    const std::string text = std::string(20000, 'a');
+
+    size_t steps = 0;
+    counting_iterator first{pattern.begin(), &steps};
+    counting_iterator last{pattern.end(), &steps};
+
+    auto it = search(text.begin(), text.end(), first, last);
+    EXPECT_EQ(it, text.begin());
+    EXPECT_LE(steps, 10 * pattern_text.size());
+}
+
+TEST_F(SearchTest, SearchLastIterators) {
+    std::string text = "x SESSION START y SESSION START z";
+    std::string pattern = "SESSION START";
+
+    auto it = search_last(text.begin(), text.end(), pattern.begin(), pattern.end());
+    EXPECT_EQ(it - text.begin(), 18);
+    EXPECT_EQ(search_last(text.begin(), text.end(), pattern.begin(), pattern.begin()), text.end());
+}
+
+TEST_F(SearchTest, SearchLastBidirectionalIterators) {
+    std::list<char> text = {'a', 'b', 'a', 'b', 'a', 'c', 'a', 'b'};
+    std::string pattern = "ab";
+
+    auto it = search_last(text.begin(), text.end(), pattern.begin(), pattern.end());
+    EXPECT_EQ(std::distance(text.begin(), it), 6);
+}
+
+TEST_F(SearchTest, RfindLargeTextMatchesStd) {
+    std::string text;
+    for (int i = 0; i < 3000; ++i) {
+        text += "log line " + std::to_string(i) + (i % 700 == 3 ? " SESSION START\n" : "\n");
+    }
+
+    for (std::string_view pattern : {"SESSION START", "line 2999", "line 0", "\n", "absent"}) {
+        auto expected = std::string_view(text).rfind(pattern);
+        auto result = rfind(text, pattern);
+        if (expected == std::string_view::npos) {
+            EXPECT_FALSE(result.has_value()) << pattern;
+        } else {
+            EXPECT_EQ(result, expected) << pattern;
+        }
+    }
+}
+
 // =============================================================================
 // Count Tests
 // =============================================================================
@@ -191,6 +455,146 @@ TEST_F(SearchTest, CountOverlapping) {
     EXPECT_EQ(count("aaaa", "aa"), 3);
 }
 
+TEST_F(SearchTest, CountNonOverlapping) {
+    EXPECT_EQ(count("aaaa", "aa", match_mode::non_overlapping), 2);
+    EXPECT_EQ(count("aaa", "aa", match_mode::non_overlapping), 1);
+}
+
+// =============================================================================
+// Replace All Tests
+// =============================================================================
+
+TEST_F(SearchTest, ReplaceAllBasic) {
+    EXPECT_EQ(replace_all("the cat sat on the mat", "at", "og"), "the cog sog on the mog");
+    EXPECT_EQ(replace_all("hello", "xyz", "abc"), "hello");
+    EXPECT_EQ(replace_all("", "a", "b"), "");
+}
+
+TEST_F(SearchTest, ReplaceAllNonOverlapping) {
+    EXPECT_EQ(replace_all("aaaa", "aa", "b"), "bb");
+    EXPECT_EQ(replace_all("aaaaa", "aa", "b"), "bba");
+    EXPECT_EQ(replace_all("ababa", "aba", "X"), "Xba");
+}
+
+TEST_F(SearchTest, ReplaceAllGrowShrinkAndDelete) {
+    EXPECT_EQ(replace_all("a,b,c", ",", ", "), "a, b, c");
+    EXPECT_EQ(replace_all("a--b--c", "--", "-"), "a-b-c");
+    EXPECT_EQ(replace_all("a--b--c", "--", ""), "abc");
+    EXPECT_EQ(replace_all("xxx", "x", ""), "");
+    EXPECT_EQ(replace_all("abc", "", "z"), "abc");
+}
+
+TEST_F(SearchTest, ReplaceAllLargeText) {
+    std::string text;
+    std::string expected;
+    for (int i = 0; i < 2000; ++i) {
+        text += "key" + std::to_string(i) + "=value;";
+        expected += "key" + std::to_string(i) + ": value;";
+    }
+    EXPECT_EQ(replace_all(text, "=", ": "), expected);
+}
+
+// =============================================================================
+// Small Alphabet (Shift-Or) Tests
+// =============================================================================
+
+TEST_F(SearchTest, DnaMatchesNaive) {
+    // Long enough for the Shift-Or engine; matches planted around the
+    // quarter boundaries of its four lanes
+    std::mt19937 gen(23);
+    std::uniform_int_distribution<> base(0, 3);
+
+    for (int trial = 0; trial < 40; ++trial) {
+        std::string text(static_cast<size_t>(config::shift_or_min_text + trial * 997), ' ');
+        for (auto& c : text) c = "ACGT"[base(gen)];
+        std::string pattern(static_cast<size_t>(2 + trial * 3 % 66), ' ');
+        for (auto& c : pattern) c = "ACGT"[base(gen)];
+
+        const size_t n = text.size();
+        for (size_t q = 1; q < 4; ++q) {
+            const size_t at = std::min(n - pattern.size(), q * (n / 4) - pattern.size() / 2);
+            text.replace(at, pattern.size(), pattern);
+        }
+
+        std::vector<size_type> expected;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            expected.push_back(pos);
+        }
+
+        ASSERT_FALSE(expected.empty());
+        EXPECT_EQ(search_pos(text, pattern), expected.front()) << "trial " << trial;
+        EXPECT_EQ(search_pos(text, literal_pattern(pattern)), expected.front()) << "trial " << trial;
+        EXPECT_EQ(search_all_vec(text, pattern), expected) << "trial " << trial;
+        EXPECT_EQ(search_n(text, pattern, 2),
+                  std::vector<size_type>(expected.begin(),
+                                         expected.begin() + static_cast<std::ptrdiff_t>(std::min<size_t>(2, expected.size()))))
+            << "trial " << trial;
+    }
+}
+
+TEST_F(SearchTest, DnaNonOverlapping) {
+    std::string text(config::shift_or_min_text, 'A');
+    EXPECT_EQ(count(text, "AA"), text.size() - 1);
+    EXPECT_EQ(count(text, "AA", match_mode::non_overlapping), text.size() / 2);
+    // 64 bytes is the longest Shift-Or pattern; 65 takes the KMP kernels
+    text.back() = 'C';
+    EXPECT_EQ(search_pos(text, std::string(63, 'A') + "C"), text.size() - 64);
+    EXPECT_EQ(search_pos(text, std::string(64, 'A') + "C"), text.size() - 65);
+}
+
+// =============================================================================
+// Element Sequence Tests
+// =============================================================================
+
+TEST_F(SearchTest, ByteSequence) {
+    std::vector<std::byte> dump(4096, std::byte{0xFF});
+    const std::vector<std::byte> magic = {std::byte{0x7F}, std::byte{'E'},
+                                          std::byte{'L'}, std::byte{'F'}};
+    std::copy(magic.begin(), magic.end(), dump.begin() + 3000);
+
+    EXPECT_EQ(search_pos(dump, magic), 3000);
+    EXPECT_EQ(search_all_vec(dump, magic), std::vector<size_type>{3000});
+    EXPECT_EQ(count(dump, std::vector<std::byte>{std::byte{0xFF}, std::byte{0xFF}}), 4090);
+}
+
+TEST_F(SearchTest, Utf16Sequence) {
+    std::u16string text;
+    for (int i = 0; i < 200; ++i) {
+        text += u"\u4f60\u597d, ";
+    }
+    text += u"\u4e16\u754c";
+
+    EXPECT_EQ(search_pos(text, std::u16string_view(u"\u4e16\u754c")), 800);
+    EXPECT_EQ(count(text, std::u16string_view(u"\u597d,")), 200);
+    // Same low bytes, different code unit: element-wise, not byte-wise
+    EXPECT_FALSE(search_pos(text, std::u16string_view(u"\u0060")).has_value());
+}
+
+TEST_F(SearchTest, ElementSequencesMatchNaive) {
+    std::mt19937 gen(11);
+
+    for (int trial = 0; trial < 100; ++trial) {
+        std::vector<std::uint32_t> text(static_cast<size_t>(1 + trial * 37));
+        for (auto& id : text) id = 1000 + gen() % 3;
+        std::vector<std::uint32_t> pattern(static_cast<size_t>(1 + trial % 9));
+        for (auto& id : pattern) id = 1000 + gen() % 3;
+
+        std::vector<size_type> expected;
+        for (size_t i = 0; i + pattern.size() <= text.size(); ++i) {
+            if (std::equal(pattern.begin(), pattern.end(), text.begin() + static_cast<std::ptrdiff_t>(i))) {
+                expected.push_back(i);
+            }
+        }
+
+        EXPECT_EQ(search_all_vec(text, pattern), expected) << "trial " << trial;
+
+        // 64-bit elements take the scalar path
+        std::vector<std::uint64_t> wide_text(text.begin(), text.end());
+        std::vector<std::uint64_t> wide_pattern(pattern.begin(), pattern.end());
+        EXPECT_EQ(count(wide_text, wide_pattern), expected.size()) << "trial " << trial;
+    }
+}
+
 // =============================================================================
 // Contains Tests
 // =============================================================================
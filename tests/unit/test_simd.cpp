@@ -6,8 +6,10 @@
 #include <gtest/gtest.h>
 #include <kmp/kmp.hpp>
 #include <kmp/detail/simd/dispatch.hpp>
+#include <algorithm>
 #include <string>
 #include <random>
+#include <vector>
 
 using namespace kmp;
 using namespace kmp::detail::simd;
@@ -259,3 +261,102 @@ TEST_F(SIMDTest, SIMDMatchesScalarResults) {
         }
     }
 }
+
+// =============================================================================
+// Reverse Kernel Tests
+// =============================================================================
+
+TEST_F(SIMDTest, ReverseKernelsMatchStdRfind) {
+    // Small alphabet so partial matches and failure shifts are frequent
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> dis('a', 'c');
+
+    for (int trial = 0; trial < 200; ++trial) {
+        std::string text(static_cast<size_t>(1 + trial * 3), ' ');
+        for (auto& c : text) c = static_cast<char>(dis(gen));
+        std::string pattern(static_cast<size_t>(1 + trial % 40), ' ');
+        for (auto& c : pattern) c = static_cast<char>(dis(gen));
+
+        const auto expected = std::string_view(text).rfind(pattern);
+        auto failure = kmp::detail::compute_reverse_failure(pattern.begin(), pattern.end());
+
+        auto check = [&](const char* result, const char* isa) {
+            if (expected == std::string_view::npos) {
+                EXPECT_EQ(result, nullptr) << isa << " trial " << trial;
+            } else {
+                EXPECT_EQ(result, text.data() + expected) << isa << " trial " << trial;
+            }
+        };
+
+        #if KMP_HAS_SSE42
+        if (has_sse42()) {
+            check(kmp_search_last_sse42(text.data(), text.size(), pattern.data(),
+                                        pattern.size(), failure), "sse42");
+        }
+        #endif
+        #if KMP_HAS_AVX2
+        if (has_avx2()) {
+            check(kmp_search_last_avx2(text.data(), text.size(), pattern.data(),
+                                       pattern.size(), failure), "avx2");
+        }
+        #endif
+        #if KMP_HAS_AVX512
+        if (has_avx512()) {
+            check(kmp_search_last_avx512(text.data(), text.size(), pattern.data(),
+                                         pattern.size(), failure), "avx512");
+        }
+        #endif
+    }
+}
+
+// =============================================================================
+// Element Width Kernel Tests
+// =============================================================================
+
+TEST_F(SIMDTest, WideKernelsMatchNaive) {
+    std::mt19937 gen(3);
+
+    for (int trial = 0; trial < 100; ++trial) {
+        // Values differing only in the high byte must not compare equal
+        std::vector<char16_t> text(static_cast<size_t>(1 + trial * 29));
+        for (auto& c : text) c = static_cast<char16_t>(0x0061 + (gen() % 2) * 0x0100 + gen() % 2);
+        std::vector<char16_t> pattern(static_cast<size_t>(1 + trial % 40));
+        for (auto& c : pattern) c = static_cast<char16_t>(0x0061 + (gen() % 2) * 0x0100 + gen() % 2);
+        std::vector<uint32_t> text32(text.begin(), text.end());
+        std::vector<uint32_t> pattern32(pattern.begin(), pattern.end());
+
+        std::vector<size_type> expected;
+        for (size_t i = 0; i + pattern.size() <= text.size(); ++i) {
+            if (std::equal(pattern.begin(), pattern.end(), text.begin() + static_cast<std::ptrdiff_t>(i))) {
+                expected.push_back(i);
+            }
+        }
+        auto failure = kmp::detail::compute_failure(pattern.begin(), pattern.end());
+
+        auto check = [&](auto kernel, const auto& t, const auto& p, const char* isa) {
+            std::vector<size_type> found;
+            kernel(t.data(), t.size(), p.data(), p.size(), failure, std::back_inserter(found));
+            EXPECT_EQ(found, expected) << isa << " width " << sizeof(t[0]) << " trial " << trial;
+        };
+        auto both = [&](auto kernel, const char* isa) {
+            check(kernel, text, pattern, isa);
+            check(kernel, text32, pattern32, isa);
+        };
+
+        #if KMP_HAS_SSE42
+        if (has_sse42()) {
+            both([](auto... args) { return kmp_search_all_sse42(args...); }, "sse42");
+        }
+        #endif
+        #if KMP_HAS_AVX2
+        if (has_avx2()) {
+            both([](auto... args) { return kmp_search_all_avx2(args...); }, "avx2");
+        }
+        #endif
+        #if KMP_HAS_AVX512
+        if (has_avx512()) {
+            both([](auto... args) { return kmp_search_all_avx512(args...); }, "avx512");
+        }
+        #endif
+    }
+}
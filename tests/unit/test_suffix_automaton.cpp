@@ -0,0 +1,174 @@
+/**
+ * @file test_suffix_automaton.cpp
+ * @brief Unit tests for the suffix automaton
+ */
+
+#include <gtest/gtest.h>
+#include <kmp/kmp.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace kmp;
+
+class SuffixAutomatonTest : public ::testing::Test {
+protected:
+    static std::string random_text(std::mt19937& rng, size_type n, std::string_view alphabet) {
+        std::string text(n, ' ');
+        for (auto& c : text) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        return text;
+    }
+
+    // Overlapping occurrences by brute force
+    static size_type naive_count(std::string_view text, std::string_view pattern) {
+        size_type n = 0;
+        for (size_type pos = text.find(pattern); pos != std::string_view::npos;
+             pos = text.find(pattern, pos + 1)) {
+            ++n;
+        }
+        return n;
+    }
+
+    static size_type naive_lcs_length(std::string_view a, std::string_view b) {
+        size_type best = 0;
+        std::vector<size_type> prev(b.size() + 1, 0);
+        std::vector<size_type> cur(b.size() + 1, 0);
+        for (size_type i = 1; i <= a.size(); ++i) {
+            for (size_type j = 1; j <= b.size(); ++j) {
+                cur[j] = a[i - 1] == b[j - 1] ? prev[j - 1] + 1 : 0;
+                best = std::max(best, cur[j]);
+            }
+            std::swap(prev, cur);
+        }
+        return best;
+    }
+};
+
+// =============================================================================
+// Basic Queries
+// =============================================================================
+
+TEST_F(SuffixAutomatonTest, Banana) {
+    const suffix_automaton automaton("banana");
+
+    EXPECT_EQ(automaton.size(), 6);
+    EXPECT_TRUE(automaton.contains("nan"));
+    EXPECT_FALSE(automaton.contains("nab"));
+    EXPECT_EQ(automaton.count("ana"), 2);
+    EXPECT_EQ(automaton.count("a"), 3);
+    EXPECT_EQ(automaton.count("banana"), 1);
+    EXPECT_EQ(automaton.count("bananas"), 0);
+    EXPECT_EQ(automaton.search_pos("ana"), 1);
+    EXPECT_EQ(automaton.search_pos("na"), 2);
+    EXPECT_FALSE(automaton.search_pos("x").has_value());
+}
+
+TEST_F(SuffixAutomatonTest, EmptyInputs) {
+    const suffix_automaton empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.contains("a"));
+    EXPECT_EQ(empty.count("a"), 0);
+    EXPECT_EQ(empty.longest_common_substring("abc").length, 0);
+
+    const suffix_automaton automaton("abc");
+    EXPECT_FALSE(automaton.contains(""));
+    EXPECT_EQ(automaton.count(""), 0);
+    EXPECT_FALSE(automaton.search_pos("").has_value());
+    EXPECT_EQ(automaton.longest_prefix(""), 0);
+}
+
+TEST_F(SuffixAutomatonTest, LongestPrefix) {
+    const suffix_automaton automaton("the quick brown fox");
+
+    EXPECT_EQ(automaton.longest_prefix("quick red"), 6);
+    EXPECT_EQ(automaton.longest_prefix("fox"), 3);
+    EXPECT_EQ(automaton.longest_prefix("zebra"), 0);
+}
+
+TEST_F(SuffixAutomatonTest, LongestCommonSubstring) {
+    const suffix_automaton automaton("xxabcdefyy");
+
+    const auto common = automaton.longest_common_substring("zzcdefabc");
+    EXPECT_EQ(common.length, 4);
+    EXPECT_EQ(common.position, 4);
+    EXPECT_EQ(common.other_position, 2);
+
+    EXPECT_EQ(automaton.longest_common_substring("qqq").length, 0);
+}
+
+// =============================================================================
+// Incremental Construction
+// =============================================================================
+
+TEST_F(SuffixAutomatonTest, AppendUpdatesQueries) {
+    suffix_automaton automaton;
+    automaton.append("abab");
+    EXPECT_EQ(automaton.count("ab"), 2);
+    EXPECT_FALSE(automaton.contains("bc"));
+
+    automaton.append('c');
+    automaton.append("ab");
+    EXPECT_EQ(automaton.count("ab"), 3);
+    EXPECT_TRUE(automaton.contains("bca"));
+    EXPECT_EQ(automaton.search_pos("bca"), 3);
+
+    // A copy keeps its own counts once either side grows
+    const suffix_automaton snapshot = automaton;
+    automaton.append("ab");
+    EXPECT_EQ(automaton.count("ab"), 4);
+    EXPECT_EQ(snapshot.count("ab"), 3);
+}
+
+TEST_F(SuffixAutomatonTest, DenseStates) {
+    // The root and the state of "x" see every byte value
+    std::string text;
+    for (int b = 0; b < 256; ++b) {
+        text += 'x';
+        text += static_cast<char>(b);
+    }
+    const suffix_automaton automaton(text);
+
+    for (int b = 0; b < 256; ++b) {
+        const char pair[2] = {'x', static_cast<char>(b)};
+        EXPECT_EQ(automaton.count(std::string_view(pair, 2)), b == 'x' ? 2 : 1) << b;
+    }
+    EXPECT_EQ(automaton.count("x"), 257);
+    EXPECT_LE(automaton.state_count(), 2 * text.size());
+}
+
+TEST_F(SuffixAutomatonTest, MatchesNaiveRandom) {
+    std::mt19937 rng(31);
+    for (std::string_view alphabet : {"ab", "ACGT", "abcdefghijklmnopqrstuvwxyz0123456789"}) {
+        suffix_automaton automaton;
+        std::string text;
+        for (int round = 0; round < 8; ++round) {
+            const auto chunk = random_text(rng, 1 + rng() % 300, alphabet);
+            automaton.append(chunk);
+            text += chunk;
+
+            for (int q = 0; q < 40; ++q) {
+                const size_type m = 1 + rng() % 6;
+                const auto pattern = random_text(rng, m, alphabet);
+                EXPECT_EQ(automaton.count(pattern), naive_count(text, pattern)) << pattern;
+
+                const auto expected = text.find(pattern);
+                const auto pos = automaton.search_pos(pattern);
+                if (expected == std::string::npos) {
+                    EXPECT_FALSE(pos.has_value()) << pattern;
+                } else {
+                    EXPECT_EQ(pos, expected) << pattern;
+                }
+            }
+
+            const auto other = random_text(rng, 50, alphabet);
+            const auto common = automaton.longest_common_substring(other);
+            EXPECT_EQ(common.length, naive_lcs_length(text, other));
+            EXPECT_EQ(std::string_view(text).substr(common.position, common.length),
+                      std::string_view(other).substr(common.other_position, common.length));
+        }
+        EXPECT_LE(automaton.state_count(), 2 * text.size());
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file test_text_index.cpp
+ * @brief Unit tests for the suffix-array text index
+ */
+
+#include <gtest/gtest.h>
+#include <kmp/kmp.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace kmp;
+
+class TextIndexTest : public ::testing::Test {
+protected:
+    static std::string random_text(std::mt19937& rng, size_type n, std::string_view alphabet) {
+        std::string text(n, ' ');
+        for (auto& c : text) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        return text;
+    }
+
+    static std::vector<std::uint32_t> naive_suffix_array(std::string_view text) {
+        std::vector<std::uint32_t> sa(text.size());
+        std::iota(sa.begin(), sa.end(), 0u);
+        std::sort(sa.begin(), sa.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return text.substr(a) < text.substr(b);
+        });
+        return sa;
+    }
+};
+
+// =============================================================================
+// Construction Tests
+// =============================================================================
+
+TEST_F(TextIndexTest, Banana) {
+    text_index index("banana");
+
+    std::vector<std::uint32_t> sa(index.suffix_array().begin(), index.suffix_array().end());
+    std::vector<std::uint32_t> lcp(index.lcp().begin(), index.lcp().end());
+    EXPECT_EQ(sa, (std::vector<std::uint32_t>{5, 3, 1, 0, 4, 2}));
+    EXPECT_EQ(lcp, (std::vector<std::uint32_t>{0, 1, 3, 0, 0, 2}));
+    EXPECT_EQ(index.longest_repeat(), "ana");
+}
+
+TEST_F(TextIndexTest, SuffixArrayMatchesNaive) {
+    // Small alphabets and runs exercise the SA-IS recursion
+    std::mt19937 rng(17);
+    for (int trial = 0; trial < 40; ++trial) {
+        const std::string_view alphabet = trial % 3 == 0 ? "a" : trial % 3 == 1 ? "ab" : "ACGT";
+        std::string text = random_text(rng, rng() % 600, alphabet);
+        if (trial % 5 == 0) {
+            text += "\xff\x80";
+        }
+        text_index index(text);
+
+        const auto expected = naive_suffix_array(text);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(),
+                               index.suffix_array().begin(), index.suffix_array().end()))
+            << "n=" << text.size();
+
+        for (size_type i = 1; i < text.size(); ++i) {
+            const std::string_view a = std::string_view(text).substr(expected[i - 1]);
+            const std::string_view b = std::string_view(text).substr(expected[i]);
+            size_type l = 0;
+            while (l < a.size() && l < b.size() && a[l] == b[l]) {
+                ++l;
+            }
+            ASSERT_EQ(index.lcp()[i], l);
+        }
+    }
+}
+
+TEST_F(TextIndexTest, ParallelLcpMatchesSerial) {
+    std::mt19937 rng(2);
+    std::string text = random_text(rng, 3 * 1024 * 1024, "ACGT");
+    text.replace(1024 * 1024 - 50, 5000, std::string(5000, 'A'));
+
+    text_index serial(text, 1);
+    text_index parallel(text, 4);
+    EXPECT_TRUE(std::equal(serial.lcp().begin(), serial.lcp().end(),
+                           parallel.lcp().begin(), parallel.lcp().end()));
+}
+
+TEST_F(TextIndexTest, EmptyText) {
+    text_index index("");
+
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.count("a"), 0);
+    EXPECT_FALSE(index.contains("a"));
+    EXPECT_EQ(index.longest_repeat(), "");
+}
+
+// =============================================================================
+// Query Tests
+// =============================================================================
+
+TEST_F(TextIndexTest, QueriesMatchSearch) {
+    std::mt19937 rng(23);
+    const std::string text = random_text(rng, 20000, "abc");
+    text_index index(text);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        const size_type m = 1 + rng() % 8;
+        std::string pattern = random_text(rng, m, "abcd");
+
+        EXPECT_EQ(index.search_all_vec(pattern), kmp::search_all_vec(text, pattern)) << pattern;
+        EXPECT_EQ(index.count(pattern), kmp::count(text, pattern)) << pattern;
+        EXPECT_EQ(index.contains(pattern), kmp::contains(text, pattern)) << pattern;
+        EXPECT_EQ(index.search_pos(pattern), kmp::search_pos(text, pattern)) << pattern;
+    }
+}
+
+TEST_F(TextIndexTest, EdgePatterns) {
+    text_index index("abcabc");
+
+    EXPECT_EQ(index.count(""), 0);
+    EXPECT_EQ(index.count("abcabcd"), 0);
+    EXPECT_EQ(index.count("abcabc"), 1);
+    EXPECT_EQ(index.count("c"), 2);
+    EXPECT_FALSE(index.contains("cab_"));
+
+    std::vector<size_type> generated;
+    for (auto pos : index.search_all("bc")) {
+        generated.push_back(pos);
+    }
+    EXPECT_EQ(generated, (std::vector<size_type>{1, 4}));
+}
+
+// =============================================================================
+// Persistence Tests
+// =============================================================================
+
+TEST_F(TextIndexTest, SerializeAndView) {
+    const std::string text = "the quick brown fox jumps over the lazy dog";
+    const auto blob = text_index(text).serialize();
+
+    std::vector<std::uint64_t> aligned((blob.size() + 7) / 8);
+    std::memcpy(aligned.data(), blob.data(), blob.size());
+    const auto bytes = std::as_bytes(std::span(aligned)).first(blob.size());
+    text_index loaded = text_index::view(bytes);
+
+    EXPECT_TRUE(loaded.is_view());
+    EXPECT_EQ(loaded.text(), text);
+    EXPECT_EQ(loaded.count("the"), 2);
+    EXPECT_EQ(loaded.search_pos("lazy"), 35);
+
+    text_index copy = loaded;
+    EXPECT_TRUE(copy.is_view());
+    EXPECT_EQ(copy.count("o"), 4);
+}
+
+TEST_F(TextIndexTest, ViewRejectsBadBlobs) {
+    const auto blob = text_index("hello").serialize();
+    std::vector<std::uint64_t> aligned((blob.size() + 7) / 8);
+    std::memcpy(aligned.data(), blob.data(), blob.size());
+    auto bytes = std::as_writable_bytes(std::span(aligned));
+
+    EXPECT_THROW((void)text_index::view(std::span<const std::byte>(bytes).first(16)), std::runtime_error);
+    EXPECT_THROW((void)text_index::view(std::span<const std::byte>(bytes).first(blob.size() - 8)),
+                 std::runtime_error);
+
+    bytes[0] = std::byte{'X'};
+    EXPECT_THROW((void)text_index::view(bytes), std::runtime_error);
+}
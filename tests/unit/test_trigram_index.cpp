@@ -0,0 +1,206 @@
+/**
+ * @file test_trigram_index.cpp
+ * @brief Unit tests for the trigram index and query planner
+ */
+
+#include <gtest/gtest.h>
+#include <kmp/kmp.hpp>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace kmp;
+
+class TrigramIndexTest : public ::testing::Test {
+protected:
+    static std::uint32_t key(std::string_view trigram) {
+        return detail::trigram_key(trigram.data());
+    }
+
+    static bool has_clause(const trigram_query& query, std::vector<std::string_view> trigrams) {
+        std::vector<std::uint32_t> clause;
+        for (auto t : trigrams) {
+            clause.push_back(key(t));
+        }
+        std::sort(clause.begin(), clause.end());
+        return std::find(query.clauses.begin(), query.clauses.end(), clause) != query.clauses.end();
+    }
+
+    static std::vector<std::string> random_documents(std::mt19937& rng, size_type count) {
+        static constexpr std::string_view words[] = {
+            "error", "errno", "warning", "info", "disk", "full", "color", "colour",
+            "foo", "bar", "baz", "foobaz", "timeout", "42", "1234", "x", "ab",
+        };
+        std::vector<std::string> documents(count);
+        for (auto& doc : documents) {
+            const size_type n = rng() % 12;
+            for (size_type i = 0; i < n; ++i) {
+                doc += words[rng() % std::size(words)];
+                doc += rng() % 4 ? ' ' : ':';
+            }
+        }
+        return documents;
+    }
+};
+
+// =============================================================================
+// Query Planning
+// =============================================================================
+
+TEST_F(TrigramIndexTest, PlanLiteral) {
+    const auto query = trigram_query::plan("hello");
+
+    EXPECT_EQ(query.clauses.size(), 3);
+    EXPECT_TRUE(has_clause(query, {"hel"}));
+    EXPECT_TRUE(has_clause(query, {"ell"}));
+    EXPECT_TRUE(has_clause(query, {"llo"}));
+
+    EXPECT_TRUE(trigram_query::plan("ab").matches_all());
+    EXPECT_EQ(trigram_query::plan(literal_pattern("aaaa")).clauses.size(), 1);
+}
+
+TEST_F(TrigramIndexTest, PlanRegexAlternation) {
+    const auto query = trigram_query::plan(regex_pattern("(foo|bar)baz"));
+
+    EXPECT_TRUE(has_clause(query, {"bar", "foo"}));
+    EXPECT_TRUE(has_clause(query, {"arb", "oob"}));
+    EXPECT_TRUE(has_clause(query, {"baz"}));
+}
+
+TEST_F(TrigramIndexTest, PlanRegexFactors) {
+    const auto gap = trigram_query::plan(regex_pattern("hello.*world"));
+    EXPECT_TRUE(has_clause(gap, {"hel"}));
+    EXPECT_TRUE(has_clause(gap, {"llo"}));
+    EXPECT_TRUE(has_clause(gap, {"wor"}));
+    EXPECT_TRUE(has_clause(gap, {"rld"}));
+    EXPECT_FALSE(has_clause(gap, {"low"}));
+
+    const auto optional = trigram_query::plan(regex_pattern("colou?r"));
+    EXPECT_TRUE(has_clause(optional, {"col"}));
+    EXPECT_TRUE(has_clause(optional, {"olo"}));
+
+    const auto repeat = trigram_query::plan(regex_pattern("(abc)+d"));
+    EXPECT_TRUE(has_clause(repeat, {"abc"}));
+    EXPECT_TRUE(has_clause(repeat, {"bcd"}));
+
+    const auto small_class = trigram_query::plan(regex_pattern("[Hh]ello"));
+    EXPECT_TRUE(has_clause(small_class, {"Hel", "hel"}));
+    EXPECT_TRUE(has_clause(small_class, {"llo"}));
+}
+
+TEST_F(TrigramIndexTest, PlanRegexWithoutTrigrams) {
+    EXPECT_TRUE(trigram_query::plan(regex_pattern("a.*b")).matches_all());
+    EXPECT_TRUE(trigram_query::plan(regex_pattern("\\w+")).matches_all());
+    EXPECT_TRUE(trigram_query::plan(regex_pattern("(abc)*")).matches_all());
+    EXPECT_TRUE(trigram_query::plan(regex_pattern("abc|x")).matches_all());
+}
+
+// =============================================================================
+// Intersection
+// =============================================================================
+
+TEST_F(TrigramIndexTest, IntersectMatchesStd) {
+    // Similar sizes use the SIMD kernels, skewed sizes gallop
+    std::mt19937 rng(17);
+    for (int trial = 0; trial < 200; ++trial) {
+        auto random_set = [&](size_type n, std::uint32_t range) {
+            std::vector<std::uint32_t> v(n);
+            for (auto& x : v) {
+                x = rng() % range;
+            }
+            std::sort(v.begin(), v.end());
+            v.erase(std::unique(v.begin(), v.end()), v.end());
+            return v;
+        };
+        const auto a = random_set(rng() % 300, 1000);
+        const auto b = random_set(trial % 4 == 0 ? rng() % 8 : rng() % 300, 1000);
+
+        std::vector<std::uint32_t> expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+        std::vector<std::uint32_t> out(std::min(a.size(), b.size()));
+        out.resize(detail::intersect_sorted(a.data(), a.size(), b.data(), b.size(), out.data()));
+        EXPECT_EQ(out, expected);
+    }
+}
+
+TEST_F(TrigramIndexTest, PostingListRoundTrip) {
+    detail::posting_list list;
+    const std::vector<std::uint32_t> ids = {0, 1, 2, 130, 20000, 20001, 3000000000u};
+    for (auto id : ids) {
+        list.append(id);
+    }
+
+    std::vector<std::uint32_t> decoded;
+    list.decode(decoded);
+    EXPECT_EQ(decoded, ids);
+}
+
+// =============================================================================
+// Search
+// =============================================================================
+
+TEST_F(TrigramIndexTest, SearchLiteral) {
+    const std::vector<std::string> documents = {"disk full", "disk ok", "", "full disk", "ful"};
+    const trigram_index index(documents);
+
+    EXPECT_EQ(index.size(), 5);
+    EXPECT_EQ(index.document(3), "full disk");
+    EXPECT_EQ(index.search("disk"), (std::vector<size_type>{0, 1, 3}));
+    EXPECT_EQ(index.search(literal_pattern("full")), (std::vector<size_type>{0, 3}));
+    EXPECT_EQ(index.search("ful"), (std::vector<size_type>{0, 3, 4}));
+    EXPECT_EQ(index.search("k f"), (std::vector<size_type>{0}));
+    EXPECT_EQ(index.search("k"), (std::vector<size_type>{0, 1, 3}));
+    EXPECT_TRUE(index.search("").empty());
+    EXPECT_TRUE(index.search("missing").empty());
+}
+
+TEST_F(TrigramIndexTest, SearchMatchesScan) {
+    std::mt19937 rng(23);
+    const auto documents = random_documents(rng, 3000);
+    trigram_index index;
+    for (const auto& doc : documents) {
+        index.add(doc);
+    }
+
+    for (std::string_view literal : {"error", "foobaz", "disk full", "x", "42:", "colour",
+                                     "r b", "timeout timeout", "nothing"}) {
+        std::vector<size_type> expected;
+        for (size_type id = 0; id < documents.size(); ++id) {
+            if (contains(documents[id], literal)) {
+                expected.push_back(id);
+            }
+        }
+        EXPECT_EQ(index.search(literal), expected) << literal;
+    }
+
+    for (std::string_view source : {"err(or|no)", "colou?r", "(foo|bar)baz", "disk.*full",
+                                    "[0-9]+:", "^info", "\\bbar\\b", "t(ime)+out", "x|y",
+                                    "[Ww]arning: ", "ab(c|d)?", "(errno|warning) 42"}) {
+        const regex_pattern pattern(source);
+        std::vector<size_type> expected;
+        for (size_type id = 0; id < documents.size(); ++id) {
+            if (pattern.search(documents[id])) {
+                expected.push_back(id);
+            }
+        }
+        EXPECT_EQ(index.search(pattern), expected) << source;
+
+        const auto candidates = index.candidates(trigram_query::plan(pattern));
+        EXPECT_TRUE(std::includes(candidates.begin(), candidates.end(),
+                                  expected.begin(), expected.end())) << source;
+    }
+}
+
+TEST_F(TrigramIndexTest, CandidatesNarrowTheCollection) {
+    std::vector<std::string> documents(1000, "routine status message");
+    documents[10] = "rare needle here";
+    documents[700] = "another needle";
+    const trigram_index index(documents);
+
+    EXPECT_EQ(index.candidates(trigram_query::plan("needle")), (std::vector<size_type>{10, 700}));
+    EXPECT_EQ(index.candidates(trigram_query::plan("ne")).size(), 1000);
+}